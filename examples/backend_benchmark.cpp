@@ -0,0 +1,94 @@
+/**
+ * @file backend_benchmark.cpp
+ * @brief Compare untuned TVM, MetaSchedule-tuned TVM and DNNL offload
+ *
+ * Compiles the same model three ways and prints compile time, latency,
+ * library size and memory per variant. The DNNL variant requires a TVM
+ * build with USE_DNNL=ON and is reported as skipped otherwise.
+ *
+ * Usage: backend_benchmark [--simple] [--trials N] [--runs N] [--workers N] [op groups...]
+ */
+
+#include "ffi/tvm_ffi.h"
+#include "python_hook.h"
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace tvm_sdk::ffi;
+using namespace tvm_sdk;
+
+int main(int argc, char** argv) {
+    bool use_simple = false;
+    int num_trials = 200;
+    int num_runs = 20;
+    int max_workers = 0;
+    std::vector<std::string> offload_ops;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--simple") {
+            use_simple = true;
+        } else if (arg == "--trials" && i + 1 < argc) {
+            num_trials = std::atoi(argv[++i]);
+        } else if (arg == "--runs" && i + 1 < argc) {
+            num_runs = std::atoi(argv[++i]);
+        } else if (arg == "--workers" && i + 1 < argc) {
+            max_workers = std::atoi(argv[++i]);
+        } else {
+            offload_ops.push_back(arg);
+        }
+    }
+
+    try {
+        PythonHook::initialize();
+
+        // "" = pretrained ResNet18
+        std::string relax_ir;
+        if (use_simple) {
+            py::object result = PythonHook::call_function("tvm_ext", "create_simple_relax_ir");
+            relax_ir = PythonHook::to_cpp<std::string>(result);
+        }
+
+        std::cout << "Benchmarking " << (use_simple ? "simple matmul" : "ResNet18")
+                  << " (" << num_trials << " tuning trials, " << num_runs << " runs per variant)...\n";
+        BackendBenchmark benchmark = TVMFFI::benchmark_backends(
+            relax_ir, "llvm", num_trials, max_workers, "backend_benchmark", num_runs, offload_ops);
+        if (benchmark.status != "success") {
+            std::cerr << "Benchmark failed: " << benchmark.error << "\n";
+            return 1;
+        }
+
+        std::cout << "Target: " << benchmark.target << "\n\n";
+        std::cout << std::setw(10) << std::left << "variant"
+                  << std::setw(14) << std::right << "compile s"
+                  << std::setw(12) << "mean ms"
+                  << std::setw(12) << "p50 ms"
+                  << std::setw(12) << "lib KB"
+                  << std::setw(12) << "rt RSS KB"
+                  << std::setw(14) << "peak RSS MB"
+                  << std::setw(11) << "offloaded" << "\n";
+        std::cout << std::fixed << std::setprecision(3);
+        for (const auto& variant : benchmark.results) {
+            std::cout << std::setw(10) << std::left << variant.name;
+            if (variant.status != "success") {
+                std::cout << "  " << variant.status << ": " << variant.error << "\n";
+                continue;
+            }
+            std::cout << std::setw(14) << std::right << variant.compile_ms / 1000.0
+                      << std::setw(12) << variant.mean_ms
+                      << std::setw(12) << variant.p50_ms
+                      << std::setw(12) << variant.library_bytes / 1024
+                      << std::setw(12) << variant.runtime_rss_kb
+                      << std::setw(14) << variant.peak_rss_kb / 1024
+                      << std::setw(11) << variant.num_offloaded << "\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file resnet_pipeline.cpp
+ * @brief Pipelined ResNet18 classification: decode, infer and top-k overlap
+ *
+ * Preprocessing (image decode and resize), inference on a compiled library
+ * and native softmax/top-k run as separate pipeline stages connected by
+ * bounded queues, so decode of the next images overlaps with inference of
+ * the current one. Prints top-1 results, throughput and per-stage utilization.
+ *
+ * Usage: resnet_pipeline <compiled_lib.so> <image> [image...] [--repeat N] [--decoders N]
+ */
+
+#include "pipeline.h"
+#include "postprocess.h"
+#include "python_hook.h"
+#include <pybind11/stl.h>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace tvm_sdk;
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0]
+                  << " <compiled_lib.so> <image> [image...] [--repeat N] [--decoders N]\n";
+        return 1;
+    }
+
+    std::string lib_path = argv[1];
+    std::vector<std::string> images;
+    int repeat = 1;
+    int num_decoders = 2;
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::atoi(argv[++i]);
+        } else if (arg == "--decoders" && i + 1 < argc) {
+            num_decoders = std::atoi(argv[++i]);
+        } else {
+            images.push_back(arg);
+        }
+    }
+
+    try {
+        PythonHook::initialize();
+
+        const std::string stages_module = "tvm_ext.pipeline_stages";
+        Pipeline pipeline(8);
+        pipeline.add_python_stage("preprocess", stages_module, "create_preprocess_stage", num_decoders)
+                .add_python_stage("infer", stages_module, "create_infer_stage", 1, {lib_path})
+                .add_stage("postprocess", [](std::any item) -> std::any {
+                    // Read the logits in place; only the top-k leave the stage
+                    py::gil_scoped_acquire gil;
+                    py::buffer logits = py::reinterpret_borrow<py::buffer>(*std::any_cast<PyItem>(item));
+                    py::buffer_info info = logits.request();
+                    if (info.format != py::format_descriptor<float>::format()) {
+                        throw std::runtime_error("Expected float32 logits");
+                    }
+                    return Postprocess::classify(static_cast<const float*>(info.ptr), 1,
+                                                 static_cast<size_t>(info.size), 5)[0];
+                });
+
+        std::vector<std::pair<int64_t, std::vector<Prediction>>> results;
+        double elapsed_ms = 0.0;
+        {
+            // Stages take the GIL per item; the main thread must not hold it
+            py::gil_scoped_release release;
+            auto begin = std::chrono::steady_clock::now();
+            pipeline.start();
+
+            std::thread feeder([&] {
+                for (int r = 0; r < repeat; r++) {
+                    for (const std::string& image : images) {
+                        pipeline.submit(image);
+                    }
+                }
+                pipeline.close();
+            });
+
+            std::any item;
+            int64_t sequence = -1;
+            while (pipeline.next(&item, &sequence)) {
+                results.emplace_back(sequence, std::any_cast<std::vector<Prediction>>(std::move(item)));
+            }
+            feeder.join();
+            elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+            pipeline.stop();
+        }
+
+        if (!pipeline.first_error().empty()) {
+            std::cerr << "Stage error: " << pipeline.first_error() << "\n";
+        }
+
+        const LabelMap& labels = LabelMap::imagenet();
+        for (const auto& [sequence, top_k] : results) {
+            if (sequence < static_cast<int64_t>(images.size()) && !top_k.empty()) {
+                std::cout << images[sequence] << ": " << labels[top_k[0].class_id]
+                          << " (class " << top_k[0].class_id << ", " << std::fixed
+                          << std::setprecision(4) << top_k[0].score << ")\n";
+            }
+        }
+
+        double sequential_ms = 0.0;
+        std::cout << "\n" << std::setw(12) << std::left << "stage"
+                  << std::setw(8) << std::right << "workers"
+                  << std::setw(8) << "items"
+                  << std::setw(12) << "mean ms"
+                  << std::setw(12) << "blocked ms"
+                  << std::setw(8) << "util" << "\n";
+        std::cout << std::fixed << std::setprecision(2);
+        for (const StageStats& stage : pipeline.stats()) {
+            sequential_ms += stage.mean_ms;
+            std::cout << std::setw(12) << std::left << stage.name
+                      << std::setw(8) << std::right << stage.num_workers
+                      << std::setw(8) << stage.items
+                      << std::setw(12) << stage.mean_ms
+                      << std::setw(12) << stage.blocked_ms
+                      << std::setw(8) << stage.utilization << "\n";
+        }
+
+        double per_item_ms = results.empty() ? 0.0 : elapsed_ms / results.size();
+        std::cout << "\nImages: " << results.size() << " in " << elapsed_ms << " ms ("
+                  << per_item_ms << " ms/image pipelined, " << sequential_ms
+                  << " ms/image back to back)\n";
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
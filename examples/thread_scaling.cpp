@@ -0,0 +1,98 @@
+/**
+ * @file thread_scaling.cpp
+ * @brief Benchmark TVM runtime thread scaling across cores and sockets
+ *
+ * Runs a Relax module at increasing thread counts with the runtime pool
+ * pinned to "compact" (fill one NUMA node first) and, on multi-socket
+ * hosts, "spread" (alternate nodes) core sets, and prints latency, speedup
+ * and parallel efficiency per configuration.
+ *
+ * Usage: thread_scaling [--resnet18] [--runs N] [thread counts...]
+ */
+
+#include "ffi/tvm_ffi.h"
+#include "python_hook.h"
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace tvm_sdk::ffi;
+using namespace tvm_sdk;
+
+int main(int argc, char** argv) {
+    bool use_resnet18 = false;
+    int num_runs = 20;
+    std::vector<int> thread_counts;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--resnet18") {
+            use_resnet18 = true;
+        } else if (arg == "--runs" && i + 1 < argc) {
+            num_runs = std::atoi(argv[++i]);
+        } else {
+            thread_counts.push_back(std::atoi(arg.c_str()));
+        }
+    }
+
+    try {
+        PythonHook::initialize();
+
+        std::cout << "CPU topology:\n";
+        for (const auto& [key, value] : TVMFFI::get_cpu_topology()) {
+            std::cout << "  " << std::setw(16) << std::left << key << ": " << value << "\n";
+        }
+
+        std::string relax_ir;
+        if (use_resnet18) {
+            // Weights stay function inputs and are filled with random data
+            py::object result = PythonHook::call_function("tvm_ext", "create_resnet18_relax_ir", false, true);
+            py::dict info = py::cast<py::dict>(result);
+            if (!info.contains("relax_mod_json")) {
+                std::cerr << "Failed to convert ResNet18: " << py::cast<std::string>(info["error_message"]) << "\n";
+                return 1;
+            }
+            relax_ir = py::cast<std::string>(info["relax_mod_json"]);
+        } else {
+            py::object result = PythonHook::call_function("tvm_ext", "create_simple_relax_ir");
+            relax_ir = PythonHook::to_cpp<std::string>(result);
+        }
+
+        std::cout << "\nBenchmarking " << (use_resnet18 ? "ResNet18" : "simple matmul")
+                  << " (" << num_runs << " runs per configuration)...\n";
+        ThreadScalingReport report = TVMFFI::benchmark_thread_scaling(relax_ir, "llvm", thread_counts, num_runs);
+        if (report.status != "success") {
+            std::cerr << "Benchmark failed: " << report.error << "\n";
+            return 1;
+        }
+
+        std::cout << "Target: " << report.target << "\n";
+        std::cout << "NUMA nodes: " << report.num_numa_nodes << "\n\n";
+        std::cout << std::setw(10) << std::left << "placement"
+                  << std::setw(10) << std::right << "threads"
+                  << std::setw(8) << "nodes"
+                  << std::setw(12) << "mean ms"
+                  << std::setw(12) << "p50 ms"
+                  << std::setw(10) << "std ms"
+                  << std::setw(10) << "speedup"
+                  << std::setw(8) << "eff" << "\n";
+        std::cout << std::fixed << std::setprecision(3);
+        for (const auto& entry : report.results) {
+            std::cout << std::setw(10) << std::left << entry.placement
+                      << std::setw(10) << std::right << entry.num_threads
+                      << std::setw(8) << entry.numa_nodes_used
+                      << std::setw(12) << entry.mean_ms
+                      << std::setw(12) << entry.p50_ms
+                      << std::setw(10) << entry.std_ms
+                      << std::setw(10) << std::setprecision(2) << entry.speedup
+                      << std::setw(8) << entry.efficiency << std::setprecision(3) << "\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+#ifndef TVM_BACKEND_H
+#define TVM_BACKEND_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tvm_sdk {
+namespace ffi {
+
+/**
+ * @brief Code generator for the compute-heavy layers
+ */
+enum class Backend {
+    TVM,    ///< TVM codegen, optionally tuned with MetaSchedule (default)
+    DNNL    ///< Offload conv2d/dense/pooling to oneDNN via BYOC (TVM built with USE_DNNL)
+};
+
+/**
+ * @brief Backend selection for compile_with_metaschedule
+ *
+ * With Backend::DNNL, only the layers left to TVM become tuning tasks.
+ */
+struct BackendConfig {
+    Backend backend = Backend::TVM;
+    std::vector<std::string> offload_ops;   ///< Op groups for DNNL ("conv2d", "dense", "pool"; empty = all)
+};
+
+/**
+ * @brief One variant of a backend benchmark
+ */
+struct BackendResult {
+    std::string name;                   ///< "untuned", "tuned" or "dnnl"
+    std::string status;                 ///< "success", "error" or "skipped"
+    std::string error;
+    double compile_ms = 0.0;            ///< Sum of compile phase wall times (incl. tuning)
+    double mean_ms = 0.0;
+    double p50_ms = 0.0;
+    double min_ms = 0.0;
+    int64_t library_bytes = 0;          ///< Size of the exported library
+    int64_t runtime_rss_kb = 0;         ///< RSS added by loading and warming up the module
+    int64_t peak_rss_kb = 0;            ///< Process high-water mark after the compile
+    int num_offloaded = 0;              ///< Layers offloaded to DNNL
+    double max_rel_error = 0.0;         ///< Against the untuned TVM output
+};
+
+/**
+ * @brief Untuned TVM vs. MetaSchedule-tuned TVM vs. DNNL offload on one model
+ */
+struct BackendBenchmark {
+    std::string status;
+    std::string error;
+    std::string target;
+    std::vector<BackendResult> results;     ///< In order untuned, tuned, dnnl
+};
+
+/**
+ * @brief Get the Python-side name of a backend ("tvm", "dnnl")
+ */
+const char* to_string(Backend backend);
+
+} // namespace ffi
+} // namespace tvm_sdk
+
+#endif // TVM_BACKEND_H
@@ -0,0 +1,74 @@
+#ifndef TVM_DYNAMIC_SHAPE_H
+#define TVM_DYNAMIC_SHAPE_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace tvm_sdk {
+namespace ffi {
+
+/**
+ * @brief Values of the symbolic dimensions (e.g., {"batch", 1}, {"height", 224})
+ */
+using ShapeBindings = std::map<std::string, int64_t>;
+
+/**
+ * @brief Shapes to tune and to check for a dynamic-shape build
+ */
+struct DynamicShapeConfig {
+    std::vector<ShapeBindings> representative_shapes;   ///< Tuned as static specializations
+    std::vector<ShapeBindings> check_shapes;            ///< Run after the build (empty = representative shapes)
+    bool skip_check = false;
+};
+
+/**
+ * @brief Tuned static specialization of "main" for one representative shape
+ */
+struct SpecializedFunction {
+    std::string function;               ///< e.g. "main_batch1_height224_width224"
+    ShapeBindings bindings;
+    int num_tasks = 0;
+    int tuned_tasks = 0;
+    int reused_tasks = 0;
+    int64_t new_records = 0;
+};
+
+/**
+ * @brief One shape run on the built library
+ */
+struct ShapeCheck {
+    ShapeBindings bindings;
+    std::string function;               ///< Function the shape dispatched to
+    double mean_ms = 0.0;
+    double dynamic_mean_ms = 0.0;       ///< Same inputs through the symbolic "main"
+    double max_rel_error = 0.0;         ///< Dispatched vs. symbolic output
+};
+
+/**
+ * @brief One executable serving every shape of a module with symbolic dimensions
+ *
+ * The library holds "main" with symbolic kernels and one tuned
+ * specialization per representative shape. The manifest maps input shapes
+ * to specializations (see TVMFFI::select_shape_function); any other shape
+ * runs "main" without recompilation.
+ */
+struct DynamicCompileResult {
+    std::string status;
+    std::string error;
+    std::string target;
+    std::string lib_path;
+    std::string manifest_path;
+    std::vector<std::string> symbolic_vars;
+    int num_kernels = 0;
+    int num_dynamic_kernels = 0;        ///< Kernels with symbolic buffer dimensions
+    int num_tuned_kernels = 0;          ///< Kernels scheduled from the tuning database
+    std::vector<SpecializedFunction> specialized;
+    std::vector<ShapeCheck> checks;
+};
+
+} // namespace ffi
+} // namespace tvm_sdk
+
+#endif // TVM_DYNAMIC_SHAPE_H
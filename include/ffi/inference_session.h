@@ -0,0 +1,198 @@
+#ifndef TVM_INFERENCE_SESSION_H
+#define TVM_INFERENCE_SESSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tvm_sdk {
+namespace ffi {
+
+/**
+ * @brief Caller-owned tensor memory, aligned for zero-copy use by the TVM runtime
+ */
+class TensorBuffer {
+public:
+    static constexpr size_t kAlignment = 64;  ///< TVM runtime data alignment
+
+    /**
+     * @brief Allocate an aligned, zero-initialized buffer
+     * @param shape Tensor shape
+     * @param dtype Element type ("float32", "float16", "int8", "int32", "int64", ...)
+     */
+    TensorBuffer(std::vector<int64_t> shape, std::string dtype = "float32");
+    ~TensorBuffer();
+
+    TensorBuffer(const TensorBuffer&) = delete;
+    TensorBuffer& operator=(const TensorBuffer&) = delete;
+
+    void* data() { return data_; }
+    const void* data() const { return data_; }
+
+    template<typename T>
+    T* data_as() { return static_cast<T*>(data_); }
+
+    template<typename T>
+    const T* data_as() const { return static_cast<const T*>(data_); }
+
+    const std::vector<int64_t>& shape() const { return shape_; }
+    const std::string& dtype() const { return dtype_; }
+    int64_t num_elements() const { return num_elements_; }
+    size_t nbytes() const { return nbytes_; }
+
+private:
+    std::vector<int64_t> shape_;
+    std::string dtype_;
+    int64_t num_elements_ = 1;
+    size_t nbytes_ = 0;
+    void* data_ = nullptr;
+};
+
+/**
+ * @brief Pool of reusable TensorBuffers keyed by shape and dtype
+ *
+ * Buffers are allocated on first acquire and handed out again after
+ * release, so steady-state request handling does not allocate.
+ */
+class TensorBufferPool {
+public:
+    /**
+     * @brief Get a free buffer of the given shape and dtype, allocating if none is free
+     */
+    std::shared_ptr<TensorBuffer> acquire(const std::vector<int64_t>& shape, const std::string& dtype = "float32");
+
+    /**
+     * @brief Return a buffer to the pool
+     */
+    void release(std::shared_ptr<TensorBuffer> buffer);
+
+    /**
+     * @brief Number of buffers allocated by this pool
+     */
+    size_t num_allocated() const { return num_allocated_; }
+
+private:
+    std::vector<std::shared_ptr<TensorBuffer>> free_;
+    size_t num_allocated_ = 0;
+};
+
+/**
+ * @brief Steady-state inference on a compiled Relax library with bound buffers
+ *
+ * Input and output buffers are bound to the Relax VM once. For a library
+ * compiled with CompileOptions::destination_passing, the outputs are
+ * trailing parameters of the function: run() invokes a VM closure saved
+ * with all bound buffers and the kernels write the results straight into
+ * the output buffers, so steady-state inference does not allocate. Other
+ * libraries run through set_input / invoke_stateful, and the VM-allocated
+ * results are copied into the bound output buffers.
+ *
+ * Not thread-safe: use one session per thread.
+ */
+class InferenceSession {
+public:
+    /**
+     * @brief Load a compiled library (e.g., compiled_lib.so) into a Relax VM
+     * @param lib_path Path to the exported library
+     * @param func_name Relax function to run
+     * @param device Device name ("cpu", "cuda", ...)
+     */
+    explicit InferenceSession(
+        const std::string& lib_path,
+        const std::string& func_name = "main",
+        const std::string& device = "cpu"
+    );
+    ~InferenceSession();
+
+    InferenceSession(const InferenceSession&) = delete;
+    InferenceSession& operator=(const InferenceSession&) = delete;
+
+    /**
+     * @brief Bind caller-owned input and output buffers
+     *
+     * The buffers must outlive the session or the next bind() call.
+     *
+     * @param inputs Function inputs in parameter order
+     * @param outputs Function outputs (one per tuple field for tuple results)
+     * @throws std::runtime_error if the buffers match neither the function's inputs nor inputs plus outputs
+     */
+    void bind(const std::vector<TensorBuffer*>& inputs, const std::vector<TensorBuffer*>& outputs);
+
+    /**
+     * @brief Run the function on the bound buffers; results are written to the outputs
+     */
+    void run();
+
+    /**
+     * @brief Run several times so that allocator pools and caches are warm
+     */
+    void warmup(int num_runs = 3);
+
+    const std::string& func_name() const { return func_name_; }
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+    std::string func_name_;
+};
+
+/**
+ * @brief Pool of Relax VM instances sharing one copy of the model weights
+ *
+ * Loads a library exported by TVMFFI::export_with_params_as_input together
+ * with its parameters once, and creates num_instances VMs that all pass the
+ * same read-only parameter tensors. Every instance has its own VM state and
+ * its own thread, pinned to cores_per_instance dedicated cores if non-zero.
+ * With numa_local (and pinning), instances are spread over NUMA nodes and
+ * each node holds its own replica of the weights in local memory.
+ *
+ * run() is thread-safe. When calling it from several C++ threads, the thread
+ * that initialized Python must release the GIL (py::gil_scoped_release)
+ * while the others run.
+ */
+class ExecutorPool {
+public:
+    /**
+     * @brief Load the library and shared parameters from work_dir
+     * @param work_dir Directory written by export_with_params_as_input
+     * @param num_instances Number of VM instances
+     * @param cores_per_instance Cores pinned to each instance (0 = no pinning)
+     * @param device Device name ("cpu", "cuda", ...)
+     * @param numa_local Replicate weights per NUMA node and keep instances node-local
+     */
+    explicit ExecutorPool(
+        const std::string& work_dir,
+        int num_instances = 1,
+        int cores_per_instance = 0,
+        const std::string& device = "cpu",
+        bool numa_local = false
+    );
+    ~ExecutorPool();
+
+    ExecutorPool(const ExecutorPool&) = delete;
+    ExecutorPool& operator=(const ExecutorPool&) = delete;
+
+    /**
+     * @brief Run one inference on an idle instance
+     * @param inputs Runtime inputs (without weights) in parameter order
+     * @param outputs Output buffers, written in place
+     */
+    void run(const std::vector<TensorBuffer*>& inputs, const std::vector<TensorBuffer*>& outputs);
+
+    /**
+     * @brief Pool statistics (num_instances, num_params, param_bytes, num_replicas, num_runs, instance_cores)
+     */
+    std::map<std::string, std::string> stats();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace ffi
+} // namespace tvm_sdk
+
+#endif // TVM_INFERENCE_SESSION_H
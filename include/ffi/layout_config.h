@@ -0,0 +1,22 @@
+#ifndef TVM_LAYOUT_CONFIG_H
+#define TVM_LAYOUT_CONFIG_H
+
+namespace tvm_sdk {
+namespace ffi {
+
+/**
+ * @brief Blocked conv layout options
+ *
+ * With pack_conv, conv2d layers are converted from NCHW/OIHW to
+ * NCHW{c}c/OIHW{c}i{c}o and the transforms on constant weights are folded
+ * at build time.
+ */
+struct LayoutConfig {
+    bool pack_conv = false;
+    int block_size = 0;     ///< Channel block c (0 = target vector width / 32 bits)
+};
+
+} // namespace ffi
+} // namespace tvm_sdk
+
+#endif // TVM_LAYOUT_CONFIG_H
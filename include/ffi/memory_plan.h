@@ -0,0 +1,57 @@
+#ifndef TVM_MEMORY_PLAN_H
+#define TVM_MEMORY_PLAN_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tvm_sdk {
+namespace ffi {
+
+/**
+ * @brief One storage token of the static memory plan
+ */
+struct PlannedAllocation {
+    std::string storage;                ///< Storage variable in the planned IR
+    int64_t bytes = 0;
+    std::vector<std::string> tensors;   ///< Tensors placed in this storage over the program
+};
+
+/**
+ * @brief Result of Relax static memory planning for one function
+ *
+ * Planned storage holds the intermediate tensors; outputs and tensors with
+ * dynamic shapes are left to the runtime allocator ("unplanned"). With the
+ * runtime check, the storage the VM actually allocates per run is recorded
+ * and compared with the plan.
+ */
+struct MemoryPlanReport {
+    std::string status;
+    std::string error;
+    std::string target;
+    std::string function;
+    int64_t planned_bytes = 0;          ///< Sum of storage tokens
+    int64_t requested_bytes = 0;        ///< Sum of tensors placed in planned storage
+    int64_t unplanned_bytes = 0;        ///< Static-shape tensors left to the runtime allocator
+    int64_t peak_live_bytes = 0;        ///< Largest sum of simultaneously live tensors
+    int num_storage_tokens = 0;
+    int num_planned_tensors = 0;
+    int num_unplanned_tensors = 0;
+    int num_dynamic_allocations = 0;    ///< Allocations with symbolic sizes (not counted in bytes)
+    double reuse_ratio = 0.0;           ///< requested_bytes / planned_bytes
+    double plan_efficiency = 0.0;       ///< peak_live_bytes / (planned_bytes + unplanned_bytes)
+    std::vector<PlannedAllocation> largest_allocations;
+
+    // Runtime check (check_runtime = true)
+    bool runtime_checked = false;
+    int64_t runtime_storage_bytes = 0;  ///< Storage allocated by the VM per run
+    int64_t runtime_num_allocations = 0;
+    int64_t runtime_rss_delta_kb = 0;   ///< RSS growth over the first run (includes allocator pooling)
+    double runtime_ms = 0.0;
+    bool within_plan = false;           ///< runtime_storage_bytes <= planned_bytes + unplanned_bytes
+};
+
+} // namespace ffi
+} // namespace tvm_sdk
+
+#endif // TVM_MEMORY_PLAN_H
@@ -0,0 +1,62 @@
+#ifndef TVM_MIXED_PRECISION_H
+#define TVM_MIXED_PRECISION_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tvm_sdk {
+namespace ffi {
+
+/**
+ * @brief Storage precision of converted layers
+ */
+enum class Precision {
+    Float32,    ///< No conversion (default)
+    BFloat16,   ///< bfloat16 storage, float32 accumulation (AVX512-BF16/AMX)
+    Float16     ///< float16 storage, float32 accumulation
+};
+
+/**
+ * @brief Mixed-precision compilation options
+ *
+ * A layer is converted if its operator is in allow_ops and neither the
+ * operator nor the layer name (bound variable) is in deny_ops. Operator
+ * names omit the "relax." prefix (e.g., "nn.conv2d", "matmul").
+ */
+struct MixedPrecisionConfig {
+    Precision precision = Precision::Float32;
+    std::vector<std::string> allow_ops;     ///< Empty = nn.conv1d, nn.conv2d, matmul
+    std::vector<std::string> deny_ops;      ///< Operators or layer names kept in float32
+};
+
+/**
+ * @brief Float32 vs. mixed-precision build of the same module
+ */
+struct PrecisionComparison {
+    std::string status;
+    std::string error;
+    std::string target;
+    std::string precision;
+    int num_converted_layers = 0;
+    std::vector<std::string> converted_layers;
+    double float_latency_ms = 0.0;
+    double mixed_latency_ms = 0.0;
+    double speedup = 0.0;               ///< float_latency_ms / mixed_latency_ms
+    int64_t float_weight_bytes = 0;
+    int64_t mixed_weight_bytes = 0;
+    double max_abs_error = 0.0;
+    double mean_abs_error = 0.0;
+    double max_rel_error = 0.0;         ///< Relative to the largest float32 output magnitude
+    double top1_agreement = 0.0;        ///< Share of output rows with the same argmax
+};
+
+/**
+ * @brief Get the Python-side name of a precision ("float32", "bfloat16", "float16")
+ */
+const char* to_string(Precision precision);
+
+} // namespace ffi
+} // namespace tvm_sdk
+
+#endif // TVM_MIXED_PRECISION_H
@@ -0,0 +1,62 @@
+#ifndef TVM_MODEL_IMPORT_H
+#define TVM_MODEL_IMPORT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tvm_sdk {
+namespace ffi {
+
+/**
+ * @brief Shape and dtype of one model input
+ */
+struct InputSpec {
+    std::vector<int64_t> shape;
+    std::string dtype = "float32";
+    std::vector<std::string> dim_names = {};    ///< Per-dimension symbolic name ("" or missing = shape[i])
+};
+
+/**
+ * @brief FX-traceable model to import
+ */
+struct ModelSpec {
+    std::string name;                   ///< torchvision model name (e.g., "resnet50", "mobilenet_v2")
+    std::vector<InputSpec> inputs;      ///< Empty = one (1, 3, 224, 224) float32 image
+    bool pretrained = true;
+};
+
+/**
+ * @brief One model of a shared-database tuning run
+ */
+struct ModelTuningResult {
+    std::string name;
+    std::string status;
+    std::string error;
+    int num_tasks = 0;
+    int tuned_tasks = 0;                    ///< Tasks that received new trials
+    int reused_tasks = 0;                   ///< Tasks already covered by the database
+    int reused_from_models = 0;             ///< Reused tasks that were tuned for another model
+    std::vector<std::string> reused_from;   ///< Models whose records were reused
+    int64_t new_records = 0;
+    std::string lib_path;                   ///< Compiled library (empty without build)
+};
+
+/**
+ * @brief Several models tuned through one database
+ */
+struct SharedTuningReport {
+    std::string status;
+    std::string error;
+    std::string work_dir;
+    std::string target;
+    int total_tasks = 0;                ///< Sum of tasks over all models
+    int unique_workloads = 0;           ///< Distinct workloads over all models
+    int shared_workloads = 0;           ///< Workloads appearing in more than one model
+    std::vector<ModelTuningResult> models;
+};
+
+} // namespace ffi
+} // namespace tvm_sdk
+
+#endif // TVM_MODEL_IMPORT_H
@@ -0,0 +1,107 @@
+#ifndef TVM_PARAM_FILE_H
+#define TVM_PARAM_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tvm_sdk {
+namespace ffi {
+
+class TensorBuffer;
+
+/**
+ * @brief One tensor in an SDK parameter file
+ */
+struct ParamEntry {
+    std::string name;
+    std::string dtype;              ///< TVM/numpy dtype name (e.g., "float32")
+    std::vector<int64_t> shape;
+    uint64_t offset = 0;            ///< Absolute file offset (64-byte aligned)
+    uint64_t nbytes = 0;
+    uint32_t crc32 = 0;             ///< CRC32 of the data (0 if checksums are off)
+    const void* data = nullptr;     ///< Pointer into the mapping
+};
+
+/**
+ * @brief Memory-mapped SDK parameter file (read side)
+ *
+ * Maps the whole file and parses only the header and index; tensor data
+ * is used in place, so loading costs page faults on first touch rather
+ * than a read and deserialize. The format is written by
+ * tvm_ext.param_file.save_param_file or ParamFile::save.
+ *
+ * The mapping is private and writable (copy-on-write): pages stay shared
+ * with the page cache, and consumers that require writable memory (DLPack)
+ * can wrap the data without copying.
+ */
+class ParamFile {
+public:
+    static constexpr uint32_t kVersion = 1;
+    static constexpr size_t kDataAlignment = 4096;   ///< Data section alignment
+    static constexpr size_t kTensorAlignment = 64;   ///< Per-tensor alignment
+
+    /**
+     * @brief Map a parameter file and read its index
+     * @param path Parameter file path
+     * @param verify_checksums Check every tensor's CRC32 (touches all data)
+     * @throws std::runtime_error if the file is missing, malformed or corrupt
+     */
+    explicit ParamFile(const std::string& path, bool verify_checksums = false);
+    ~ParamFile();
+
+    ParamFile(const ParamFile&) = delete;
+    ParamFile& operator=(const ParamFile&) = delete;
+
+    /**
+     * @brief Tensors in file order
+     */
+    const std::vector<ParamEntry>& entries() const { return entries_; }
+
+    /**
+     * @brief Find a tensor by name
+     * @return Entry or nullptr if not present
+     */
+    const ParamEntry* find(const std::string& name) const;
+
+    /**
+     * @brief Check all stored checksums
+     * @return Names of tensors whose data does not match (empty if all match)
+     */
+    std::vector<std::string> verify() const;
+
+    bool has_checksums() const { return has_checksums_; }
+    size_t file_size() const { return size_; }
+    const std::string& path() const { return path_; }
+
+    /**
+     * @brief Write named tensors to a parameter file
+     * @param path Output file path
+     * @param tensors (name, buffer) pairs in file order
+     * @param checksum Store a CRC32 per tensor
+     */
+    static void save(
+        const std::string& path,
+        const std::vector<std::pair<std::string, const TensorBuffer*>>& tensors,
+        bool checksum = true
+    );
+
+private:
+    std::string path_;
+    void* mapping_ = nullptr;
+    size_t size_ = 0;
+    bool has_checksums_ = false;
+    std::vector<ParamEntry> entries_;
+};
+
+/**
+ * @brief CRC32 (IEEE, as zlib.crc32) of a byte range
+ */
+uint32_t crc32(const void* data, size_t size);
+
+} // namespace ffi
+} // namespace tvm_sdk
+
+#endif // TVM_PARAM_FILE_H
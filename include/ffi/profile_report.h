@@ -0,0 +1,65 @@
+#ifndef TVM_PROFILE_REPORT_H
+#define TVM_PROFILE_REPORT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tvm_sdk {
+namespace ffi {
+
+/**
+ * @brief Profile of a single operator (kernel) of a compiled Relax module
+ */
+struct OperatorProfile {
+    std::string name;               ///< Kernel name as reported by the Relax VM
+    int64_t call_count = 0;         ///< Calls per inference
+    double total_us = 0.0;          ///< Total time per inference (us)
+    double mean_us = 0.0;           ///< Mean time per call (us)
+    double share = 0.0;             ///< Fraction of end-to-end time
+    double flops = -1.0;            ///< FLOPs per call (-1 if not computable)
+    double gflops_per_sec = -1.0;   ///< Achieved GFLOP/s (-1 if not computable)
+    std::string workload_hash;      ///< MetaSchedule workload hash (empty if untuned)
+    int64_t tuning_records = 0;     ///< Tuning records for the workload
+    double best_tuned_us = -1.0;    ///< Best measured latency in the database (us)
+};
+
+/**
+ * @brief Per-operator profiling report of a compiled Relax module
+ */
+struct ProfileReport {
+    std::string status;             ///< "success" or "error"
+    std::string error;              ///< Error message if status is "error"
+    std::string target;
+    std::string work_dir;
+    int num_runs = 0;
+    double e2e_time_us = 0.0;       ///< End-to-end time per inference (us)
+    std::vector<OperatorProfile> operators;  ///< Sorted by total time, descending
+
+    /**
+     * @brief Export operator table as CSV (one header row, one row per operator)
+     */
+    std::string to_csv() const;
+
+    /**
+     * @brief Export the whole report as JSON
+     */
+    std::string to_json() const;
+
+    /**
+     * @brief Write to_csv() output to a file
+     * @return true on success
+     */
+    bool save_csv(const std::string& path) const;
+
+    /**
+     * @brief Write to_json() output to a file
+     * @return true on success
+     */
+    bool save_json(const std::string& path) const;
+};
+
+} // namespace ffi
+} // namespace tvm_sdk
+
+#endif // TVM_PROFILE_REPORT_H
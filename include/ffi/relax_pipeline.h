@@ -0,0 +1,73 @@
+#ifndef TVM_RELAX_PIPELINE_H
+#define TVM_RELAX_PIPELINE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tvm_sdk {
+namespace ffi {
+
+/**
+ * @brief Relax optimization pipeline applied before tuning and build
+ *
+ * Presets:
+ *   - "minimal": legalize only (one kernel per operator)
+ *   - "zero": legalize, annotate_op_pattern, fold_constant, fuse_ops, fuse_tir
+ *   - "optimized": canonicalize_bindings, cse, fold_constant and
+ *     dead_code_elimination around "zero"
+ *   - "full": "optimized" plus static_memory_planning
+ *
+ * Custom lists take pass names from the same set plus "decompose_ops".
+ * Tuning and compilation of one model must use the same pipeline.
+ */
+struct RelaxPipelineConfig {
+    std::string preset = "zero";
+    std::vector<std::string> passes;    ///< Custom pass list (overrides preset if non-empty)
+};
+
+/**
+ * @brief Time and IR size effect of one Relax pass
+ */
+struct PassReport {
+    std::string name;
+    double wall_ms = 0.0;
+    int64_t bindings_before = 0;        ///< Relax variable bindings
+    int64_t bindings_after = 0;
+    int64_t primfuncs_before = 0;
+    int64_t primfuncs_after = 0;
+    int64_t tir_nodes_before = 0;       ///< TIR statements and expressions in all PrimFuncs
+    int64_t tir_nodes_after = 0;
+};
+
+/**
+ * @brief Compile time and latency of one pipeline (untuned)
+ */
+struct RelaxPipelineReport {
+    std::string pipeline;               ///< Preset name or "custom"
+    std::vector<std::string> passes;
+    std::string status;
+    std::string error;
+    std::vector<PassReport> pass_reports;
+    double pipeline_ms = 0.0;           ///< Sum of pass wall times
+    double build_ms = 0.0;              ///< relax.build after the pipeline
+    double mean_ms = 0.0;
+    double p50_ms = 0.0;
+    int num_primfuncs = 0;
+    double max_rel_error = 0.0;         ///< Against the first successful pipeline
+};
+
+/**
+ * @brief Several pipelines applied to the same module
+ */
+struct PipelineComparison {
+    std::string status;
+    std::string error;
+    std::string target;
+    std::vector<RelaxPipelineReport> results;
+};
+
+} // namespace ffi
+} // namespace tvm_sdk
+
+#endif // TVM_RELAX_PIPELINE_H
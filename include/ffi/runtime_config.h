@@ -0,0 +1,80 @@
+#ifndef TVM_RUNTIME_CONFIG_H
+#define TVM_RUNTIME_CONFIG_H
+
+#include <string>
+#include <vector>
+
+namespace tvm_sdk {
+namespace ffi {
+
+/**
+ * @brief Core cluster used by the TVM runtime thread pool
+ */
+enum class CoreMode {
+    Default,    ///< TVM default (big cores on asymmetric machines)
+    Big,        ///< High-frequency cores only
+    Little      ///< Low-frequency cores only
+};
+
+/**
+ * @brief How idle pool workers wait for the next parallel region
+ */
+enum class WaitPolicy {
+    Default,    ///< Keep the runtime's setting
+    Spin,       ///< Busy-wait (lowest latency, occupies the cores)
+    Sleep       ///< Block immediately (frees cores for other work)
+};
+
+/**
+ * @brief TVM runtime thread pool configuration
+ */
+struct RuntimeConfig {
+    int num_threads = 0;                ///< Worker count (0 = one per selected core)
+    CoreMode core_mode = CoreMode::Default;
+    std::vector<int> cpus;              ///< Explicit CPU ids (overrides core_mode)
+    int numa_node = -1;                 ///< Restrict to one NUMA node (-1 = any)
+    bool pin_threads = true;            ///< One core per worker (false: share the set)
+    WaitPolicy wait_policy = WaitPolicy::Default;
+    int spin_count = -1;                ///< Spin iterations before sleeping (-1 = from wait_policy)
+};
+
+/**
+ * @brief Latency at one thread count and placement
+ */
+struct ThreadScalingResult {
+    std::string placement;          ///< "compact" (fill one socket first) or "spread"
+    int num_threads = 0;
+    int numa_nodes_used = 0;
+    double mean_ms = 0.0;
+    double p50_ms = 0.0;
+    double std_ms = 0.0;
+    double speedup = 0.0;           ///< Relative to one thread
+    double efficiency = 0.0;        ///< speedup / num_threads
+};
+
+/**
+ * @brief Thread scaling benchmark results
+ */
+struct ThreadScalingReport {
+    std::string status;
+    std::string error;
+    std::string target;
+    int num_numa_nodes = 0;
+    int num_runs = 0;
+    std::vector<ThreadScalingResult> results;
+};
+
+/**
+ * @brief Get the Python-side name of a core mode ("default", "big", "little")
+ */
+const char* to_string(CoreMode mode);
+
+/**
+ * @brief Get the Python-side name of a wait policy ("default", "spin", "sleep")
+ */
+const char* to_string(WaitPolicy policy);
+
+} // namespace ffi
+} // namespace tvm_sdk
+
+#endif // TVM_RUNTIME_CONFIG_H
@@ -44,10 +44,12 @@ public:
     /**
      * @brief Save model state dict
      * @param output_path Path to save state dict
+     * @param format "state_dict" (torch.save) or "sdk" (memory-mappable ParamFile)
      * @return Save status information as map
      */
     static std::map<std::string, std::string> save_model_state(
-        const std::string& output_path = "resnet18_state.pth"
+        const std::string& output_path = "resnet18_state.pth",
+        const std::string& format = "state_dict"
     );
 
 private:
@@ -0,0 +1,134 @@
+#ifndef TVM_TUNING_CONFIG_H
+#define TVM_TUNING_CONFIG_H
+
+#include "ffi/relax_pipeline.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace tvm_sdk {
+namespace ffi {
+
+/**
+ * @brief MetaSchedule cost model
+ */
+enum class CostModelKind {
+    Random,     ///< Random scores (baseline)
+    XGBoost,    ///< Gradient-boosted trees (TVM default)
+    MLP         ///< Multi-layer perceptron (requires PyTorch)
+};
+
+/**
+ * @brief MetaSchedule search strategy
+ */
+enum class SearchStrategyKind {
+    Evolutionary,   ///< Evolutionary search guided by the cost model
+    ReplayTrace,    ///< Random replay of design-space traces
+    ReplayFunc      ///< Random replay of the schedule function
+};
+
+/**
+ * @brief Evolutionary search parameters (TVM defaults)
+ */
+struct EvolutionaryConfig {
+    int population_size = 512;          ///< Candidates per generation
+    double init_measured_ratio = 0.2;   ///< Share of the initial population taken from the database
+    int init_min_unmeasured = 50;       ///< Minimum freshly sampled initial candidates
+    int max_fail_count = 5;             ///< Sampling failures before giving up
+    int genetic_num_iters = 4;          ///< Generations per search iteration
+    double genetic_mutate_prob = 0.85;  ///< Probability of mutating a candidate
+    int genetic_max_fail_count = 10;    ///< Mutation failures before giving up
+    double eps_greedy = 0.05;           ///< Share of randomly picked candidates
+};
+
+/**
+ * @brief Early-stopping criterion per task
+ *
+ * A task stops once `patience` measured candidates in a row did not improve
+ * its best latency by more than `min_improvement` (relative).
+ */
+struct EarlyStoppingConfig {
+    int patience = 0;               ///< Candidates without improvement (0 = disabled)
+    double min_improvement = 0.01;  ///< Relative improvement that resets patience
+};
+
+/**
+ * @brief How candidates are measured
+ */
+enum class MeasurementMode {
+    Fixed,      ///< Fixed repeat count (MetaSchedule LocalRunner)
+    Adaptive    ///< Repeats chosen per candidate by confidence intervals
+};
+
+/**
+ * @brief Adaptive measurement repeats
+ *
+ * A candidate stops after min_repeats once its confidence interval lies
+ * above the best candidate's; it gets repeat_step more repeats while the
+ * intervals overlap or its interval is wider than target_rel_ci of the
+ * mean. All repeats are stored in the record's run_secs, from which the
+ * confidence interval is recomputed (WorkloadStats::best_ci_us,
+ * apply_tuning_database with rank_by "upper_ci").
+ */
+struct MeasurementConfig {
+    MeasurementMode mode = MeasurementMode::Fixed;
+    int min_repeats = 3;
+    int max_repeats = 30;
+    int repeat_step = 3;
+    double target_rel_ci = 0.02;    ///< Interval half-width / mean considered precise
+    double confidence = 0.95;
+    int min_repeat_ms = 50;         ///< Minimum duration of one repeat
+    double timeout_sec = 30.0;      ///< Per-candidate measurement timeout
+    bool enable_cpu_cache_flush = false;
+};
+
+/**
+ * @brief Typed MetaSchedule tuning configuration
+ */
+struct TuningConfig {
+    int num_trials = 64;                ///< Global trial budget
+    int max_trials_per_task = 0;        ///< Per-task cap (0 = num_trials)
+    int num_trials_per_iter = 64;       ///< Candidates measured per iteration
+    int max_workers = 0;                ///< Builder/model threads (0 = CPU count)
+    int seed = -1;                      ///< Random seed (-1 = random)
+    bool post_optimization = false;     ///< Run post-tuning optimization
+
+    CostModelKind cost_model = CostModelKind::XGBoost;
+    SearchStrategyKind search_strategy = SearchStrategyKind::Evolutionary;
+    EvolutionaryConfig evolutionary;
+
+    /// Space generator ("post-order-apply")
+    std::string space_generator = "post-order-apply";
+
+    /// Mutator name -> probability ("tile_size", "parallel", "unroll",
+    /// "compute_location", "thread_binding"); empty = target defaults
+    std::map<std::string, double> mutator_probs;
+
+    /// Postprocessor names (e.g., "rewrite_parallel_vectorize_unroll",
+    /// "rewrite_layout"); empty = target defaults
+    std::vector<std::string> postprocs;
+
+    EarlyStoppingConfig early_stopping;
+    MeasurementConfig measurement;
+    RelaxPipelineConfig pipeline;       ///< Must match the pipeline used to compile
+};
+
+/**
+ * @brief Get the Python-side name of a cost model ("random", "xgb", "mlp")
+ */
+const char* to_string(CostModelKind kind);
+
+/**
+ * @brief Get the Python-side name of a search strategy
+ */
+const char* to_string(SearchStrategyKind kind);
+
+/**
+ * @brief Get the Python-side name of a measurement mode ("fixed", "adaptive")
+ */
+const char* to_string(MeasurementMode mode);
+
+} // namespace ffi
+} // namespace tvm_sdk
+
+#endif // TVM_TUNING_CONFIG_H
@@ -2,6 +2,17 @@
 #define TVM_FFI_H
 
 #include "python_hook.h"
+#include "ffi/backend.h"
+#include "ffi/layout_config.h"
+#include "ffi/memory_plan.h"
+#include "ffi/model_import.h"
+#include "ffi/dynamic_shape.h"
+#include "ffi/warm_start.h"
+#include "ffi/mixed_precision.h"
+#include "ffi/profile_report.h"
+#include "ffi/relax_pipeline.h"
+#include "ffi/runtime_config.h"
+#include "ffi/tuning_config.h"
 #include <string>
 #include <map>
 #include <vector>
@@ -9,6 +20,56 @@
 namespace tvm_sdk {
 namespace ffi {
 
+/**
+ * @brief Statistics of one workload in a MetaSchedule tuning database
+ */
+struct WorkloadStats {
+    std::string shash;              ///< Workload structural hash
+    int64_t num_records = 0;        ///< All records, including failed runs
+    int64_t num_valid = 0;          ///< Records with a successful measurement
+    double best_latency_us = -1.0;  ///< Best mean latency (-1 if none valid)
+    double best_ci_us = -1.0;       ///< 95% confidence half-width of the best record (-1 without repeats)
+    bool converged = false;         ///< Best latency stopped improving
+};
+
+/**
+ * @brief Wall time, CPU time and peak memory of one pipeline phase
+ */
+struct PhaseTiming {
+    std::string name;               ///< Phase name (e.g., "parse_ir", "tune", "relax_build")
+    double start_ms = 0.0;          ///< Start offset from the beginning of the call
+    double wall_ms = 0.0;           ///< Wall-clock time
+    double cpu_ms = 0.0;            ///< CPU time of this process
+    double children_cpu_ms = 0.0;   ///< CPU time of waited-for child processes (builders, runners)
+    int64_t peak_rss_kb = 0;        ///< Peak RSS of this process at the end of the phase
+};
+
+/**
+ * @brief Phase-level timing breakdown of a compile, tune or apply call
+ */
+struct PipelineTimings {
+    std::vector<PhaseTiming> phases;    ///< Phases in completion order
+    int64_t num_tasks = 0;              ///< Tuning tasks in the module
+    int64_t num_records = 0;            ///< Records in the tuning database afterwards
+    int64_t peak_rss_kb = 0;            ///< Peak RSS over all phases
+    double total_wall_ms = 0.0;         ///< Sum of phase wall times
+    std::string trace_path;             ///< Chrome trace file (empty if not written)
+    std::vector<PassReport> passes;     ///< Passes of the Relax pipeline phase (if run)
+};
+
+/**
+ * @brief Optional stages and outputs of TVMFFI::compile_with_metaschedule
+ */
+struct CompileOptions {
+    PipelineTimings* timings = nullptr;     ///< Filled with per-phase timings (optional)
+    std::string trace_path;                 ///< Write phase timings as a Chrome trace to this path (optional)
+    MixedPrecisionConfig mixed_precision;   ///< Opt-in bf16/fp16 storage for allowed layers (default: float32)
+    LayoutConfig layout;                    ///< Opt-in NCHW[x]c conv packing (default: NCHW)
+    BackendConfig backend;                  ///< Codegen for conv2d/dense/pooling (default: TVM)
+    RelaxPipelineConfig pipeline;           ///< Relax pipeline, every pass forced to run (default: "zero")
+    bool destination_passing = false;       ///< main takes its outputs as trailing parameters (see InferenceSession)
+};
+
 /**
  * @brief TVM FFI (Foreign Function Interface)
  *
@@ -48,6 +109,120 @@ public:
      */
     static std::map<std::string, std::string> check_tuning_database(const std::string& work_dir = "tuning_database");
 
+    /**
+     * @brief Get per-workload statistics of a tuning database
+     * @param work_dir Directory containing tuning database
+     * @return Statistics ordered as the workloads appear in the database
+     */
+    static std::vector<WorkloadStats> get_workload_stats(const std::string& work_dir = "tuning_database");
+
+    /**
+     * @brief Merge tuning databases, deduplicating workloads by hash
+     * @param input_dirs Work directories to merge
+     * @param output_dir Directory for the merged database
+     * @param top_k Records to keep per workload (0 keeps all)
+     * @return Merge statistics as map
+     */
+    static std::map<std::string, std::string> merge_tuning_databases(
+        const std::vector<std::string>& input_dirs,
+        const std::string& output_dir,
+        int top_k = 0
+    );
+
+    /**
+     * @brief Keep only the top-K records per workload and build a lookup index
+     * @param work_dir Directory containing tuning database
+     * @param top_k Records to keep per workload
+     * @param output_dir Output directory (empty = compact in place)
+     * @return Compaction statistics as map (output_records, index_path)
+     */
+    static std::map<std::string, std::string> compact_tuning_database(
+        const std::string& work_dir = "tuning_database",
+        int top_k = 1,
+        const std::string& output_dir = ""
+    );
+
+    /**
+     * @brief Import an FX-traceable torchvision model as Relax IR
+     * @param model Model name, input specs and weights
+     * @param keep_params Keep parameters as function inputs (false embeds them)
+     * @return Import result as map ("relax_mod_json" holds the loadable IR)
+     */
+    static std::map<std::string, std::string> create_model_relax_ir(
+        const ModelSpec& model,
+        bool keep_params = false
+    );
+
+    /**
+     * @brief Tune several models through one shared database
+     *
+     * Models are tuned in order; workloads another model already tuned
+     * (target_trials_per_task records or converged) are not tuned again.
+     *
+     * @param models Models to import and tune
+     * @param target_name Target name
+     * @param num_trials_per_model New-trial budget per model
+     * @param target_trials_per_task Trials after which a workload counts as tuned
+     * @param max_workers Number of parallel workers (0 = auto)
+     * @param work_dir Shared tuning database directory
+     * @param pipeline Relax pipeline (default: "zero")
+     * @param build Compile each model to <work_dir>/<name>.so
+     * @return Per-model tuned/reused tasks and workload sharing totals
+     */
+    static SharedTuningReport tune_models(
+        const std::vector<ModelSpec>& models,
+        const std::string& target_name = "llvm",
+        int num_trials_per_model = 64,
+        int target_trials_per_task = 64,
+        int max_workers = 0,
+        const std::string& work_dir = "tuning_database_shared",
+        const RelaxPipelineConfig& pipeline = {},
+        bool build = true
+    );
+
+    /**
+     * @brief Compile a module with symbolic input dimensions into one library for all shapes
+     *
+     * Each representative shape is tuned as a static specialization of
+     * "main"; other shapes run the symbolic kernels of "main".
+     *
+     * @param relax_mod_ir Relax module IR JSON with symbolic dimensions (empty =
+     *        pretrained ResNet18 with symbolic batch, height and width)
+     * @param target_name Target name
+     * @param shapes Representative shapes to tune and shapes to check
+     * @param use_auto_tuning Tune the representative shapes
+     * @param num_trials New-trial budget per representative shape
+     * @param target_trials_per_task Trials after which a workload counts as tuned
+     * @param max_workers Number of parallel workers (0 = auto)
+     * @param work_dir Tuning database and output directory
+     * @param pipeline Relax pipeline (default: "zero")
+     * @param num_runs Timed runs per checked shape
+     * @return Library, manifest, per-specialization tuning and per-shape checks
+     */
+    static DynamicCompileResult compile_dynamic(
+        const std::string& relax_mod_ir,
+        const std::string& target_name,
+        const DynamicShapeConfig& shapes,
+        bool use_auto_tuning = true,
+        int num_trials = 64,
+        int target_trials_per_task = 64,
+        int max_workers = 0,
+        const std::string& work_dir = "tuning_database_dynamic",
+        const RelaxPipelineConfig& pipeline = {},
+        int num_runs = 10
+    );
+
+    /**
+     * @brief Function of a dynamic-shape library to run for the given input shapes
+     * @param manifest_path Manifest written by compile_dynamic
+     * @param input_shapes Input shapes in parameter order
+     * @return Specialization tuned for these shapes, or "main" (pass to InferenceSession)
+     */
+    static std::string select_shape_function(
+        const std::string& manifest_path,
+        const std::vector<std::vector<int64_t>>& input_shapes
+    );
+
     /**
      * @brief Compile with MetaSchedule tuning
      * @param relax_mod_ir Relax module IR string
@@ -57,6 +232,7 @@ public:
      * @param max_workers Number of parallel workers (0 = auto)
      * @param work_dir Directory for tuning database
      * @param opt_level Optimization level (0-3)
+     * @param options Timings, trace output and opt-in stages (see CompileOptions)
      * @return Compilation results as map
      */
     static std::map<std::string, std::string> compile_with_metaschedule(
@@ -66,16 +242,166 @@ public:
         int num_trials = 64,
         int max_workers = 0,
         const std::string& work_dir = "tuning_database",
+        int opt_level = 0,
+        const CompileOptions& options = {}
+    );
+
+    /**
+     * @brief Build a module with several Relax pipelines (untuned) and compare them
+     * @param relax_mod_ir Relax module IR JSON ("" = pretrained ResNet18)
+     * @param target_name Target name (e.g., "llvm")
+     * @param pipelines Pipelines to compare (empty = all presets)
+     * @param num_runs Timed runs per build
+     * @param opt_level Optimization level of the build (the pipeline passes always run)
+     * @return Per-pass time and IR size, build time and latency per pipeline
+     */
+    static PipelineComparison compare_relax_pipelines(
+        const std::string& relax_mod_ir = "",
+        const std::string& target_name = "llvm",
+        const std::vector<RelaxPipelineConfig>& pipelines = {},
+        int num_runs = 20,
         int opt_level = 0
     );
 
+    /**
+     * @brief Get the Relax pipeline presets and their pass lists
+     */
+    static std::map<std::string, std::vector<std::string>> get_relax_pipeline_presets();
+
+    /**
+     * @brief Report the static memory plan of a module as it is compiled
+     * @param relax_mod_ir Relax module IR JSON ("" = pretrained ResNet18)
+     * @param target_name Target name (e.g., "llvm")
+     * @param pipeline Relax pipeline applied before planning (default: "zero")
+     * @param check_runtime Build and run the module and compare VM allocations with the plan
+     * @param top_k Number of largest storage tokens to list
+     * @param num_runs Instrumented runs for the runtime check
+     * @return Planned/peak bytes, storage tokens, reuse and largest allocations
+     */
+    static MemoryPlanReport memory_plan_report(
+        const std::string& relax_mod_ir = "",
+        const std::string& target_name = "llvm",
+        const RelaxPipelineConfig& pipeline = {},
+        bool check_runtime = false,
+        int top_k = 5,
+        int num_runs = 3
+    );
+
+    /**
+     * @brief Compare untuned TVM, MetaSchedule-tuned TVM and DNNL offload
+     *
+     * Variants run on the same random inputs. The tuned variant is omitted
+     * with num_trials = 0; the DNNL variant is "skipped" if TVM was built
+     * without DNNL.
+     *
+     * @param relax_mod_ir Relax module IR JSON ("" = pretrained ResNet18)
+     * @param target_name Target name (e.g., "llvm")
+     * @param num_trials Trials for the tuned variant
+     * @param max_workers Number of parallel workers (0 = auto)
+     * @param work_dir Parent of the per-variant work directories
+     * @param num_runs Timed runs per variant
+     * @param offload_ops Op groups offloaded to DNNL (empty = all)
+     * @return Compile time, latency and memory per variant
+     */
+    static BackendBenchmark benchmark_backends(
+        const std::string& relax_mod_ir = "",
+        const std::string& target_name = "llvm",
+        int num_trials = 64,
+        int max_workers = 0,
+        const std::string& work_dir = "backend_benchmark",
+        int num_runs = 20,
+        const std::vector<std::string>& offload_ops = {}
+    );
+
+    /**
+     * @brief Measure a module with and without NCHW[x]c conv packing (untuned)
+     * @param relax_mod_ir Relax module IR JSON ("" = pretrained ResNet18)
+     * @param target_name Target name (e.g., "llvm")
+     * @param block_size Channel block (0 = target vector width)
+     * @param num_runs Timed runs per build
+     * @return Comparison as map (block_size, num_packed_conv2d, nchw_mean_ms,
+     *         packed_mean_ms, speedup, max_rel_error, ...)
+     */
+    static std::map<std::string, std::string> compare_layout_packing(
+        const std::string& relax_mod_ir = "",
+        const std::string& target_name = "llvm",
+        int block_size = 0,
+        int num_runs = 20
+    );
+
+    /**
+     * @brief Build a module in float32 and in mixed precision and compare them
+     *
+     * Both builds are untuned and run on the same random inputs.
+     *
+     * @param relax_mod_ir Relax module IR JSON ("" = pretrained ResNet18)
+     * @param target_name Target name (e.g., "llvm")
+     * @param config Precision and allow/deny lists (Float32 is treated as BFloat16)
+     * @param num_runs Timed runs per build
+     * @return Latency, weight size and output error of both builds
+     */
+    static PrecisionComparison compare_mixed_precision(
+        const std::string& relax_mod_ir,
+        const std::string& target_name = "llvm",
+        const MixedPrecisionConfig& config = {},
+        int num_runs = 20
+    );
+
+    /**
+     * @brief INT8 post-training quantization with MetaSchedule tuning
+     *
+     * Calibrates activation ranges on images (ResNet preprocessing), rewrites
+     * conv2d/dense layers into int8 compute with int32 accumulation, tunes
+     * and builds the float32 and int8 modules, and compares their latency
+     * and top-1/top-5 agreement.
+     *
+     * @param relax_mod_ir Relax module IR JSON with embedded weights ("" = pretrained ResNet18)
+     * @param calibration_dir Directory of calibration images (or one image)
+     * @param target_name Target name (e.g., "llvm")
+     * @param use_auto_tuning Tune both modules with MetaSchedule
+     * @param num_trials Maximum number of trials per module
+     * @param max_workers Number of parallel workers (0 = auto)
+     * @param work_dir Output directory (float32/ and int8/ subdirectories)
+     * @param num_calibration Maximum number of calibration images
+     * @param calibration_method "minmax" or "average"
+     * @param eval_dir Images for the agreement check ("" = calibration images)
+     * @param timings Filled with per-phase timings (optional)
+     * @param trace_path Write phase timings as a Chrome trace to this path (optional)
+     * @return Results as map (lib_path, float_lib_path, float_latency_ms,
+     *         int8_latency_ms, speedup, top1_agreement, top5_agreement, ...)
+     */
+    static std::map<std::string, std::string> quantize_with_metaschedule(
+        const std::string& relax_mod_ir,
+        const std::string& calibration_dir,
+        const std::string& target_name = "llvm",
+        bool use_auto_tuning = true,
+        int num_trials = 64,
+        int max_workers = 0,
+        const std::string& work_dir = "tuning_database_int8",
+        int num_calibration = 32,
+        const std::string& calibration_method = "minmax",
+        const std::string& eval_dir = "",
+        PipelineTimings* timings = nullptr,
+        const std::string& trace_path = ""
+    );
+
     /**
      * @brief Tune with MetaSchedule only (no compilation)
+     *
+     * With rpc_servers > 0, measurements run on a local RPC farm whose
+     * servers are each pinned to cores_per_server dedicated cores, and
+     * builders are restricted to the remaining cores.
+     *
      * @param relax_mod_ir Relax module IR string
      * @param target_name Target name
      * @param num_trials Maximum number of trials
      * @param max_workers Number of parallel workers (0 = auto)
      * @param work_dir Directory for tuning database
+     * @param rpc_servers Number of local RPC measurement servers (0 = local runner)
+     * @param cores_per_server Cores pinned to each RPC server
+     * @param timings Filled with per-phase timings (optional)
+     * @param trace_path Write phase timings as a Chrome trace to this path (optional)
+     * @param pipeline Relax pipeline (must match the one used to compile)
      * @return Tuning results as map
      */
     static std::map<std::string, std::string> tune_with_metaschedule(
@@ -83,22 +409,257 @@ public:
         const std::string& target_name = "llvm",
         int num_trials = 64,
         int max_workers = 0,
+        const std::string& work_dir = "tuning_database",
+        int rpc_servers = 0,
+        int cores_per_server = 1,
+        PipelineTimings* timings = nullptr,
+        const std::string& trace_path = "",
+        const RelaxPipelineConfig& pipeline = {}
+    );
+
+    /**
+     * @brief Tune with an explicit MetaSchedule configuration
+     *
+     * Selects cost model, search strategy, space generator, mutator
+     * probabilities, postprocessors and early stopping from the config.
+     *
+     * @param relax_mod_ir Relax module IR string
+     * @param target_name Target name
+     * @param config Tuning configuration
+     * @param work_dir Directory for tuning database
+     * @return Tuning results as map
+     */
+    static std::map<std::string, std::string> tune_with_metaschedule(
+        const std::string& relax_mod_ir,
+        const std::string& target_name,
+        const TuningConfig& config,
         const std::string& work_dir = "tuning_database"
     );
 
+    /**
+     * @brief Resume tuning from the existing database in work_dir
+     *
+     * Skips tasks that already reach target_trials_per_task records or have
+     * converged, and spends num_trials only on the remaining tasks.
+     *
+     * @param relax_mod_ir Relax module IR string
+     * @param target_name Target name
+     * @param num_trials Maximum number of new trials for this run
+     * @param target_trials_per_task Trials after which a task counts as tuned
+     * @param max_workers Number of parallel workers (0 = auto)
+     * @param work_dir Directory of the tuning database to resume
+     * @param convergence_window Recent records checked for improvement (0 disables)
+     * @param convergence_tol Relative improvement below which a task has converged
+     * @param pipeline Relax pipeline (must match the one used to compile)
+     * @return Tuning results as map (skipped_tasks, tuned_tasks, new_records, ...)
+     */
+    static std::map<std::string, std::string> tune_incremental(
+        const std::string& relax_mod_ir,
+        const std::string& target_name = "llvm",
+        int num_trials = 64,
+        int target_trials_per_task = 64,
+        int max_workers = 0,
+        const std::string& work_dir = "tuning_database",
+        int convergence_window = 32,
+        double convergence_tol = 0.01,
+        const RelaxPipelineConfig& pipeline = {}
+    );
+
+    /**
+     * @brief Tune seeded from the nearest records of existing databases
+     *
+     * Records of the same workload on another target, or of the same
+     * operator at the closest shape, are replayed and measured as seeds of
+     * the initial population, and the cost model is pre-trained on them.
+     *
+     * @param relax_mod_ir Relax module IR JSON
+     * @param target_name Target name
+     * @param config Source databases, seeds per task and comparison options
+     * @param num_trials Total trials including seed measurements
+     * @param max_workers Number of parallel workers (0 = auto)
+     * @param work_dir Database of the new run; must be empty or missing (cold run: <work_dir>_cold, recreated)
+     * @param pipeline Relax pipeline (default: "zero")
+     * @return Per-task seeds and convergence with (and optionally without) transfer
+     */
+    static WarmStartReport tune_with_warm_start(
+        const std::string& relax_mod_ir,
+        const std::string& target_name,
+        const WarmStartConfig& config,
+        int num_trials = 64,
+        int max_workers = 0,
+        const std::string& work_dir = "tuning_database_warm",
+        const RelaxPipelineConfig& pipeline = {}
+    );
+
+    /**
+     * @brief Tune with trials allocated by profiled latency share
+     *
+     * Each round profiles the module with the records tuned so far and
+     * splits the round's trials across tasks in proportion to their share
+     * of end-to-end latency.
+     *
+     * @param relax_mod_ir Relax module IR string
+     * @param target_name Target name
+     * @param num_trials Total trials across all rounds
+     * @param num_rounds Number of profile/tune rounds
+     * @param min_trials_per_task Trials every task gets in the first round
+     * @param max_workers Number of parallel workers (0 = auto)
+     * @param work_dir Directory for tuning database
+     * @param pipeline Relax pipeline (default: "zero"); must match the one used to compile
+     * @return Tuning results as map (initial/final latency, allocation)
+     */
+    static std::map<std::string, std::string> tune_with_budget_allocation(
+        const std::string& relax_mod_ir,
+        const std::string& target_name = "llvm",
+        int num_trials = 64,
+        int num_rounds = 3,
+        int min_trials_per_task = 0,
+        int max_workers = 0,
+        const std::string& work_dir = "tuning_database",
+        const RelaxPipelineConfig& pipeline = {}
+    );
+
     /**
      * @brief Apply tuning database and build
      * @param relax_mod_ir Relax module IR string
      * @param target_name Target name
      * @param work_dir Directory containing tuning database
      * @param opt_level Optimization level (0-3)
+     * @param timings Filled with per-phase timings (optional)
+     * @param trace_path Write phase timings as a Chrome trace to this path (optional)
+     * @param rank_by "mean": the record with the lowest mean, fetched through the
+     *        database index; "upper_ci": per workload the
+     *        record with the lowest upper confidence bound of its repeats
      * @return Build results as map
      */
     static std::map<std::string, std::string> apply_tuning_database(
         const std::string& relax_mod_ir,
         const std::string& target_name = "llvm",
         const std::string& work_dir = "tuning_database",
-        int opt_level = 0
+        int opt_level = 0,
+        PipelineTimings* timings = nullptr,
+        const std::string& trace_path = "",
+        const std::string& rank_by = "mean"
+    );
+
+    /**
+     * @brief Detect host microarchitecture and ISA extensions
+     * @return CPU information as map (mcpu, triple, features, vector_width_bits, target)
+     */
+    static std::map<std::string, std::string> detect_host_cpu();
+
+    /**
+     * @brief Build one library per CPU variant for runtime selection
+     * @param relax_mod_ir Relax module IR string
+     * @param variants LLVM CPU names (e.g., "haswell", "cascadelake"; empty = the host architecture's known variants)
+     * @param work_dir Directory containing tuning database and output libraries
+     * @param opt_level Optimization level (0-3)
+     * @param pipeline Relax pipeline (default: "zero"); must match the one used to tune
+     * @return Build results as map (manifest_path, variants, lib_paths)
+     */
+    static std::map<std::string, std::string> build_cpu_variants(
+        const std::string& relax_mod_ir,
+        const std::vector<std::string>& variants = {},
+        const std::string& work_dir = "tuning_database",
+        int opt_level = 0,
+        const RelaxPipelineConfig& pipeline = {}
+    );
+
+    /**
+     * @brief Select the library variant matching the running CPU
+     * @param work_dir Directory containing the variant manifest
+     * @return Selected variant as map (mcpu, lib_path, target)
+     */
+    static std::map<std::string, std::string> select_cpu_variant(
+        const std::string& work_dir = "tuning_database"
+    );
+
+    /**
+     * @brief Describe the CPUs available to this process
+     * @return Topology as map (cpus, num_numa_nodes, numa_node_<id> cpus, big_cores, little_cores)
+     */
+    static std::map<std::string, std::string> get_cpu_topology();
+
+    /**
+     * @brief Configure the TVM runtime thread pool of this process
+     *
+     * Also sets TVM_NUM_THREADS for spawned builder/RPC processes, and makes
+     * bare "llvm" targets use num_threads for -num-cores. The wait policy
+     * only takes effect if set before the runtime first runs parallel code.
+     *
+     * @param config Worker count, core placement, NUMA node and wait policy
+     * @return Applied configuration as map (status, num_threads, cpus, ...)
+     */
+    static std::map<std::string, std::string> configure_runtime(const RuntimeConfig& config);
+
+    /**
+     * @brief Return the runtime thread pool to TVM's defaults and restore the
+     *        calling thread's affinity if configure_runtime pinned it to a NUMA node
+     */
+    static void reset_runtime();
+
+    /**
+     * @brief Measure inference latency over thread counts and NUMA placements
+     * @param relax_mod_ir Relax module IR string
+     * @param target_name Target name
+     * @param thread_counts Thread counts to run (empty = powers of two up to the CPU count)
+     * @param num_runs Timed runs per configuration
+     * @param pipeline Relax pipeline (default: "zero")
+     * @return Latency, speedup and efficiency per thread count and placement
+     */
+    static ThreadScalingReport benchmark_thread_scaling(
+        const std::string& relax_mod_ir,
+        const std::string& target_name = "llvm",
+        const std::vector<int>& thread_counts = {},
+        int num_runs = 20,
+        const RelaxPipelineConfig& pipeline = {}
+    );
+
+    /**
+     * @brief Build and profile a Relax module per operator
+     *
+     * Runs the module under the Relax VM profiler and links each kernel
+     * to its MetaSchedule workload in the tuning database.
+     *
+     * @param relax_mod_ir Relax module IR string
+     * @param target_name Target name
+     * @param work_dir Directory containing tuning database
+     * @param use_database Apply tuning records before building
+     * @param num_runs Number of profiled runs to average over
+     * @param opt_level Optimization level (0-3)
+     * @param pipeline Relax pipeline (default: "zero"); must match the one used to tune
+     * @return Per-operator profiling report
+     */
+    static ProfileReport profile_relax_module(
+        const std::string& relax_mod_ir,
+        const std::string& target_name = "llvm",
+        const std::string& work_dir = "tuning_database",
+        bool use_database = true,
+        int num_runs = 5,
+        int opt_level = 0,
+        const RelaxPipelineConfig& pipeline = {}
+    );
+
+    /**
+     * @brief Build with parameters as function inputs and save them separately
+     *
+     * The main function must carry its weights in the "params" attribute
+     * (PyTorch frontend with keep_params_as_input=True). The output directory
+     * is loaded by ExecutorPool, which shares one copy of the weights.
+     *
+     * @param relax_mod_ir Relax module IR string
+     * @param target_name Target name
+     * @param work_dir Output directory (library, parameters, manifest)
+     * @param opt_level Optimization level (0-3)
+     * @param pipeline Relax pipeline (default: "zero")
+     * @return Export results as map (lib_path, params_path, num_params, param_bytes)
+     */
+    static std::map<std::string, std::string> export_with_params_as_input(
+        const std::string& relax_mod_ir,
+        const std::string& target_name = "llvm",
+        const std::string& work_dir = "shared_weights",
+        int opt_level = 0,
+        const RelaxPipelineConfig& pipeline = {}
     );
 
 private:
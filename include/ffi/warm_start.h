@@ -0,0 +1,73 @@
+#ifndef TVM_WARM_START_H
+#define TVM_WARM_START_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tvm_sdk {
+namespace ffi {
+
+/**
+ * @brief Sources and options of a warm-started tuning run
+ */
+struct WarmStartConfig {
+    std::vector<std::string> source_work_dirs;  ///< Databases of other shapes and/or related targets
+    int seeds_per_task = 4;                     ///< Source records replayed and measured per task
+    bool pretrain_cost_model = true;            ///< Pre-train the cost model on seeds and source records
+    bool compare = false;                       ///< Also tune from scratch on the same budget
+    double tolerance = 0.05;                    ///< Distance to the cold final latency counted as converged
+};
+
+/**
+ * @brief Seeds transferred to one task
+ */
+struct TaskSeedReport {
+    std::string task_name;
+    int weight = 0;
+    std::string match;                  ///< "same_workload", "same_op" or "none"
+    double shape_distance = -1.0;       ///< Sum of |log2| dimension ratios to the source workload
+    std::string source_target;
+    int num_seeds = 0;                  ///< Source traces that applied to the task
+    int num_valid_seeds = 0;            ///< Seeds that built and ran on the new target
+    double best_seed_us = -1.0;
+};
+
+/**
+ * @brief Convergence of one tuning run
+ */
+struct ConvergenceReport {
+    std::string work_dir;
+    int64_t num_records = 0;
+    double seed_secs = 0.0;             ///< Wall time replaying and measuring seeds and pre-training
+    double tune_secs = 0.0;             ///< Wall time of the search
+    double final_ms = -1.0;             ///< Sum over tasks of weight * best latency
+    int trials_to_target = -1;          ///< Trials to come within tolerance of the cold final (-1 = never)
+    std::vector<int> trials;            ///< Curve: trial counts ...
+    std::vector<double> total_ms;       ///< ... and weighted latency after them
+};
+
+/**
+ * @brief Result of TVMFFI::tune_with_warm_start
+ */
+struct WarmStartReport {
+    std::string status;
+    std::string error;
+    std::string target;
+    std::string work_dir;
+    int num_tasks = 0;
+    int64_t num_source_records = 0;
+    int num_seed_trials = 0;
+    int num_valid_seeds = 0;
+    int pretrain_samples = 0;
+    std::vector<TaskSeedReport> tasks;
+    ConvergenceReport warm;
+    bool compared = false;
+    ConvergenceReport cold;             ///< Valid with compared
+    int trials_saved = 0;               ///< cold - warm trials_to_target
+};
+
+} // namespace ffi
+} // namespace tvm_sdk
+
+#endif // TVM_WARM_START_H
@@ -0,0 +1,297 @@
+#ifndef TVM_PIPELINE_H
+#define TVM_PIPELINE_H
+
+#include "python_hook.h"
+#include <any>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tvm_sdk {
+
+/**
+ * @brief Bounded lock-free multi-producer multi-consumer queue
+ *
+ * Ring of cells with per-cell sequence numbers: producers and consumers
+ * claim positions with a CAS and never take a lock. The capacity is rounded
+ * up to a power of two. try_push fails when the queue is full, which is how
+ * back-pressure reaches upstream stages.
+ */
+template<typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) {
+        size_t rounded = 2;
+        while (rounded < capacity) {
+            rounded *= 2;
+        }
+        mask_ = rounded - 1;
+        cells_.reset(new Cell[rounded]);
+        for (size_t i = 0; i < rounded; i++) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /**
+     * @brief Enqueue without blocking
+     * @return false if the queue is full (value is left untouched)
+     */
+    bool try_push(T& value) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Dequeue without blocking
+     * @return false if the queue is empty
+     */
+    bool try_pop(T& value) {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    value = std::move(cell.value);
+                    cell.value = T();
+                    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Mark that no more items will be pushed
+     */
+    void close() { closed_.store(true, std::memory_order_release); }
+    bool closed() const { return closed_.load(std::memory_order_acquire); }
+
+    size_t capacity() const { return mask_ + 1; }
+
+    /**
+     * @brief Number of queued items (approximate under concurrency)
+     */
+    size_t size() const {
+        size_t head = dequeue_pos_.load(std::memory_order_relaxed);
+        size_t tail = enqueue_pos_.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<size_t> dequeue_pos_{0};
+    std::atomic<bool> closed_{false};
+};
+
+/**
+ * @brief Stage function: transforms one item; an empty result drops the item
+ */
+using StageFn = std::function<std::any(std::any)>;
+
+/**
+ * @brief Python object carried between stages
+ *
+ * Copies only touch the shared_ptr reference count, so items move between
+ * native threads without the GIL; the object is released under the GIL.
+ */
+using PyItem = std::shared_ptr<py::object>;
+
+/**
+ * @brief Wrap a Python object as a pipeline item (call with the GIL held)
+ */
+PyItem make_py_item(py::object object);
+
+/**
+ * @brief Per-stage counters
+ */
+struct StageStats {
+    std::string name;
+    int num_workers = 0;
+    uint64_t items = 0;             ///< Items processed
+    uint64_t dropped = 0;           ///< Items not passed on (empty result or error)
+    uint64_t errors = 0;            ///< Items whose stage function threw
+    double busy_ms = 0.0;           ///< Time in the stage function, all workers
+    double starved_ms = 0.0;        ///< Time waiting for input, all workers
+    double blocked_ms = 0.0;        ///< Time waiting for space downstream (back-pressure)
+    double mean_ms = 0.0;           ///< Mean stage function time per item
+    double utilization = 0.0;       ///< busy / (elapsed * workers)
+    size_t queue_depth = 0;         ///< Items waiting in the stage's input queue
+    size_t queue_capacity = 0;
+};
+
+/**
+ * @brief Multi-stage pipeline with one thread (or pool) per stage
+ *
+ * Stages are connected by bounded lock-free queues. A full queue blocks the
+ * stage feeding it, so a slow stage throttles everything upstream instead of
+ * letting queues grow, and steady-state throughput approaches that of the
+ * slowest stage. Give slow stages more workers to balance the pipeline;
+ * stages with several workers may reorder items (use the sequence numbers
+ * returned by next() to restore order).
+ *
+ * Native stages run without the GIL. Python stages acquire it per item, so
+ * a thread that holds the GIL (e.g., the one that initialized Python) must
+ * release it (py::gil_scoped_release) while the pipeline runs.
+ *
+ * Usage:
+ *     Pipeline pipeline(8);
+ *     pipeline.add_python_stage("preprocess", "tvm_ext.pipeline_stages", "create_preprocess_stage", 2)
+ *             .add_python_stage("infer", "tvm_ext.pipeline_stages", "create_infer_stage", 1, {lib_path})
+ *             .add_stage("postprocess", postprocess_fn);
+ *     pipeline.start();
+ *     // submit() from one thread, next() from another; close() after the last submit
+ */
+class Pipeline {
+public:
+    /**
+     * @param queue_capacity Capacity of each inter-stage queue
+     */
+    explicit Pipeline(size_t queue_capacity = 16);
+    ~Pipeline();
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    /**
+     * @brief Append a native stage
+     * @param name Stage name (stats and trace events)
+     * @param fn Stage function, shared by all workers (must be thread-safe)
+     * @param num_workers Worker threads for this stage
+     */
+    Pipeline& add_stage(const std::string& name, StageFn fn, int num_workers = 1);
+
+    /**
+     * @brief Append a Python stage with one callable per worker
+     *
+     * Calls module_path.factory(*args) once per worker to create its
+     * callable, so stateful stages (e.g., a bound inference session) get one
+     * instance each. Callables receive a Python object (PyItem items as-is;
+     * std::string, int64_t, double and std::vector<float> items converted)
+     * and return a Python object, or None to drop the item.
+     */
+    Pipeline& add_python_stage(
+        const std::string& name,
+        const std::string& module_path,
+        const std::string& factory,
+        int num_workers = 1,
+        const std::vector<std::string>& args = {}
+    );
+
+    /**
+     * @brief Append a Python stage calling one callable from every worker
+     */
+    Pipeline& add_python_stage(const std::string& name, py::object callable, int num_workers = 1);
+
+    /**
+     * @brief Start the stage threads
+     */
+    void start();
+
+    /**
+     * @brief Feed an item, blocking while the first queue is full
+     * @return Sequence number, or -1 if the pipeline is closed
+     */
+    int64_t submit(std::any item);
+
+    /**
+     * @brief Feed an item if the first queue has space
+     * @return Sequence number, -1 if the queue is full or the pipeline closed
+     */
+    int64_t try_submit(std::any item);
+
+    /**
+     * @brief Take the next finished item, blocking until one is available
+     * @param item Output item
+     * @param sequence Sequence number given by submit() (optional)
+     * @return false once the pipeline is closed and drained
+     */
+    bool next(std::any* item, int64_t* sequence = nullptr);
+
+    /**
+     * @brief Signal that no more items will be submitted; stages drain and stop
+     */
+    void close();
+
+    /**
+     * @brief Cancel pending items and join all stage threads
+     */
+    void stop();
+
+    /**
+     * @brief Per-stage statistics (safe to call while running)
+     */
+    std::vector<StageStats> stats() const;
+
+    /**
+     * @brief First error raised by a stage function (empty if none)
+     */
+    std::string first_error() const;
+
+    size_t num_stages() const;
+
+private:
+    struct Stage;
+    struct Item {
+        int64_t sequence = -1;
+        std::any value;
+    };
+    using Queue = BoundedQueue<Item>;
+
+    bool push(Queue& queue, Item& item, std::atomic<uint64_t>* wait_ns);
+    bool pop(Queue& queue, Item& item, std::atomic<uint64_t>* wait_ns);
+    void run_worker(size_t stage_index, size_t worker);
+    Pipeline& append(std::unique_ptr<Stage> stage);
+
+    size_t queue_capacity_;
+    std::vector<std::unique_ptr<Queue>> queues_;   ///< queues_[i] feeds stage i; the last one is the output
+    std::vector<std::unique_ptr<Stage>> stages_;
+    std::vector<std::thread> threads_;
+    std::atomic<int64_t> next_sequence_{0};
+    std::atomic<bool> cancelled_{false};
+    bool started_ = false;
+    std::chrono::steady_clock::time_point start_time_;
+    mutable std::mutex error_mutex_;
+    std::string first_error_;
+};
+
+} // namespace tvm_sdk
+
+#endif // TVM_PIPELINE_H
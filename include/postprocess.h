@@ -0,0 +1,104 @@
+#ifndef TVM_POSTPROCESS_H
+#define TVM_POSTPROCESS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tvm_sdk {
+
+namespace ffi {
+class TensorBuffer;
+}
+
+/**
+ * @brief One selected class
+ */
+struct Prediction {
+    int64_t class_id = -1;
+    float score = 0.0f;     ///< Probability (classify) or input score (top_k)
+};
+
+/**
+ * @brief Native classification postprocessing over batched logits
+ *
+ * All functions take row-major [batch, num_classes] float32 data, e.g.
+ * straight from a bound output buffer, and do not allocate (except the
+ * vector-returning convenience overloads). Softmax is computed stably as
+ * exp(x - max) / sum; reductions use independent lane accumulators and a
+ * branch-free exp so the compiler vectorizes them. Top-k uses a k-element
+ * heap (partial selection) instead of sorting all classes.
+ */
+class Postprocess {
+public:
+    /**
+     * @brief Row-wise softmax
+     * @param logits Input [batch, num_classes]
+     * @param probs Output [batch, num_classes] (may alias logits)
+     * @throws std::invalid_argument if num_classes is 0
+     */
+    static void softmax(const float* logits, float* probs, size_t batch, size_t num_classes);
+
+    /**
+     * @brief Row-wise log-softmax: x - max - log(sum(exp(x - max)))
+     * @throws std::invalid_argument if num_classes is 0
+     */
+    static void log_softmax(const float* logits, float* out, size_t batch, size_t num_classes);
+
+    /**
+     * @brief Row-wise top-k by score, highest first (ties: lower class id first)
+     * @param out Output [batch, k]
+     */
+    static void top_k(const float* scores, size_t batch, size_t num_classes, size_t k, Prediction* out);
+
+    /**
+     * @brief Top-k classes with softmax probabilities, without materializing the full softmax
+     * @param out Output [batch, k]
+     */
+    static void classify(const float* logits, size_t batch, size_t num_classes, size_t k, Prediction* out);
+
+    /**
+     * @brief classify() returning one vector per batch row
+     */
+    static std::vector<std::vector<Prediction>> classify(
+        const float* logits, size_t batch, size_t num_classes, size_t k);
+
+    /**
+     * @brief classify() over a float32 [batch, num_classes] (or [num_classes]) buffer
+     */
+    static std::vector<std::vector<Prediction>> classify(const ffi::TensorBuffer& logits, size_t k);
+};
+
+/**
+ * @brief Class id to label mapping, loaded once
+ */
+class LabelMap {
+public:
+    explicit LabelMap(std::vector<std::string> labels);
+
+    /**
+     * @brief Load labels from a text file with one label per line
+     * @throws std::runtime_error if the file cannot be read
+     */
+    static LabelMap from_file(const std::string& path);
+
+    /**
+     * @brief ImageNet-1k labels (from torchvision, loaded on first use)
+     */
+    static const LabelMap& imagenet();
+
+    /**
+     * @brief Label of a class id ("" if out of range)
+     */
+    const std::string& operator[](int64_t class_id) const;
+
+    size_t size() const { return labels_.size(); }
+
+private:
+    std::vector<std::string> labels_;
+};
+
+} // namespace tvm_sdk
+
+#endif // TVM_POSTPROCESS_H
@@ -2,6 +2,7 @@
 #define TVM_PYTHON_HOOK_H
 
 #include <pybind11/pybind11.h>
+#include "trace.h"
 #include <string>
 
 namespace py = pybind11;
@@ -57,7 +58,14 @@ public:
         Args&&... args
     ) {
         initialize();
+        TraceScope scope("python", module_name.c_str(), function_name.c_str());
+
+        // Record the time spent waiting for the GIL
+        const double gil_wait_start = Tracer::is_enabled() ? Tracer::now_us() : -1.0;
         py::gil_scoped_acquire gil;
+        if (gil_wait_start >= 0.0) {
+            Tracer::record("python_hook", "gil_wait", gil_wait_start, Tracer::now_us() - gil_wait_start);
+        }
 
         try {
             py::object module = import_module(module_name);
@@ -0,0 +1,142 @@
+#ifndef TVM_SDK_TRACE_H
+#define TVM_SDK_TRACE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace tvm_sdk {
+
+/**
+ * @brief Tracing configuration
+ */
+struct TraceConfig {
+    size_t buffer_capacity = 65536;  ///< Events per thread buffer
+    bool ring_buffer = false;        ///< Overwrite oldest events when full (always-on mode)
+    uint32_t sample_every = 1;       ///< Record one of every N scopes per thread (1 = all)
+    bool trace_python = false;       ///< Also trace Python functions in tvm_ext/torch_ext
+};
+
+/**
+ * @brief Process-wide event tracer writing Chrome trace (chrome://tracing, Perfetto) JSON
+ *
+ * Each thread writes into its own fixed-size event buffer without locking;
+ * the registry mutex is taken only when a thread records its first event
+ * and on flush. Python code records into the same buffers through the
+ * embedded `_tvm_sdk_trace` module. While tracing is stopped, a scope costs
+ * a single relaxed atomic load.
+ */
+class Tracer {
+public:
+    /**
+     * @brief Start tracing, discarding previously recorded events
+     * @param config Tracing configuration
+     */
+    static void start(const TraceConfig& config = TraceConfig());
+
+    /**
+     * @brief Stop tracing; recorded events are kept until the next start()
+     */
+    static void stop();
+
+    /**
+     * @brief Check if tracing is enabled
+     */
+    static bool is_enabled() {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Microseconds since the tracer's clock origin
+     */
+    static double now_us();
+
+    /**
+     * @brief Record a complete ("X") event on the calling thread
+     * @param category Event category (e.g., "sdk", "python", "kernel")
+     * @param name Event name
+     * @param start_us Start time from now_us()
+     * @param dur_us Duration in microseconds
+     */
+    static void record(const char* category, const char* name, double start_us, double dur_us) {
+        record(category, name, nullptr, start_us, dur_us);
+    }
+
+    /**
+     * @brief Record a complete event named "name.detail" on the calling thread
+     */
+    static void record(const char* category, const char* name, const char* detail,
+                       double start_us, double dur_us);
+
+    /**
+     * @brief Write all recorded events as Chrome trace JSON
+     * @param path Output file path
+     * @return Number of events written
+     */
+    static size_t flush(const std::string& path);
+
+    /**
+     * @brief Get all recorded events as Chrome trace JSON
+     */
+    static std::string to_json();
+
+    /**
+     * @brief Number of events dropped because a buffer was full (non-ring mode)
+     */
+    static uint64_t dropped_events();
+
+    /**
+     * @brief Check whether the calling thread should record its next scope
+     *
+     * Implements TraceConfig::sample_every with a per-thread counter.
+     */
+    static bool sample();
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+/**
+ * @brief RAII scope recording a complete event from construction to destruction
+ *
+ * The name is "name" or "name.detail" when detail is given; both strings
+ * must outlive the scope.
+ */
+class TraceScope {
+public:
+    TraceScope(const char* category, const char* name, const char* detail = nullptr) {
+        if (Tracer::is_enabled() && Tracer::sample()) {
+            category_ = category;
+            name_ = name;
+            detail_ = detail;
+            start_us_ = Tracer::now_us();
+        }
+    }
+
+    ~TraceScope() {
+        if (name_ != nullptr) {
+            Tracer::record(category_, name_, detail_, start_us_, Tracer::now_us() - start_us_);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* category_ = nullptr;
+    const char* name_ = nullptr;
+    const char* detail_ = nullptr;
+    double start_us_ = 0.0;
+};
+
+} // namespace tvm_sdk
+
+#define TVM_SDK_TRACE_CONCAT_(a, b) a##b
+#define TVM_SDK_TRACE_CONCAT(a, b) TVM_SDK_TRACE_CONCAT_(a, b)
+
+/// Trace the enclosing C++ scope under the "sdk" category
+#define TVM_SDK_TRACE_SCOPE(name) \
+    ::tvm_sdk::TraceScope TVM_SDK_TRACE_CONCAT(tvm_sdk_trace_scope_, __LINE__)("sdk", name)
+
+#endif // TVM_SDK_TRACE_H
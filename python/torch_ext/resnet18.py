@@ -143,18 +143,34 @@ def get_scripted_model():
     return scripted_model
 
 
-def save_model_state(output_path='resnet18_state.pth'):
+def save_model_state(output_path='resnet18_state.pth', format='state_dict'):
     """
     Save model state dict
 
     Args:
         output_path (str): Path to save state dict
+        format (str): 'state_dict' (torch.save) or 'sdk' (memory-mappable
+            SDK parameter file, see tvm_ext.param_file)
 
     Returns:
         dict: Save status information
     """
     try:
         model = load_resnet18(pretrained=True)
+
+        if format == 'sdk':
+            from tvm_ext.param_file import save_param_file
+            info = save_param_file(output_path, model.state_dict())
+            return {
+                'status': 'success',
+                'output_path': output_path,
+                'format': 'sdk',
+                'num_tensors': info['num_tensors'],
+                'file_size': info['file_size']
+            }
+        if format != 'state_dict':
+            raise ValueError(f"Unknown format '{format}' (expected 'state_dict' or 'sdk')")
+
         torch.save(model.state_dict(), output_path)
 
         return {
@@ -21,17 +21,227 @@ from .metaschedule import (
     tune_with_metaschedule,
     apply_tuning_database,
     compile_with_metaschedule,
+    tune_incremental,
     create_simple_relax_ir,
     get_metaschedule_config,
     check_tuning_database
 )
 
+# Import from relax_pipeline module
+from .relax_pipeline import (
+    RELAX_PASSES,
+    PIPELINE_PRESETS,
+    resolve_pipeline,
+    static_memory_planning,
+    ir_stats,
+    run_relax_pipeline,
+    get_relax_pipeline_presets,
+    compare_relax_pipelines
+)
+
+# Import from memory_plan module
+from .memory_plan import (
+    plan_memory,
+    analyze_memory_plan,
+    check_runtime_memory,
+    memory_plan_report
+)
+
+# Import from models module
+from .models import (
+    load_torchvision_model,
+    normalize_input_specs,
+    symbolic_dims,
+    import_fx_model,
+    create_model_relax_ir,
+    tune_models
+)
+
+# Import from dynamic_shape module
+from .dynamic_shape import (
+    symbolic_vars,
+    shape_function_name,
+    specialize_function,
+    input_shapes,
+    count_dynamic_kernels,
+    select_shape_function,
+    compile_dynamic
+)
+
+# Import from warm_start module
+from .warm_start import (
+    block_signature,
+    shape_distance,
+    load_source_records,
+    find_seed_records,
+    replay_trace,
+    convergence_curve,
+    trials_to_reach,
+    tune_with_warm_start
+)
+
 # Import from resnet_schedule module
 from .resnet_schedule import (
+    create_resnet18_relax_mod,
     create_resnet18_relax_ir,
     tune_resnet18_with_metaschedule
 )
 
+# Import from target module
+from .target import (
+    detect_host_cpu,
+    build_llvm_target_string,
+    create_target,
+    build_cpu_variants,
+    select_cpu_variant,
+    load_cpu_variant
+)
+
+# Import from database module
+from .database import (
+    workload_stats,
+    normalize_shash,
+    merge_tuning_databases,
+    compact_tuning_database,
+    build_database_index,
+    lookup_best_record,
+    indexed_database,
+    confidence_interval,
+    record_confidence_interval,
+    select_by_confidence
+)
+
+# Import from rpc_farm module
+from .rpc_farm import (
+    LocalRPCFarm,
+    partition_cores
+)
+
+# Import from runtime_config module
+from .runtime_config import (
+    cpu_topology,
+    default_num_threads,
+    configure_runtime,
+    reset_runtime,
+    runtime_config,
+    localize_tensors,
+    benchmark_thread_scaling
+)
+
+# Import from tuning_config module
+from .tuning_config import (
+    create_cost_model,
+    create_search_strategy,
+    create_space_generator,
+    create_early_stopping,
+    tune_with_config
+)
+
+# Import from adaptive_runner module
+from .adaptive_runner import (
+    MEASUREMENT_MODES,
+    create_runner,
+    create_adaptive_runner
+)
+
+# Import from budget module
+from .budget import (
+    allocate_trials,
+    tune_with_budget_allocation
+)
+
+# Import from timing module
+from .timing import (
+    PhaseTimer,
+    count_tuning_tasks
+)
+
+# Import from inference module
+from .inference import (
+    InferenceSession,
+    create_inference_session,
+    to_destination_passing
+)
+
+# Import from executor_pool module
+from .executor_pool import (
+    export_with_params_as_input,
+    load_shared_params,
+    ExecutorPool,
+    create_executor_pool
+)
+
+# Import from pipeline_stages module
+from .pipeline_stages import (
+    create_preprocess_stage,
+    create_infer_stage,
+    create_postprocess_stage
+)
+
+# Import from postprocess module
+from .postprocess import (
+    softmax,
+    log_softmax,
+    top_k,
+    classify,
+    imagenet_labels,
+    has_native_postprocess
+)
+
+# Import from param_file module
+from .param_file import (
+    save_param_file,
+    read_param_index,
+    load_param_file,
+    load_param_tensors
+)
+
+# Import from quantize module
+from .quantize import (
+    find_quantizable_layers,
+    load_calibration_images,
+    calibrate_relax_module,
+    quantize_relax_module,
+    quantize_with_metaschedule
+)
+
+# Import from mixed_precision module
+from .mixed_precision import (
+    to_mixed_precision,
+    weight_bytes,
+    compare_mixed_precision
+)
+
+# Import from layout module
+from .layout import (
+    default_block_size,
+    pack_conv_layout,
+    compare_layout_packing
+)
+
+# Import from byoc module
+from .byoc import (
+    dnnl_available,
+    dnnl_patterns,
+    partition_for_dnnl,
+    benchmark_backends
+)
+
+# Import from tracing module
+from .tracing import (
+    trace_scope,
+    traced,
+    install_profile_hook,
+    uninstall_profile_hook,
+    trace_vm_kernels
+)
+
+# Import from profiling module
+from .profiling import (
+    profile_module,
+    profile_relax_module
+)
+
 # Expose all functions
 __all__ = [
     # Version
@@ -45,10 +255,148 @@ __all__ = [
     'tune_with_metaschedule',
     'apply_tuning_database',
     'compile_with_metaschedule',
+    'tune_incremental',
     'create_simple_relax_ir',
     'get_metaschedule_config',
     'check_tuning_database',
+    # Relax Pipeline
+    'RELAX_PASSES',
+    'PIPELINE_PRESETS',
+    'resolve_pipeline',
+    'static_memory_planning',
+    'ir_stats',
+    'run_relax_pipeline',
+    'get_relax_pipeline_presets',
+    'compare_relax_pipelines',
+    # Memory Plan
+    'plan_memory',
+    'analyze_memory_plan',
+    'check_runtime_memory',
+    'memory_plan_report',
+    # Models
+    'load_torchvision_model',
+    'normalize_input_specs',
+    'symbolic_dims',
+    'import_fx_model',
+    'create_model_relax_ir',
+    'tune_models',
+    # Dynamic Shape
+    'symbolic_vars',
+    'shape_function_name',
+    'specialize_function',
+    'input_shapes',
+    'count_dynamic_kernels',
+    'select_shape_function',
+    'compile_dynamic',
+    # Warm Start
+    'block_signature',
+    'shape_distance',
+    'load_source_records',
+    'find_seed_records',
+    'replay_trace',
+    'convergence_curve',
+    'trials_to_reach',
+    'tune_with_warm_start',
     # ResNet Schedule
+    'create_resnet18_relax_mod',
     'create_resnet18_relax_ir',
-    'tune_resnet18_with_metaschedule'
+    'tune_resnet18_with_metaschedule',
+    # Target
+    'detect_host_cpu',
+    'build_llvm_target_string',
+    'create_target',
+    'build_cpu_variants',
+    'select_cpu_variant',
+    'load_cpu_variant',
+    # Database
+    'workload_stats',
+    'normalize_shash',
+    'merge_tuning_databases',
+    'compact_tuning_database',
+    'build_database_index',
+    'lookup_best_record',
+    'indexed_database',
+    'confidence_interval',
+    'record_confidence_interval',
+    'select_by_confidence',
+    # RPC Farm
+    'LocalRPCFarm',
+    'partition_cores',
+    # Runtime Config
+    'cpu_topology',
+    'default_num_threads',
+    'configure_runtime',
+    'reset_runtime',
+    'runtime_config',
+    'localize_tensors',
+    'benchmark_thread_scaling',
+    # Tuning Config
+    'create_cost_model',
+    'create_search_strategy',
+    'create_space_generator',
+    'create_early_stopping',
+    'tune_with_config',
+    # Adaptive Runner
+    'MEASUREMENT_MODES',
+    'create_runner',
+    'create_adaptive_runner',
+    # Budget Allocation
+    'allocate_trials',
+    'tune_with_budget_allocation',
+    # Timing
+    'PhaseTimer',
+    'count_tuning_tasks',
+    # Inference
+    'InferenceSession',
+    'create_inference_session',
+    'to_destination_passing',
+    # Executor Pool
+    'export_with_params_as_input',
+    'load_shared_params',
+    'ExecutorPool',
+    'create_executor_pool',
+    # Pipeline Stages
+    'create_preprocess_stage',
+    'create_infer_stage',
+    'create_postprocess_stage',
+    # Postprocess
+    'softmax',
+    'log_softmax',
+    'top_k',
+    'classify',
+    'imagenet_labels',
+    'has_native_postprocess',
+    # Param File
+    'save_param_file',
+    'read_param_index',
+    'load_param_file',
+    'load_param_tensors',
+    # Quantization
+    'find_quantizable_layers',
+    'load_calibration_images',
+    'calibrate_relax_module',
+    'quantize_relax_module',
+    'quantize_with_metaschedule',
+    # Mixed Precision
+    'to_mixed_precision',
+    'weight_bytes',
+    'compare_mixed_precision',
+    # Layout
+    'default_block_size',
+    'pack_conv_layout',
+    'compare_layout_packing',
+    # BYOC
+    'dnnl_available',
+    'dnnl_patterns',
+    'partition_for_dnnl',
+    'benchmark_backends',
+    # Tracing
+    'trace_scope',
+    'traced',
+    'install_profile_hook',
+    'uninstall_profile_hook',
+    'trace_vm_kernels',
+    # Profiling
+    'profile_module',
+    'profile_relax_module'
 ]
@@ -0,0 +1,247 @@
+"""
+Adaptive Measurement Repeats for MetaSchedule
+
+A runner that chooses the number of repeats per candidate instead of using
+a fixed count. Each candidate starts with a few repeats; measuring stops
+early once its confidence interval lies entirely above the best candidate
+of the same workload (statistically worse), and continues in steps while
+the intervals overlap (within noise) or the interval is still wider than
+the target precision. Every repeat is stored in the record's run_secs, so
+the confidence interval of a record can be recomputed from the database
+(see database.record_confidence_interval).
+"""
+
+import sys
+import json
+from .database import confidence_interval, normalize_shash
+
+MEASUREMENT_MODES = ("fixed", "adaptive")
+
+
+def _measure_candidate(artifact_path, device_type, args_info_json, best, options):
+    """
+    Measure one built candidate with adaptive repeats (runs in a popen worker).
+
+    Args:
+        best: (mean_secs, half_width_secs) of the best candidate so far, or None
+        options: Runner options (see create_adaptive_runner)
+
+    Returns:
+        tuple: (run_secs samples, stop reason "worse", "precise" or "max_repeats")
+    """
+    import tvm
+    from tvm.meta_schedule.runner.local_runner import default_alloc_argument
+
+    device = tvm.device(device_type, 0)
+    rt_mod = tvm.runtime.load_module(artifact_path)
+    args = default_alloc_argument(device, args_info_json, 1)[0]
+
+    def measure(repeat):
+        evaluator = rt_mod.time_evaluator(
+            rt_mod.entry_name,
+            device,
+            number=1,
+            repeat=repeat,
+            min_repeat_ms=options["min_repeat_ms"],
+            f_preproc="cache_flush_cpu_non_first_arg" if options["enable_cpu_cache_flush"] else "",
+        )
+        return [float(s) for s in evaluator(*args).results]
+
+    samples = measure(options["min_repeats"])
+    while True:
+        mean, half = confidence_interval(samples, options["confidence"])
+        half = half if half is not None else float("inf")
+        if best is not None and mean - half > best[0] + best[1]:
+            return samples, "worse"
+        if len(samples) >= options["max_repeats"]:
+            return samples, "max_repeats"
+        within_noise = best is not None and mean - half <= best[0] + best[1] and mean + half >= best[0] - best[1]
+        if not within_noise and half <= options["target_rel_ci"] * mean:
+            return samples, "precise"
+        samples += measure(min(options["repeat_step"], options["max_repeats"] - len(samples)))
+
+
+def create_runner(measurement=None):
+    """
+    MetaSchedule runner for a measurement configuration.
+
+    Args:
+        measurement: dict with "mode" ("fixed" or "adaptive") and the
+            create_adaptive_runner options
+
+    Returns:
+        "local" for fixed repeats, else an adaptive runner
+    """
+    measurement = dict(measurement or {})
+    mode = measurement.pop("mode", "fixed")
+    if mode not in MEASUREMENT_MODES:
+        raise ValueError(f"Unknown measurement mode: {mode} (expected one of {MEASUREMENT_MODES})")
+    if mode == "fixed":
+        return "local"
+    return create_adaptive_runner(**measurement)
+
+
+def create_adaptive_runner(**options):
+    """
+    Create a MetaSchedule runner with adaptive repeats.
+
+    Options: min_repeats, max_repeats, repeat_step, target_rel_ci (stop once
+    the interval half-width is below this fraction of the mean),
+    confidence, min_repeat_ms, timeout_sec, enable_cpu_cache_flush.
+
+    Returns:
+        ms.runner.PyRunner with close(), summary() and measure_callback()
+        (pass it to tune_tasks so candidates are compared per workload)
+    """
+    import tvm.meta_schedule as ms
+    from tvm.contrib.popen_pool import PopenPoolExecutor
+    from tvm.meta_schedule.runner.local_runner import LocalRunnerFuture
+
+    @ms.derived_object
+    class AdaptiveRunner(ms.runner.PyRunner):
+        """
+        Runner with statistical stopping per candidate.
+
+        Candidates are measured one at a time in a popen worker, so a
+        crashing kernel only fails its own candidate. A candidate is
+        compared with the best one of its workload: the earlier candidates
+        of the same batch (one batch holds one task) and, once the measure
+        callback has attributed earlier batches, the best measured for the
+        workload if it is the only one seen with this argument signature.
+        """
+
+        def __init__(
+            self,
+            min_repeats=3,
+            max_repeats=30,
+            repeat_step=3,
+            target_rel_ci=0.02,
+            confidence=0.95,
+            min_repeat_ms=50,
+            timeout_sec=30,
+            enable_cpu_cache_flush=False
+        ):
+            super().__init__()
+            if min_repeats < 2 or max_repeats < min_repeats or repeat_step < 1:
+                raise ValueError("Adaptive measurement needs 2 <= min_repeats <= max_repeats and repeat_step >= 1")
+            self.options = {
+                "min_repeats": int(min_repeats),
+                "max_repeats": int(max_repeats),
+                "repeat_step": int(repeat_step),
+                "target_rel_ci": float(target_rel_ci),
+                "confidence": float(confidence),
+                "min_repeat_ms": int(min_repeat_ms),
+                "enable_cpu_cache_flush": bool(enable_cpu_cache_flush),
+            }
+            self.timeout_sec = timeout_sec
+            self.best = {}          # workload shash -> (mean, half width)
+            self.workloads = {}     # argument signature -> workload shashes
+            self.pending = {}       # artifact path -> (argument signature, mean, half width)
+            self.stats = {"measured": 0, "failed": 0, "total_repeats": 0, "worse": 0, "precise": 0, "max_repeats": 0}
+            self._pool = None
+
+        def _executor(self):
+            if self._pool is None:
+                # Workers cannot import this package; ship _measure_candidate by value
+                import cloudpickle
+
+                cloudpickle.register_pickle_by_value(sys.modules[__package__])
+                self._pool = PopenPoolExecutor(max_workers=1, timeout=self.timeout_sec)
+            return self._pool
+
+        def _reference(self, key, batch_best):
+            references = [batch_best.get(key)]
+            workloads = self.workloads.get(key, ())
+            if len(workloads) == 1:
+                references.append(self.best.get(next(iter(workloads))))
+            references = [ref for ref in references if ref is not None]
+            return min(references) if references else None
+
+        def run(self, runner_inputs):
+            futures = []
+            batch_best = {}
+            for runner_input in runner_inputs:
+                args_info_json = [arg.as_json() for arg in runner_input.args_info]
+                key = json.dumps(args_info_json, sort_keys=True, default=str)
+                try:
+                    samples, reason = self._executor().submit(
+                        _measure_candidate,
+                        runner_input.artifact_path,
+                        runner_input.device_type,
+                        args_info_json,
+                        self._reference(key, batch_best),
+                        self.options,
+                    ).result()
+                except Exception as e:
+                    self.stats["failed"] += 1
+                    futures.append(LocalRunnerFuture(res=None, error_message=str(e)))
+                    continue
+
+                self.stats["measured"] += 1
+                self.stats["total_repeats"] += len(samples)
+                self.stats[reason] += 1
+                mean, half = confidence_interval(samples, self.options["confidence"])
+                if half is not None:
+                    best = batch_best.get(key)
+                    if best is None or mean < best[0]:
+                        batch_best[key] = (mean, half)
+                    self.pending[runner_input.artifact_path] = (key, mean, half)
+                futures.append(LocalRunnerFuture(res=samples, error_message=None))
+            return futures
+
+        def attribute(self, shash, artifact_paths):
+            """
+            File the measured candidates of a batch under their workload.
+            """
+            for path in artifact_paths:
+                if path not in self.pending:
+                    continue
+                key, mean, half = self.pending.pop(path)
+                self.workloads.setdefault(key, set()).add(shash)
+                best = self.best.get(shash)
+                if best is None or mean < best[0]:
+                    self.best[shash] = (mean, half)
+
+        def measure_callback(self):
+            """
+            MeasureCallback telling this runner which workload each batch measured.
+            """
+            import tvm
+
+            runner = self
+
+            @ms.derived_object
+            class AttributeWorkload(ms.measure_callback.PyMeasureCallback):
+                def apply(self, task_scheduler, task_id, measure_candidates, builder_results, runner_results):
+                    shash = normalize_shash(tvm.ir.structural_hash(task_scheduler.tasks_[task_id].ctx.mod))
+                    runner.attribute(shash, [result.artifact_path for result in builder_results])
+
+            return AttributeWorkload()
+
+        def summary(self):
+            """
+            Repeat statistics: measured, failed, total_repeats, mean_repeats,
+            stopped_worse, precise, max_repeats and repeats_saved (vs.
+            max_repeats for every candidate)
+            """
+            measured = self.stats["measured"]
+            return {
+                "measured": measured,
+                "failed": self.stats["failed"],
+                "total_repeats": self.stats["total_repeats"],
+                "mean_repeats": self.stats["total_repeats"] / measured if measured else 0.0,
+                "stopped_worse": self.stats["worse"],
+                "precise": self.stats["precise"],
+                "max_repeats": self.stats["max_repeats"],
+                "repeats_saved": measured * self.options["max_repeats"] - self.stats["total_repeats"],
+            }
+
+        def close(self):
+            if self._pool is not None:
+                import cloudpickle
+
+                self._pool.shutdown()
+                self._pool = None
+                cloudpickle.unregister_pickle_by_value(sys.modules[__package__])
+
+    return AdaptiveRunner(**options)
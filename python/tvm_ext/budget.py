@@ -0,0 +1,258 @@
+"""
+Profile-Guided Tuning Budget Allocation
+
+Splits a MetaSchedule trial budget across tasks in proportion to each
+task's measured share of end-to-end latency, re-profiling between rounds
+so that trials follow the kernels that still dominate after tuning.
+"""
+
+import os
+import tvm
+from tvm import relax
+from .target import create_target
+from .database import normalize_shash, workload_stats
+from .profiling import profile_module
+from .relax_pipeline import run_relax_pipeline
+
+
+def allocate_trials(weights, budget, min_trials=0):
+    """
+    Split a trial budget across tasks in proportion to their weights.
+
+    Every task first gets `min_trials` (as far as the budget allows, highest
+    weight first); the rest is distributed proportionally using the
+    largest-remainder method so the allocation sums exactly to the budget.
+
+    Args:
+        weights: dict task name -> non-negative weight (e.g. latency share)
+        budget: Total number of trials to allocate
+        min_trials: Minimum trials per task
+
+    Returns:
+        dict: task name -> number of trials
+    """
+    names = sorted(weights, key=lambda name: weights[name], reverse=True)
+    allocation = {name: 0 for name in names}
+    remaining = max(0, int(budget))
+
+    for name in names:
+        grant = min(min_trials, remaining)
+        allocation[name] += grant
+        remaining -= grant
+
+    total_weight = sum(max(0.0, weights[name]) for name in names)
+    if remaining <= 0 or total_weight <= 0.0:
+        return allocation
+
+    quotas = {name: remaining * max(0.0, weights[name]) / total_weight for name in names}
+    floors = {name: int(quotas[name]) for name in names}
+    for name in names:
+        allocation[name] += floors[name]
+
+    leftover = remaining - sum(floors.values())
+    for name in sorted(names, key=lambda name: quotas[name] - floors[name], reverse=True)[:leftover]:
+        allocation[name] += 1
+
+    return allocation
+
+
+def _kernel_key(func):
+    # Kernels deduplicated into one task differ only in their global symbol
+    return normalize_shash(tvm.ir.structural_hash(func.without_attr("global_symbol")))
+
+
+def kernel_tasks(relax_mod, extracted_tasks):
+    """
+    Map every kernel (PrimFunc) of a module to the tuning task covering it.
+
+    One task stands for all structurally identical kernels, whatever their
+    names (e.g. fused_conv2d1_add1_relu1 and fused_conv2d2_add2_relu2).
+
+    Returns:
+        dict: kernel name -> task name
+    """
+    task_by_key = {}
+    for task in extracted_tasks:
+        (func,) = task.dispatched[0].functions.values()
+        task_by_key[_kernel_key(func)] = task.task_name
+
+    mapping = {}
+    for gv, func in relax_mod.functions.items():
+        if isinstance(func, tvm.tir.PrimFunc):
+            task_name = task_by_key.get(_kernel_key(func))
+            if task_name is not None:
+                mapping[gv.name_hint] = task_name
+    return mapping
+
+
+def _apply_database(relax_mod, target, work_dir):
+    from tvm.ir.transform import PassContext
+
+    if not workload_stats(work_dir):
+        return relax_mod
+    with target, PassContext(opt_level=0):
+        return relax.transform.MetaScheduleApplyDatabase(work_dir)(relax_mod)
+
+
+def tune_with_budget_allocation_mod(
+    relax_mod,
+    target,
+    num_trials=64,
+    num_rounds=3,
+    min_trials_per_task=0,
+    max_workers=None,
+    work_dir="tuning_database",
+    num_profile_runs=3
+):
+    """
+    Tune a pipelined Relax module with profile-guided per-task budgets.
+
+    Each round builds the module with the records tuned so far, profiles
+    it per operator, and gives the round's share of num_trials to tasks in
+    proportion to their current share of end-to-end latency: the summed
+    time of every kernel the task covers (see kernel_tasks), so a workload
+    called at several places counts with all of its calls.
+
+    Args:
+        relax_mod: Relax IRModule after the zero pipeline
+        target: tvm.target.Target
+        num_trials: Total trials across all rounds
+        num_rounds: Number of profile/tune rounds
+        min_trials_per_task: Trials every task gets in the first round
+        max_workers: Number of parallel builder workers (default: CPU count)
+        work_dir: Directory for the tuning database
+        num_profile_runs: Profiled runs per round
+
+    Returns:
+        dict: Per-round end-to-end latency and per-task trial allocation
+    """
+    import multiprocessing
+    import tvm.meta_schedule as ms
+    from tvm.meta_schedule.builder import LocalBuilder
+
+    os.makedirs(work_dir, exist_ok=True)
+    if not max_workers:
+        max_workers = multiprocessing.cpu_count()
+
+    extracted_tasks = {task.task_name: task for task in ms.relax_integration.extract_tasks(relax_mod, target)}
+    task_of_kernel = kernel_tasks(relax_mod, extracted_tasks.values())
+    num_rounds = max(1, int(num_rounds))
+    total_allocation = {name: 0 for name in extracted_tasks}
+    round_latency_us = []
+
+    for round_index in range(num_rounds):
+        # Profile the module with the records tuned so far
+        e2e_us, totals = profile_module(_apply_database(relax_mod, target, work_dir), target, num_profile_runs)
+        round_latency_us.append(e2e_us)
+
+        weights = {name: 0.0 for name in extracted_tasks}
+        for kernel, entry in totals.items():
+            task_name = task_of_kernel.get(kernel)
+            if task_name is not None:
+                weights[task_name] += entry["total_us"]
+
+        round_budget = (num_trials - sum(total_allocation.values())) // (num_rounds - round_index)
+        min_trials = min_trials_per_task if round_index == 0 else 0
+        allocation = allocate_trials(weights, round_budget, min_trials)
+
+        for name, trials in allocation.items():
+            if trials <= 0:
+                continue
+            tasks, task_weights = ms.relax_integration.extracted_tasks_to_tune_contexts(
+                extracted_tasks=[extracted_tasks[name]],
+                work_dir=work_dir,
+                num_tuning_cores=max_workers,
+            )
+            with target:
+                ms.tune_tasks(
+                    tasks=tasks,
+                    task_weights=task_weights,
+                    work_dir=work_dir,
+                    max_trials_global=trials,
+                    max_trials_per_task=trials,
+                    num_trials_per_iter=min(64, trials),
+                    builder=LocalBuilder(max_workers=max_workers),
+                    database=ms.database.JSONDatabase(work_dir=work_dir),
+                )
+            total_allocation[name] += trials
+
+    # Final latency with all rounds applied
+    e2e_us, _ = profile_module(_apply_database(relax_mod, target, work_dir), target, num_profile_runs)
+    round_latency_us.append(e2e_us)
+
+    return {
+        "num_tasks": len(extracted_tasks),
+        "num_rounds": num_rounds,
+        "round_latency_us": round_latency_us,
+        "allocation": total_allocation,
+    }
+
+
+def tune_with_budget_allocation(
+    relax_mod_ir,
+    target_name="llvm",
+    num_trials=64,
+    num_rounds=3,
+    min_trials_per_task=0,
+    max_workers=None,
+    work_dir="tuning_database",
+    pipeline="zero"
+):
+    """
+    Tune a Relax module with profile-guided per-task trial budgets.
+
+    Args:
+        relax_mod_ir: Relax module IR string
+        target_name: Target name (e.g., "llvm")
+        num_trials: Total trials across all rounds
+        num_rounds: Number of profile/tune rounds
+        min_trials_per_task: Trials every task gets in the first round
+        max_workers: Number of parallel workers (None or 0: CPU count)
+        work_dir: Directory for the tuning database
+        pipeline: Relax pipeline preset or pass list (see relax_pipeline);
+            must match the one used to compile
+
+    Returns:
+        dict: Tuning results with per-round latency and per-task allocation
+    """
+    try:
+        # Parse IR string to module
+        relax_mod = tvm.ir.load_json(relax_mod_ir)
+
+        # Setup target
+        target = create_target(target_name)
+
+        # Apply Relax pipeline
+        relax_mod, _ = run_relax_pipeline(relax_mod, target, pipeline, report=False)
+
+        result = tune_with_budget_allocation_mod(
+            relax_mod,
+            target,
+            num_trials=num_trials,
+            num_rounds=num_rounds,
+            min_trials_per_task=min_trials_per_task,
+            max_workers=max_workers,
+            work_dir=work_dir,
+        )
+
+        return {
+            "status": "success",
+            "work_dir": work_dir,
+            "target": str(target),
+            "num_trials": num_trials,
+            "num_tasks": result["num_tasks"],
+            "num_rounds": result["num_rounds"],
+            "initial_latency_us": result["round_latency_us"][0],
+            "final_latency_us": result["round_latency_us"][-1],
+            "round_latency_us": result["round_latency_us"],
+            "allocation": [
+                f"{name}: {trials}"
+                for name, trials in sorted(result["allocation"].items(), key=lambda item: -item[1])
+            ]
+        }
+
+    except Exception as e:
+        return {
+            "status": "error",
+            "error": str(e)
+        }
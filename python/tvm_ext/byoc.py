@@ -0,0 +1,230 @@
+"""
+DNNL (oneDNN) Offload via Relax BYOC
+
+Partitions conv2d, dense and pooling layers into composite functions that
+are compiled by TVM's DNNL JSON codegen (requires a TVM build with
+USE_DNNL=ON). Everything else stays with TVM codegen and can still be
+tuned with MetaSchedule. benchmark_backends compares untuned TVM, the
+MetaSchedule-tuned build and DNNL offload on the same model.
+"""
+
+import os
+import time
+import numpy as np
+import tvm
+from tvm import relax
+from tvm.relax.dpl import is_op, wildcard
+from .timing import current_rss_kb
+
+DNNL_OP_GROUPS = ("conv2d", "dense", "pool")
+
+
+def dnnl_available():
+    """
+    Whether this TVM build has the DNNL codegen and JSON runtime.
+    """
+    return (
+        tvm.get_global_func("relax.ext.dnnl", allow_missing=True) is not None
+        and tvm.get_global_func("runtime.DNNLJSONRuntimeCreate", allow_missing=True) is not None
+    )
+
+
+def dnnl_patterns(ops=None):
+    """
+    Composite patterns for the DNNL codegen, most specific first.
+
+    The DNNL JSON runtime dispatches on the composite name, so names follow
+    its conventions ("dnnl.conv2d_relu", "dnnl.dense", "dnnl.max_pool2d").
+
+    Args:
+        ops: Op groups to offload out of DNNL_OP_GROUPS (default: all)
+
+    Returns:
+        list: (composite name, pattern) pairs for FuseOpsByPattern
+    """
+    ops = list(ops) if ops else list(DNNL_OP_GROUPS)
+    unknown = [op for op in ops if op not in DNNL_OP_GROUPS]
+    if unknown:
+        raise ValueError(f"Unknown DNNL op groups: {unknown} (expected {DNNL_OP_GROUPS})")
+
+    patterns = []
+    if "conv2d" in ops:
+        conv2d = is_op("relax.nn.conv2d")(wildcard(), wildcard())
+        patterns.append(("dnnl.conv2d_relu", is_op("relax.nn.relu")(conv2d)))
+        patterns.append(("dnnl.conv2d", conv2d))
+    if "dense" in ops:
+        # linear() imports as matmul(x, permute_dims(w)), i.e. dense with an (O, I) weight
+        weight = is_op("relax.permute_dims")(wildcard())
+        patterns.append(("dnnl.dense", is_op("relax.matmul")(wildcard(), weight)))
+    if "pool" in ops:
+        patterns.append(("dnnl.max_pool2d", is_op("relax.nn.max_pool2d")(wildcard())))
+        patterns.append(("dnnl.avg_pool2d", is_op("relax.nn.avg_pool2d")(wildcard())))
+    return patterns
+
+
+def _count_offloaded(relax_mod):
+    """
+    Composite functions per DNNL pattern name in the partitioned module.
+    """
+    counts = {}
+
+    def visit(expr):
+        if isinstance(expr, relax.Function) and expr.attrs and "Composite" in expr.attrs:
+            name = str(expr.attrs["Composite"])
+            counts[name] = counts.get(name, 0) + 1
+
+    for func in relax_mod.functions.values():
+        if isinstance(func, relax.Function):
+            relax.analysis.post_order_visit(func, visit)
+    return counts
+
+
+def partition_for_dnnl(relax_mod, ops=None):
+    """
+    Offload supported layers to DNNL and compile them with its codegen.
+
+    Batch norm is decomposed first so the convolutions are visible to the
+    patterns. Call this before the zero pipeline; the remaining ops are
+    legalized and optionally tuned as usual.
+
+    Args:
+        relax_mod: Relax IRModule (before the zero pipeline)
+        ops: Op groups to offload (default: conv2d, dense, pool)
+
+    Returns:
+        tuple: (module with external DNNL functions, {composite name: count})
+    """
+    if not dnnl_available():
+        raise RuntimeError("DNNL codegen is not available in this TVM build (USE_DNNL=OFF)")
+
+    relax_mod = tvm.transform.Sequential([
+        relax.transform.DecomposeOpsForInference(),
+        relax.transform.FuseOpsByPattern(dnnl_patterns(ops)),
+    ])(relax_mod)
+    counts = _count_offloaded(relax_mod)
+
+    relax_mod = tvm.transform.Sequential([
+        relax.transform.MergeCompositeFunctions(),
+        relax.transform.RunCodegen(),
+    ])(relax_mod)
+    return relax_mod, counts
+
+
+def _run_library(lib_path, inputs, num_runs, num_warmup=3):
+    """
+    Load an exported library and time it; also returns the RSS it added.
+    """
+    rss_before = current_rss_kb()
+    vm = relax.VirtualMachine(tvm.runtime.load_module(lib_path), tvm.cpu())
+    for _ in range(num_warmup):
+        output = vm["main"](*inputs)
+    runtime_rss_kb = max(0, current_rss_kb() - rss_before)
+
+    times = []
+    for _ in range(num_runs):
+        start = time.perf_counter()
+        output = vm["main"](*inputs)
+        times.append((time.perf_counter() - start) * 1000.0)
+    if not isinstance(output, tvm.runtime.Tensor):
+        output = output[0]
+    return times, runtime_rss_kb, output.numpy()
+
+
+def benchmark_backends(
+    relax_mod_ir="",
+    target_name="llvm",
+    num_trials=64,
+    max_workers=None,
+    work_dir="backend_benchmark",
+    num_runs=20,
+    dnnl_ops=None
+):
+    """
+    Compare untuned TVM, MetaSchedule-tuned TVM and DNNL offload on one model.
+
+    Each variant is compiled with compile_with_metaschedule into its own
+    subdirectory of work_dir and run on the same random inputs. A variant
+    that fails (e.g. DNNL missing from the TVM build) is reported with its
+    own status instead of failing the benchmark. Variants are skipped with
+    num_trials=0 (tuned) or when DNNL is unavailable (dnnl).
+
+    Args:
+        relax_mod_ir: Relax module IR JSON ("" = pretrained ResNet18)
+        target_name: Target name (e.g., "llvm")
+        num_trials: Trials for the tuned variant
+        max_workers: Parallel builders for tuning (None = all cores)
+        work_dir: Parent directory of the per-variant work directories
+        num_runs: Timed runs per variant
+        dnnl_ops: Op groups to offload (default: conv2d, dense, pool)
+
+    Returns:
+        dict: status, target and "results", a list with one dict per variant:
+            name, status, error, compile_ms, mean_ms, p50_ms, min_ms,
+            library_bytes, runtime_rss_kb (RSS added by loading and warming
+            up the module), peak_rss_kb (process high-water mark after the
+            compile), num_offloaded and max_rel_error (vs. untuned TVM)
+    """
+    from .metaschedule import compile_with_metaschedule
+    from .profiling import _random_inputs
+    from .target import create_target
+
+    try:
+        if not relax_mod_ir:
+            from .resnet_schedule import create_resnet18_relax_mod
+            relax_mod_ir = tvm.ir.save_json(create_resnet18_relax_mod(pretrained=True))
+        inputs = _random_inputs(tvm.ir.load_json(relax_mod_ir)["main"], tvm.cpu())
+
+        variants = [("untuned", {"use_auto_tuning": False})]
+        if num_trials > 0:
+            variants.append(("tuned", {"use_auto_tuning": True, "num_trials": num_trials}))
+        variants.append(("dnnl", {"use_auto_tuning": False, "backend": "dnnl", "offload_ops": dnnl_ops}))
+
+        results = []
+        reference = None
+        for name, kwargs in variants:
+            entry = {"name": name, "status": "success", "error": "", "num_offloaded": 0}
+            if name == "dnnl" and not dnnl_available():
+                entry.update(status="skipped", error="DNNL codegen is not available in this TVM build")
+                results.append(entry)
+                continue
+
+            compiled = compile_with_metaschedule(
+                relax_mod_ir,
+                target_name=target_name,
+                max_workers=max_workers,
+                work_dir=os.path.join(work_dir, name),
+                **kwargs
+            )
+            if compiled["status"] != "success":
+                entry.update(status="error", error=compiled["error"])
+                results.append(entry)
+                continue
+
+            times, runtime_rss_kb, output = _run_library(compiled["lib_path"], inputs, num_runs)
+            if reference is None:
+                reference = output
+            scale = float(np.max(np.abs(reference))) or 1.0
+            entry.update({
+                "compile_ms": sum(phase["wall_ms"] for phase in compiled["phases"]),
+                "mean_ms": float(np.mean(times)),
+                "p50_ms": float(np.median(times)),
+                "min_ms": float(np.min(times)),
+                "library_bytes": os.path.getsize(compiled["lib_path"]),
+                "runtime_rss_kb": runtime_rss_kb,
+                "peak_rss_kb": max(phase["peak_rss_kb"] for phase in compiled["phases"]),
+                "num_offloaded": compiled.get("num_offloaded", 0),
+                "max_rel_error": float(np.max(np.abs(output - reference))) / scale,
+            })
+            results.append(entry)
+
+        return {
+            "status": "success",
+            "target": str(create_target(target_name)),
+            "results": results,
+        }
+
+    except Exception as e:
+        return {
+            "status": "error",
+            "error": str(e)
+        }
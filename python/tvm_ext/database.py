@@ -0,0 +1,686 @@
+"""
+MetaSchedule JSON Tuning Database Utilities
+
+Reads the raw JSON database files written by MetaSchedule
+(database_workload.json / database_tuning_record.json) to compute
+per-workload statistics without loading every record into TVM.
+"""
+
+import os
+import json
+import math
+from functools import lru_cache
+
+
+WORKLOAD_FILE = "database_workload.json"
+TUNING_RECORD_FILE = "database_tuning_record.json"
+
+# MetaSchedule marks failed measurements with run_secs of 1e10
+_FAILED_RUN_SECS = 1e9
+
+
+def database_paths(work_dir):
+    """
+    Get workload and tuning record file paths of a JSON database.
+    """
+    return (
+        os.path.join(work_dir, WORKLOAD_FILE),
+        os.path.join(work_dir, TUNING_RECORD_FILE),
+    )
+
+
+def normalize_shash(shash):
+    """
+    Workload structural hash in the form MetaSchedule writes to disk.
+
+    tvm.ir.structural_hash returns a signed 64-bit value while the database
+    stores the unsigned decimal string, so hashes must be normalized before
+    they are compared.
+
+    Args:
+        shash: Hash as int (signed or unsigned) or decimal string
+
+    Returns:
+        str: Unsigned decimal string
+    """
+    return str(int(shash) & 0xFFFFFFFFFFFFFFFF)
+
+
+def _scan_json_lines(path):
+    """
+    Parse a JSON-lines file line by line.
+
+    Returns:
+        list: (raw line terminated by a newline, parsed row or None if the
+            line is malformed) per non-empty line
+    """
+    lines = []
+    with open(path, "rb") as f:
+        for raw in f:
+            line = raw.strip()
+            if not line:
+                continue
+            try:
+                row = json.loads(line)
+            except ValueError:
+                row = None
+            if not isinstance(row, list) or len(row) < 2:
+                row = None
+            lines.append((raw if raw.endswith(b"\n") else raw + b"\n", row))
+    return lines
+
+
+def _load_json_database(work_dir):
+    """
+    Read a JSON database, skipping malformed lines.
+
+    Records refer to workloads by line number, so records of a dropped
+    workload line are dropped too and later ones are renumbered.
+
+    Returns:
+        tuple: (workload lines, record lines, changed) where each line is
+            (raw, row) as kept, and changed tells whether anything was
+            dropped, renumbered or missed its trailing newline
+    """
+    workload_path, record_path = database_paths(work_dir)
+    workload_lines = _scan_json_lines(workload_path) if os.path.exists(workload_path) else []
+    record_lines = _scan_json_lines(record_path) if os.path.exists(record_path) else []
+    changed = False
+    for path in (workload_path, record_path):
+        if os.path.exists(path) and os.path.getsize(path) > 0:
+            with open(path, "rb") as f:
+                f.seek(-1, os.SEEK_END)
+                changed = changed or f.read(1) != b"\n"
+
+    renumbered = {}
+    kept_workloads = []
+    for old_index, (raw, row) in enumerate(workload_lines):
+        if row is None:
+            renumbered[old_index] = None
+            changed = True
+            continue
+        if old_index != len(kept_workloads):
+            renumbered[old_index] = len(kept_workloads)
+        kept_workloads.append((raw, row))
+
+    kept_records = []
+    for raw, row in record_lines:
+        if row is None or not isinstance(row[0], int):
+            changed = True
+            continue
+        if row[0] in renumbered:
+            changed = True
+            if renumbered[row[0]] is None:
+                continue
+            row = [renumbered[row[0]]] + row[1:]
+            raw = json.dumps(row, separators=(",", ":")).encode() + b"\n"
+        kept_records.append((raw, row))
+    return kept_workloads, kept_records, changed
+
+
+def repair_json_database(work_dir):
+    """
+    Drop malformed lines left by an interrupted or corrupted tuning run.
+
+    Only the malformed lines themselves are removed (a crash usually cuts
+    the last one); every valid record before and after them is kept. A
+    dropped workload line also drops its records, and later records are
+    renumbered so they keep pointing at their workloads.
+
+    Returns:
+        int: Number of files repaired
+    """
+    workload_lines, record_lines, changed = _load_json_database(work_dir)
+    if not changed:
+        return 0
+
+    repaired = 0
+    for path, lines in zip(database_paths(work_dir), (workload_lines, record_lines)):
+        if not os.path.exists(path):
+            continue
+        with open(path, "rb") as f:
+            original = f.read()
+        content = b"".join(raw for raw, _ in lines)
+        if content != original:
+            tmp_path = path + ".tmp"
+            with open(tmp_path, "wb") as f:
+                f.write(content)
+            os.replace(tmp_path, path)
+            repaired += 1
+    return repaired
+
+
+def record_latency_secs(record_json):
+    """
+    Mean measured latency of a tuning record in seconds (None if the run failed).
+
+    Args:
+        record_json: Tuning record as stored in the database ([trace, run_secs, target, args_info])
+    """
+    run_secs = record_json[1] if len(record_json) > 1 else None
+    if not run_secs:
+        return None
+    values = [float(v) for v in run_secs]
+    if all(v >= _FAILED_RUN_SECS for v in values):
+        return None
+    return sum(values) / len(values)
+
+
+def _incomplete_beta(a, b, x):
+    """
+    Regularized incomplete beta function I_x(a, b) (continued fraction, Lentz's method).
+    """
+    if x <= 0.0:
+        return 0.0
+    if x >= 1.0:
+        return 1.0
+    if x > (a + 1.0) / (a + b + 2.0):
+        return 1.0 - _incomplete_beta(b, a, 1.0 - x)
+
+    tiny = 1e-300
+    front = math.exp(math.lgamma(a + b) - math.lgamma(a) - math.lgamma(b) + a * math.log(x) + b * math.log1p(-x)) / a
+    c, d = 1.0, 1.0 - (a + b) * x / (a + 1.0)
+    d = 1.0 / (d if abs(d) > tiny else tiny)
+    result = d
+    for m in range(1, 300):
+        for numerator in (
+            m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m)),
+            -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1)),
+        ):
+            d = 1.0 + numerator * d
+            d = 1.0 / (d if abs(d) > tiny else tiny)
+            c = 1.0 + numerator / c
+            c = c if abs(c) > tiny else tiny
+            result *= c * d
+        if abs(c * d - 1.0) < 1e-15:
+            break
+    return front * result
+
+
+@lru_cache(maxsize=None)
+def _t_quantile(probability, df):
+    """
+    Quantile of Student's t distribution with df degrees of freedom (probability >= 0.5).
+
+    Inverts the exact CDF, 1 - I_{df/(df+t^2)}(df/2, 1/2) / 2, by bisection.
+    """
+    def cdf(t):
+        return 1.0 - 0.5 * _incomplete_beta(df / 2.0, 0.5, df / (df + t * t))
+
+    low, high = 0.0, 1.0
+    while cdf(high) < probability:
+        low, high = high, high * 2.0
+    for _ in range(200):
+        mid = (low + high) / 2.0
+        if cdf(mid) < probability:
+            low = mid
+        else:
+            high = mid
+        if high - low <= 1e-12 * high:
+            break
+    return (low + high) / 2.0
+
+
+def confidence_interval(samples, confidence=0.95):
+    """
+    Mean and confidence-interval half-width of repeated measurements.
+
+    Uses the exact Student's t quantile for n - 1 degrees of freedom, so
+    intervals of few repeats are not too narrow.
+
+    Returns:
+        tuple: (mean, half width); half width is None for fewer than 2 samples
+    """
+    n = len(samples)
+    mean = sum(samples) / n
+    if n < 2:
+        return mean, None
+    variance = sum((x - mean) ** 2 for x in samples) / (n - 1)
+    t = _t_quantile(0.5 + confidence / 2.0, n - 1)
+    return mean, t * math.sqrt(variance / n)
+
+
+def record_confidence_interval(record_json, confidence=0.95):
+    """
+    Confidence interval of a tuning record's latency from its run_secs repeats.
+
+    Returns:
+        tuple: (mean_secs, half_width_secs or None) or None if the run failed
+    """
+    if record_latency_secs(record_json) is None:
+        return None
+    return confidence_interval([float(v) for v in record_json[1]], confidence)
+
+
+def _upper_bound(record_json, confidence):
+    # Upper bound where an interval exists, else the mean; None if the run failed
+    interval = record_confidence_interval(record_json, confidence)
+    if interval is None:
+        return None
+    mean, half = interval
+    return mean + half if half is not None else mean
+
+
+def read_json_database(work_dir):
+    """
+    Read a MetaSchedule JSON database.
+
+    Returns:
+        tuple: (workloads, records) where workloads is a list of [shash, module]
+               and records is a list of [workload_index, record_json] in file order;
+               malformed lines are skipped (see repair_json_database)
+    """
+    workload_lines, record_lines, _ = _load_json_database(work_dir)
+    return [row for _, row in workload_lines], [row for _, row in record_lines]
+
+
+def workload_stats(work_dir, convergence_window=32, convergence_tol=0.01):
+    """
+    Compute per-workload statistics of a JSON database.
+
+    A workload is considered converged when it has at least twice
+    `convergence_window` valid records and its best latency improved by
+    less than `convergence_tol` (relative) over the last `convergence_window`
+    records.
+
+    Args:
+        work_dir: Directory containing the JSON database
+        convergence_window: Number of most recent records to check for improvement
+        convergence_tol: Relative improvement below which tuning has converged
+
+    Returns:
+        dict: shash (see normalize_shash) -> {"workload_index", "num_records", "num_valid",
+                        "best_latency_us", "best_ci_us" (95% half-width of
+                        the best record, -1 without repeats), "converged"}
+    """
+    workloads, records = read_json_database(work_dir)
+
+    latencies = {index: [] for index in range(len(workloads))}
+    counts = {index: 0 for index in range(len(workloads))}
+    best_ci = {}
+    for workload_index, record_json in records:
+        if workload_index not in counts:
+            continue
+        counts[workload_index] += 1
+        latency = record_latency_secs(record_json)
+        if latency is not None:
+            history = latencies[workload_index]
+            if not history or latency < best_ci[workload_index][0]:
+                best_ci[workload_index] = record_confidence_interval(record_json)
+            history.append(latency)
+
+    stats = {}
+    for index, workload in enumerate(workloads):
+        history = latencies[index]
+        best = min(history) if history else None
+
+        converged = False
+        if convergence_window > 0 and len(history) >= 2 * convergence_window:
+            previous_best = min(history[:-convergence_window])
+            converged = (previous_best - best) < convergence_tol * previous_best
+
+        stats[normalize_shash(workload[0])] = {
+            "workload_index": index,
+            "num_records": counts[index],
+            "num_valid": len(history),
+            "best_latency_us": best * 1e6 if best is not None else -1.0,
+            "best_ci_us": best_ci[index][1] * 1e6 if history and best_ci[index][1] is not None else -1.0,
+            "converged": converged,
+        }
+    return stats
+
+
+def _write_json_lines(path, rows):
+    """
+    Atomically write rows as a JSON-lines file.
+    """
+    tmp_path = path + ".tmp"
+    with open(tmp_path, "w") as f:
+        for row in rows:
+            f.write(json.dumps(row, separators=(",", ":")))
+            f.write("\n")
+    os.replace(tmp_path, path)
+
+
+def merge_tuning_databases(input_dirs, output_dir, top_k=0):
+    """
+    Merge JSON databases, deduplicating workloads by structural hash.
+
+    Identical records (same trace) found in several inputs are kept once.
+    With top_k > 0 only the K fastest valid records per workload are kept
+    and failed records are dropped.
+
+    Args:
+        input_dirs: List of work directories to merge
+        output_dir: Directory for the merged database (may be one of the inputs)
+        top_k: Records to keep per workload (0 keeps all)
+
+    Returns:
+        dict: Merge statistics
+    """
+    try:
+        merged_workloads = []
+        workload_index = {}
+        merged_records = {}
+        seen_traces = set()
+        input_records = 0
+
+        for work_dir in input_dirs:
+            workloads, records = read_json_database(work_dir)
+            input_records += len(records)
+
+            local_to_merged = {}
+            for local_index, workload in enumerate(workloads):
+                key = normalize_shash(workload[0])
+                if key not in workload_index:
+                    workload_index[key] = len(merged_workloads)
+                    merged_workloads.append(workload)
+                    merged_records[workload_index[key]] = []
+                local_to_merged[local_index] = workload_index[key]
+
+            for local_index, record_json in records:
+                if local_index not in local_to_merged:
+                    continue
+                merged_index = local_to_merged[local_index]
+                trace_key = (merged_index, json.dumps(record_json[0], sort_keys=True))
+                if trace_key in seen_traces:
+                    continue
+                seen_traces.add(trace_key)
+                merged_records[merged_index].append(record_json)
+
+        output_records = []
+        for index in range(len(merged_workloads)):
+            records = merged_records[index]
+            if top_k > 0:
+                valid = [r for r in records if record_latency_secs(r) is not None]
+                records = sorted(valid, key=record_latency_secs)[:top_k]
+            output_records.extend([index, r] for r in records)
+
+        os.makedirs(output_dir, exist_ok=True)
+        workload_path, record_path = database_paths(output_dir)
+        _write_json_lines(workload_path, merged_workloads)
+        _write_json_lines(record_path, output_records)
+
+        return {
+            "status": "success",
+            "output_dir": output_dir,
+            "num_inputs": len(input_dirs),
+            "num_workloads": len(merged_workloads),
+            "input_records": input_records,
+            "output_records": len(output_records),
+            "top_k": top_k
+        }
+
+    except Exception as e:
+        return {
+            "status": "error",
+            "error": str(e)
+        }
+
+
+def compact_tuning_database(work_dir, top_k=1, output_dir=None):
+    """
+    Keep only the top-K records per workload and build the lookup index.
+
+    Args:
+        work_dir: Directory containing the JSON database
+        top_k: Records to keep per workload
+        output_dir: Output directory (None or empty: compact in place)
+
+    Returns:
+        dict: Compaction statistics and index path
+    """
+    if not output_dir:
+        output_dir = work_dir
+
+    result = merge_tuning_databases([work_dir], output_dir, top_k=top_k)
+    if result["status"] != "success":
+        return result
+
+    index_result = build_database_index(output_dir)
+    if index_result["status"] != "success":
+        return index_result
+
+    result["index_path"] = index_result["index_path"]
+    return result
+
+
+def select_by_confidence(work_dir, output_dir, confidence=0.95):
+    """
+    Keep, per workload, the record with the lowest upper confidence bound.
+
+    A record that is fast in one lucky repeat but noisy loses against a
+    slightly slower, consistently measured one. Records without repeats have
+    no interval and are ranked by their mean, on the same scale.
+
+    Args:
+        work_dir: Directory containing the JSON database
+        output_dir: Directory for the selected database (one record per workload)
+        confidence: Confidence level of the intervals
+
+    Returns:
+        dict: status, output_dir, num_workloads and num_with_interval
+            (selected records that have repeats)
+    """
+    try:
+        workloads, records = read_json_database(work_dir)
+        best = {}
+        for workload_index, record_json in records:
+            bound = _upper_bound(record_json, confidence)
+            if bound is not None and (workload_index not in best or bound < best[workload_index][0]):
+                best[workload_index] = (bound, record_json)
+
+        os.makedirs(output_dir, exist_ok=True)
+        workload_path, record_path = database_paths(output_dir)
+        _write_json_lines(workload_path, workloads)
+        _write_json_lines(record_path, [[index, best[index][1]] for index in sorted(best)])
+
+        return {
+            "status": "success",
+            "output_dir": output_dir,
+            "num_workloads": len(best),
+            "num_with_interval": sum(
+                1 for _, record_json in best.values()
+                if record_confidence_interval(record_json, confidence)[1] is not None
+            ),
+        }
+
+    except Exception as e:
+        return {
+            "status": "error",
+            "error": str(e)
+        }
+
+
+INDEX_FILE = "database_index.json"
+
+
+def build_database_index(work_dir):
+    """
+    Build an index from workload hash to its best record's byte offset.
+
+    The index lets lookup_best_record() and indexed_database() fetch single
+    records by seeking into the tuning record file instead of parsing the
+    whole database. It stores the record file size it was built from, so a
+    stale index can be detected.
+
+    Args:
+        work_dir: Directory containing the JSON database
+
+    Returns:
+        dict: Index status and path
+    """
+    try:
+        workload_path, record_path = database_paths(work_dir)
+        # Record workload indices are raw line numbers of the workload file
+        shash_of = {}
+        if os.path.exists(workload_path):
+            shash_of = {
+                i: normalize_shash(workload[0])
+                for i, (_, workload) in enumerate(_scan_json_lines(workload_path))
+                if workload is not None
+            }
+        index = {
+            shash: {
+                "workload_index": i,
+                "num_records": 0,
+                "best_latency_us": -1.0,
+                "best_offset": -1,
+            }
+            for i, shash in shash_of.items()
+        }
+
+        raw_lines = []
+        if os.path.exists(record_path):
+            with open(record_path, "rb") as f:
+                raw_lines = f.readlines()
+
+        offset = 0
+        for raw in raw_lines:
+            line = raw.strip()
+            try:
+                workload_index, record_json = json.loads(line) if line else (None, None)
+            except (TypeError, ValueError):
+                workload_index = None
+            if workload_index is not None:
+                entry = index.get(shash_of.get(workload_index))
+                if entry is not None:
+                    entry["num_records"] += 1
+                    latency = record_latency_secs(record_json)
+                    if latency is not None and (
+                        entry["best_offset"] < 0 or latency * 1e6 < entry["best_latency_us"]
+                    ):
+                        entry["best_latency_us"] = latency * 1e6
+                        entry["best_offset"] = offset
+            offset += len(raw)
+
+        index_path = os.path.join(work_dir, INDEX_FILE)
+        with open(index_path, "w") as f:
+            json.dump({"record_file": TUNING_RECORD_FILE, "record_bytes": offset, "workloads": index}, f)
+
+        return {
+            "status": "success",
+            "index_path": index_path,
+            "num_workloads": len(index)
+        }
+
+    except Exception as e:
+        return {
+            "status": "error",
+            "error": str(e)
+        }
+
+
+def lookup_best_record(work_dir, shash):
+    """
+    Look up the best tuning record of a workload through the index.
+
+    Args:
+        work_dir: Directory containing the JSON database and index
+        shash: Workload structural hash
+
+    Returns:
+        list: Record as [workload_index, record_json], or None if not found
+    """
+    with open(os.path.join(work_dir, INDEX_FILE)) as f:
+        index = json.load(f)
+
+    entry = index["workloads"].get(normalize_shash(shash))
+    if entry is None or entry["best_offset"] < 0:
+        return None
+
+    with open(os.path.join(work_dir, index["record_file"]), "rb") as f:
+        f.seek(entry["best_offset"])
+        return json.loads(f.readline())
+
+
+def indexed_database(work_dir, output_dir):
+    """
+    Write a database holding only the best record of each workload.
+
+    MetaScheduleApplyDatabase loads every record of the database it is
+    given; applying this copy loads one record per workload. The records
+    are fetched by seeking to their offsets in the index, which is rebuilt
+    when it is missing or older than the record file.
+
+    Args:
+        work_dir: Directory containing the JSON database
+        output_dir: Directory for the pruned database
+
+    Returns:
+        dict: status, output_dir, num_workloads and index_rebuilt
+    """
+    try:
+        repair_json_database(work_dir)
+        workload_path, record_path = database_paths(work_dir)
+        record_bytes = os.path.getsize(record_path) if os.path.exists(record_path) else 0
+
+        index_path = os.path.join(work_dir, INDEX_FILE)
+        index = None
+        if os.path.exists(index_path):
+            with open(index_path) as f:
+                index = json.load(f)
+        rebuilt = index is None or index.get("record_bytes") != record_bytes
+        if rebuilt:
+            built = build_database_index(work_dir)
+            if built["status"] != "success":
+                return built
+            with open(index_path) as f:
+                index = json.load(f)
+
+        workloads = [row for _, row in _scan_json_lines(workload_path)] if os.path.exists(workload_path) else []
+        entries = sorted(index["workloads"].values(), key=lambda entry: entry["workload_index"])
+        records = []
+        if record_bytes:
+            with open(record_path, "rb") as f:
+                for entry in entries:
+                    if entry["best_offset"] >= 0:
+                        f.seek(entry["best_offset"])
+                        records.append(json.loads(f.readline()))
+
+        os.makedirs(output_dir, exist_ok=True)
+        out_workload_path, out_record_path = database_paths(output_dir)
+        _write_json_lines(out_workload_path, workloads)
+        _write_json_lines(out_record_path, records)
+
+        return {
+            "status": "success",
+            "output_dir": output_dir,
+            "num_workloads": len(records),
+            "index_rebuilt": rebuilt,
+        }
+
+    except Exception as e:
+        return {
+            "status": "error",
+            "error": str(e)
+        }
+
+
+if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser(description="MetaSchedule JSON database tool")
+    subparsers = parser.add_subparsers(dest="command", required=True)
+
+    merge_parser = subparsers.add_parser("merge", help="Merge databases")
+    merge_parser.add_argument("inputs", nargs="+", help="Input work directories")
+    merge_parser.add_argument("-o", "--output", required=True, help="Output work directory")
+    merge_parser.add_argument("-k", "--top-k", type=int, default=0, help="Records per workload (0 = all)")
+
+    compact_parser = subparsers.add_parser("compact", help="Keep top-K records and build index")
+    compact_parser.add_argument("work_dir", help="Work directory")
+    compact_parser.add_argument("-k", "--top-k", type=int, default=1, help="Records per workload")
+    compact_parser.add_argument("-o", "--output", default=None, help="Output work directory")
+
+    stats_parser = subparsers.add_parser("stats", help="Print per-workload statistics")
+    stats_parser.add_argument("work_dir", help="Work directory")
+
+    args = parser.parse_args()
+    if args.command == "merge":
+        print(merge_tuning_databases(args.inputs, args.output, top_k=args.top_k))
+    elif args.command == "compact":
+        print(compact_tuning_database(args.work_dir, top_k=args.top_k, output_dir=args.output))
+    else:
+        for shash, stats in workload_stats(args.work_dir).items():
+            print(f"{shash}: {stats}")
@@ -0,0 +1,300 @@
+"""
+Dynamic-Shape Compilation with Symbolic Dimensions
+
+Compiles a module whose inputs have symbolic dimensions (e.g. batch,
+height and width, see models.import_fx_model) into one executable that
+serves any shape. MetaSchedule records are keyed by static workloads and
+its tile sizes do not carry over to symbolic loops, so tuning runs on
+representative concrete shapes: each one becomes a specialized copy of
+"main" ("main_batch1_height224_width224") whose kernels receive the tuned
+records, while "main" keeps the symbolic kernels for every other shape.
+A manifest next to the library maps input shapes to functions
+(see select_shape_function), so no shape needs a recompilation.
+"""
+
+import os
+import json
+import time
+import numpy as np
+import tvm
+from tvm import relax
+from .relax_pipeline import run_relax_pipeline
+from .target import create_target
+
+MANIFEST_SUFFIX = ".json"
+
+
+def symbolic_vars(func):
+    """
+    Names of the symbolic dimensions a Relax function's parameters define.
+    """
+    return [var.name for var in relax.analysis.defined_symbolic_vars(func)]
+
+
+def shape_function_name(bindings, func_name="main"):
+    """
+    Name of the specialization of func_name for a binding (e.g. "main_batch1_height224_width224").
+    """
+    return func_name + "".join(f"_{name}{int(value)}" for name, value in bindings.items())
+
+
+def specialize_function(relax_mod, bindings, func_name="main"):
+    """
+    Copy of a Relax function with its symbolic dimensions bound to constants.
+
+    Args:
+        relax_mod: Relax IRModule
+        bindings: {symbolic dimension name: value}; must bind every dimension
+        func_name: Function to specialize
+
+    Returns:
+        relax.Function: Static-shape function named shape_function_name(bindings)
+    """
+    names = symbolic_vars(relax_mod[func_name])
+    missing = [name for name in names if name not in bindings]
+    if missing:
+        raise ValueError(f"Shape binding {bindings} misses symbolic dimensions {missing}")
+
+    bindings = {name: int(bindings[name]) for name in names}
+    mod = tvm.IRModule({func_name: relax_mod[func_name]})
+    func = relax.transform.BindSymbolicVars(bindings, func_name)(mod)[func_name]
+    return func.with_attr("global_symbol", shape_function_name(bindings, func_name))
+
+
+def input_shapes(func, bindings=None):
+    """
+    Concrete parameter shapes of a Relax function under a binding.
+    """
+    bindings = bindings or {}
+    shapes = []
+    for param in func.params:
+        sinfo = param.struct_info
+        if not isinstance(sinfo, relax.TensorStructInfo) or sinfo.shape is None:
+            raise ValueError(f"Unsupported parameter: {param.name_hint}")
+        shape = []
+        for dim in sinfo.shape.values:
+            if isinstance(dim, tvm.tir.IntImm):
+                shape.append(int(dim))
+            elif isinstance(dim, tvm.tir.Var) and dim.name in bindings:
+                shape.append(int(bindings[dim.name]))
+            else:
+                raise ValueError(f"Parameter {param.name_hint} has an unbound dimension: {dim}")
+        shapes.append(shape)
+    return shapes
+
+
+def count_dynamic_kernels(relax_mod):
+    """
+    PrimFuncs with at least one symbolic buffer dimension.
+    """
+    count = 0
+    for func in relax_mod.functions.values():
+        if isinstance(func, tvm.tir.PrimFunc) and any(
+            not isinstance(dim, tvm.tir.IntImm)
+            for buffer in func.buffer_map.values()
+            for dim in buffer.shape
+        ):
+            count += 1
+    return count
+
+
+def _count_kernels(relax_mod):
+    kernels = [func for func in relax_mod.functions.values() if isinstance(func, tvm.tir.PrimFunc)]
+    scheduled = sum(1 for func in kernels if func.attrs and "tir.is_scheduled" in func.attrs)
+    return len(kernels), scheduled
+
+
+def select_shape_function(manifest_path, shapes):
+    """
+    Function of a dynamic-shape library to call for the given input shapes.
+
+    Args:
+        manifest_path: Manifest written by compile_dynamic
+        shapes: Input shapes in parameter order
+
+    Returns:
+        str: The specialization tuned for exactly these shapes, or the
+            symbolic function
+    """
+    with open(manifest_path) as f:
+        manifest = json.load(f)
+    shapes = [[int(d) for d in shape] for shape in shapes]
+    for entry in manifest["specialized"]:
+        if entry["input_shapes"] == shapes:
+            return entry["function"]
+    return manifest["dynamic_function"]
+
+
+def _time_function(vm, func_name, inputs, num_runs, num_warmup=2):
+    for _ in range(num_warmup):
+        output = vm[func_name](*inputs)
+    times = []
+    for _ in range(num_runs):
+        start = time.perf_counter()
+        output = vm[func_name](*inputs)
+        times.append((time.perf_counter() - start) * 1000.0)
+    if not isinstance(output, tvm.runtime.Tensor):
+        output = output[0]
+    return float(np.mean(times)), output.numpy()
+
+
+def compile_dynamic(
+    relax_mod_ir="",
+    target_name="llvm",
+    representative_shapes=None,
+    use_auto_tuning=True,
+    num_trials=64,
+    target_trials_per_task=64,
+    max_workers=None,
+    work_dir="tuning_database_dynamic",
+    pipeline="zero",
+    check_shapes=None,
+    num_runs=10
+):
+    """
+    Compile a module with symbolic input dimensions into one executable for all shapes.
+
+    Every representative shape is tuned (incrementally, into one database
+    in work_dir) as a static specialization of "main". The library holds
+    "main" with symbolic kernels plus one tuned specialization per
+    representative shape; the manifest <lib>.json lists which input shapes
+    each specialization serves.
+
+    Args:
+        relax_mod_ir: Relax module IR JSON with symbolic dimensions ("" =
+            pretrained ResNet18 with symbolic batch, height and width)
+        target_name: Target name (e.g., "llvm")
+        representative_shapes: List of {dimension name: value} to tune for
+        use_auto_tuning: Tune the representative shapes (False: untuned
+            specializations)
+        num_trials: New-trial budget per representative shape
+        target_trials_per_task: Trials after which a workload counts as tuned
+        max_workers: Number of parallel workers (None = CPU count)
+        work_dir: Tuning database and output directory
+        pipeline: Relax pipeline preset or pass list (see relax_pipeline)
+        check_shapes: Bindings to run after the build (default: the
+            representative shapes); empty list skips the check
+        num_runs: Timed runs per checked shape
+
+    Returns:
+        dict: status, target, lib_path, manifest_path, symbolic_vars,
+            num_kernels, num_dynamic_kernels, num_tuned_kernels,
+            "specialized" (function, bindings, num_tasks, tuned_tasks,
+            reused_tasks, new_records per representative shape) and "checks"
+            (bindings, function, mean_ms, dynamic_mean_ms and max_rel_error
+            of the dispatched function against the symbolic one)
+    """
+    from .metaschedule import _tune_incremental_mod
+
+    try:
+        if relax_mod_ir:
+            relax_mod = tvm.ir.load_json(relax_mod_ir)
+        else:
+            from .models import import_fx_model
+            relax_mod = import_fx_model("resnet18", [(("batch", 3, "height", "width"), "float32")])
+
+        target = create_target(target_name)
+        names = symbolic_vars(relax_mod["main"])
+        if not names:
+            raise ValueError("main has no symbolic dimensions; use compile_with_metaschedule for static shapes")
+        if not representative_shapes:
+            raise ValueError("At least one representative shape is required")
+        os.makedirs(work_dir, exist_ok=True)
+
+        # Tune each representative shape as a static module
+        combined = tvm.IRModule({"main": relax_mod["main"]})
+        specialized = []
+        manifest_entries = []
+        for bindings in representative_shapes:
+            func = specialize_function(relax_mod, bindings)
+            func_name = str(func.attrs["global_symbol"])
+            combined[func_name] = func
+            entry = {
+                "function": func_name,
+                "bindings": {name: int(bindings[name]) for name in names},
+                "num_tasks": 0,
+                "tuned_tasks": 0,
+                "reused_tasks": 0,
+                "new_records": 0,
+            }
+            if use_auto_tuning:
+                # Key the function by its global_symbol, as in the combined module
+                static_mod, _ = run_relax_pipeline(tvm.IRModule({func_name: func}), target, pipeline, report=False)
+                tuned = _tune_incremental_mod(
+                    static_mod, target, num_trials, target_trials_per_task, max_workers, work_dir
+                )
+                entry.update(
+                    num_tasks=tuned["num_tasks"],
+                    tuned_tasks=tuned["tuned_tasks"],
+                    reused_tasks=tuned["skipped_tasks"],
+                    new_records=tuned["new_records"],
+                )
+            specialized.append(entry)
+            manifest_entries.append({
+                "function": func_name,
+                "bindings": entry["bindings"],
+                "input_shapes": input_shapes(func),
+            })
+
+        # One module: symbolic main plus the specializations
+        combined, _ = run_relax_pipeline(combined, target, pipeline, report=False)
+        if use_auto_tuning:
+            from tvm.ir.transform import PassContext
+
+            with target, PassContext(opt_level=0):
+                combined = relax.transform.MetaScheduleApplyDatabase(work_dir)(combined)
+        num_kernels, num_tuned = _count_kernels(combined)
+
+        ex = relax.build(combined, target)
+        lib_path = os.path.join(work_dir, "dynamic_lib.so")
+        ex.export_library(lib_path)
+        manifest_path = os.path.splitext(lib_path)[0] + MANIFEST_SUFFIX
+        with open(manifest_path, "w") as f:
+            json.dump({
+                "dynamic_function": "main",
+                "symbolic_vars": names,
+                "specialized": manifest_entries,
+            }, f, indent=1)
+
+        # Run the one executable on each checked shape
+        checks = []
+        vm = relax.VirtualMachine(tvm.runtime.load_module(lib_path), tvm.cpu())
+        for bindings in (representative_shapes if check_shapes is None else check_shapes):
+            shapes = input_shapes(relax_mod["main"], bindings)
+            params = relax_mod["main"].params
+            inputs = [
+                tvm.runtime.tensor(np.random.uniform(-1.0, 1.0, size=shape).astype(param.struct_info.dtype), tvm.cpu())
+                for shape, param in zip(shapes, params)
+            ]
+            func_name = select_shape_function(manifest_path, shapes)
+            mean_ms, output = _time_function(vm, func_name, inputs, num_runs)
+            dynamic_mean_ms, dynamic_output = mean_ms, output
+            if func_name != "main":
+                dynamic_mean_ms, dynamic_output = _time_function(vm, "main", inputs, num_runs)
+            scale = float(np.max(np.abs(dynamic_output))) or 1.0
+            checks.append({
+                "bindings": {name: int(bindings[name]) for name in names},
+                "function": func_name,
+                "mean_ms": mean_ms,
+                "dynamic_mean_ms": dynamic_mean_ms,
+                "max_rel_error": float(np.max(np.abs(output - dynamic_output))) / scale,
+            })
+
+        return {
+            "status": "success",
+            "target": str(target),
+            "lib_path": lib_path,
+            "manifest_path": manifest_path,
+            "symbolic_vars": names,
+            "num_kernels": num_kernels,
+            "num_dynamic_kernels": count_dynamic_kernels(combined),
+            "num_tuned_kernels": num_tuned,
+            "specialized": specialized,
+            "checks": checks,
+        }
+
+    except Exception as e:
+        return {
+            "status": "error",
+            "error": str(e)
+        }
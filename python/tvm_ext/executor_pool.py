@@ -0,0 +1,321 @@
+"""
+Executor Pool Sharing One Copy of Model Weights
+
+Compiles Relax modules with parameters as function inputs, stores the
+weights next to the library once, and runs N lightweight Relax VM
+instances that all pass the same read-only parameter tensors. Each
+instance has its own VM state and runs on its own thread (optionally
+pinned to dedicated cores), so memory stays flat as concurrency grows.
+"""
+
+import os
+import json
+import queue
+import threading
+from concurrent.futures import ThreadPoolExecutor
+import tvm
+from tvm import relax
+from .target import create_target
+from .param_file import save_param_file, load_param_tensors
+from .relax_pipeline import run_relax_pipeline
+from .runtime_config import cpu_topology, localize_tensors
+
+LIBRARY_FILE = "compiled_lib.so"
+PARAMS_FILE = "params.tsdk"
+MANIFEST_FILE = "params.json"
+
+
+def export_with_params_as_input(
+    relax_mod_ir,
+    target_name="llvm",
+    work_dir="shared_weights",
+    opt_level=0,
+    pipeline="zero"
+):
+    """
+    Build a module whose weights are function inputs and save them separately.
+
+    The main function must carry its weights in the "params" attribute with
+    "num_input" runtime inputs (PyTorch frontend, keep_params_as_input=True).
+
+    Args:
+        relax_mod_ir: Relax module IR string
+        target_name: Target name (e.g., "llvm")
+        work_dir: Output directory (library, params.tsdk, params.json)
+        opt_level: Optimization level for relax.build (0-3)
+        pipeline: Relax pipeline preset or pass list (see relax_pipeline)
+
+    Returns:
+        dict: Export results with library/params paths and parameter sizes
+    """
+    from tvm.ir.transform import PassContext
+
+    try:
+        relax_mod = tvm.ir.load_json(relax_mod_ir)
+        target = create_target(target_name)
+
+        func_name = "main"
+        num_input = int(relax_mod[func_name].attrs["num_input"])
+        param_names = [param.name_hint for param in relax_mod[func_name].params[num_input:]]
+
+        relax_mod, params = relax.frontend.detach_params(relax_mod)
+        weights = params.get(func_name, [])
+        if len(weights) != len(param_names):
+            raise ValueError(f"Expected {len(param_names)} params, found {len(weights)}")
+
+        relax_mod, _ = run_relax_pipeline(relax_mod, target, pipeline, report=False)
+        with target, PassContext(opt_level=opt_level):
+            ex = relax.build(relax_mod, target)
+
+        os.makedirs(work_dir, exist_ok=True)
+        lib_path = os.path.join(work_dir, LIBRARY_FILE)
+        ex.export_library(lib_path)
+
+        params_path = os.path.join(work_dir, PARAMS_FILE)
+        save_param_file(params_path, list(zip(param_names, weights)))
+
+        with open(os.path.join(work_dir, MANIFEST_FILE), "w") as f:
+            json.dump({
+                "func_name": func_name,
+                "num_input": num_input,
+                "params": param_names,
+            }, f, indent=2)
+
+        return {
+            "status": "success",
+            "lib_path": lib_path,
+            "params_path": params_path,
+            "num_input": num_input,
+            "num_params": len(param_names),
+            "param_bytes": sum(_nbytes(w) for w in weights),
+            "target": str(target)
+        }
+
+    except Exception as e:
+        return {
+            "status": "error",
+            "error": str(e)
+        }
+
+
+def load_shared_params(work_dir, device=None):
+    """
+    Load the parameters saved by export_with_params_as_input once.
+
+    On CPU the tensors alias a memory mapping of the parameter file, so
+    loading does not read or copy the weights.
+
+    Returns:
+        tuple: (manifest dict, list of parameter tensors in input order)
+    """
+    with open(os.path.join(work_dir, MANIFEST_FILE)) as f:
+        manifest = json.load(f)
+    tensors = load_param_tensors(os.path.join(work_dir, PARAMS_FILE), manifest["params"])
+    if device is not None and device.device_type != tvm.cpu().device_type:
+        tensors = [tvm.runtime.tensor(t.numpy(), device) for t in tensors]
+    return manifest, tensors
+
+
+def _nbytes(tensor):
+    """
+    Size of a tensor's data in bytes.
+    """
+    count = 1
+    for dim in tensor.shape:
+        count *= int(dim)
+    return count * ((tvm.DataType(tensor.dtype).bits * tvm.DataType(tensor.dtype).lanes + 7) // 8)
+
+
+def _as_output(array):
+    return array if isinstance(array, tvm.runtime.Tensor) else tvm.runtime.from_dlpack(array)
+
+
+def _instance_cores(num_instances, cores_per_instance, numa_local=False):
+    """
+    Disjoint core sets per instance (empty lists when not pinning).
+
+    With numa_local, instances are assigned to NUMA nodes round-robin and
+    take their cores from their node.
+
+    Returns:
+        list: (numa node or -1, core list) per instance
+    """
+    if cores_per_instance <= 0:
+        return [(-1, []) for _ in range(num_instances)]
+
+    if numa_local:
+        nodes = cpu_topology()["numa_nodes"]
+        node_ids = sorted(nodes)
+        used = {node: 0 for node in node_ids}
+        assignment = []
+        for i in range(num_instances):
+            node = node_ids[i % len(node_ids)]
+            first = used[node]
+            if first + cores_per_instance > len(nodes[node]):
+                raise ValueError(
+                    f"NUMA node {node} has {len(nodes[node])} cores, too few for its "
+                    f"instances x {cores_per_instance} cores"
+                )
+            assignment.append((node, nodes[node][first:first + cores_per_instance]))
+            used[node] = first + cores_per_instance
+        return assignment
+
+    try:
+        cores = sorted(os.sched_getaffinity(0))
+    except AttributeError:
+        cores = list(range(os.cpu_count() or 1))
+    if num_instances * cores_per_instance > len(cores):
+        raise ValueError(
+            f"{num_instances} instances x {cores_per_instance} cores exceed "
+            f"{len(cores)} available cores"
+        )
+    return [(-1, cores[i * cores_per_instance:(i + 1) * cores_per_instance]) for i in range(num_instances)]
+
+
+def _pin_thread(cores):
+    """
+    Pin the calling thread and size its TVM thread pool to the given cores.
+    """
+    if not cores:
+        return
+    if hasattr(os, "sched_setaffinity"):
+        os.sched_setaffinity(0, cores)
+    config_threadpool = tvm.get_global_func("runtime.config_threadpool", allow_missing=True)
+    if config_threadpool is not None:
+        # kSpecifyThreadShareAllCore: the thread pool shares this core set
+        config_threadpool(-3, len(cores), [str(core) for core in cores])
+
+
+class _Executor:
+    """
+    One Relax VM instance running on its own (optionally pinned) thread.
+    """
+
+    def __init__(self, module, params, func_name, device, cores):
+        self.func_name = func_name
+        self.device = device
+        self.params = params
+        self.cores = cores
+        self.vm = relax.VirtualMachine(module, device)
+        self._set_input = self.vm.module["set_input"]
+        self._invoke_stateful = self.vm.module["invoke_stateful"]
+        self._get_output = self.vm.module["get_output"]
+        self._thread = ThreadPoolExecutor(max_workers=1, initializer=_pin_thread, initargs=(cores,))
+
+    def _run(self, inputs, outputs):
+        tensors = []
+        for array in inputs:
+            tensor = array if isinstance(array, tvm.runtime.Tensor) else tvm.runtime.from_dlpack(array)
+            if tensor.device != self.device:
+                tensor = tensor.copyto(self.device)
+            tensors.append(tensor)
+
+        self._set_input(self.func_name, *tensors, *self.params)
+        self._invoke_stateful(self.func_name)
+
+        if outputs is None:
+            result = self._get_output(self.func_name)
+            if isinstance(result, tvm.runtime.Tensor):
+                return [result.numpy()]
+            return [item.numpy() for item in result]
+
+        if len(outputs) == 1:
+            self._get_output(self.func_name).copyto(_as_output(outputs[0]))
+        else:
+            for index, output in enumerate(outputs):
+                self._get_output(self.func_name, index).copyto(_as_output(output))
+        return outputs
+
+    def submit(self, inputs, outputs):
+        return self._thread.submit(self._run, inputs, outputs)
+
+    def shutdown(self):
+        self._thread.shutdown(wait=True)
+
+
+class ExecutorPool:
+    """
+    N Relax VM instances sharing one loaded library and one set of weights.
+
+    With numa_local, instances are spread over NUMA nodes and each node gets
+    one replica of the weights in its local memory, shared by the instances
+    on that node, so no instance reads weights across the socket link.
+
+    run() is thread-safe: each call takes an idle instance, runs on that
+    instance's thread and returns it to the pool. The GIL is released while
+    waiting, so callers on several threads run concurrently.
+
+    Usage:
+        pool = ExecutorPool("shared_weights", num_instances=4, cores_per_instance=2)
+        (logits,) = pool.run([image])
+    """
+
+    def __init__(self, work_dir, num_instances=1, cores_per_instance=0, device="cpu", numa_local=False):
+        self.device = tvm.device(device, 0)
+        self.module = tvm.runtime.load_module(os.path.join(work_dir, LIBRARY_FILE))
+        self.manifest, self.params = load_shared_params(work_dir, self.device)
+        self.func_name = self.manifest["func_name"]
+
+        is_cpu = self.device.device_type == tvm.cpu().device_type
+        assignment = _instance_cores(num_instances, cores_per_instance, numa_local and is_cpu)
+        # One weight replica per NUMA node in use
+        self.replicas = {}
+        for node, _ in assignment:
+            if node >= 0 and node not in self.replicas:
+                self.replicas[node] = localize_tensors(self.params, node)
+
+        self.executors = [
+            _Executor(self.module, self.replicas.get(node, self.params), self.func_name, self.device, cores)
+            for node, cores in assignment
+        ]
+        self._idle = queue.Queue()
+        for executor in self.executors:
+            self._idle.put(executor)
+        self._lock = threading.Lock()
+        self._num_runs = 0
+
+    def run(self, inputs, outputs=None):
+        """
+        Run one inference on an idle instance.
+
+        Args:
+            inputs: Runtime inputs (numpy arrays or TVM tensors), without weights
+            outputs: Output buffers written in place (None: return numpy copies)
+
+        Returns:
+            list: Outputs
+        """
+        executor = self._idle.get()
+        try:
+            return executor.submit(inputs, outputs).result()
+        finally:
+            self._idle.put(executor)
+            with self._lock:
+                self._num_runs += 1
+
+    def stats(self):
+        """
+        Pool statistics (instances, shared parameter memory, runs).
+        """
+        return {
+            "num_instances": len(self.executors),
+            "num_params": len(self.params),
+            "param_bytes": sum(_nbytes(p) for p in self.params),
+            "num_replicas": max(1, len(self.replicas)),
+            "num_runs": self._num_runs,
+            "instance_cores": [str(executor.cores) for executor in self.executors],
+        }
+
+    def shutdown(self):
+        """
+        Stop all instance threads.
+        """
+        for executor in self.executors:
+            executor.shutdown()
+
+
+def create_executor_pool(work_dir, num_instances=1, cores_per_instance=0, device="cpu", numa_local=False):
+    """
+    Create an ExecutorPool over the artifacts of export_with_params_as_input.
+    """
+    return ExecutorPool(work_dir, num_instances, cores_per_instance, device, numa_local)
@@ -0,0 +1,190 @@
+"""
+Steady-State Inference with Bound Buffers
+
+Binds caller-owned input and output memory (zero-copy through DLPack) to a
+Relax VM once. For a library compiled in destination-passing style (see
+to_destination_passing), the outputs are trailing parameters of the
+function: the kernels producing the results write straight into the bound
+output buffers, and each inference is one call of a VM closure saved with
+all arguments, so nothing is allocated per run. Other libraries fall back
+to set_input / invoke_stateful and copy the VM's result tensors into the
+bound outputs.
+"""
+
+import tvm
+from tvm import relax
+
+# Name of the VM closure saved with the bound arguments
+_BOUND_FUNCTION = "__bound_inference"
+
+
+def to_destination_passing(relax_mod, func_name="main"):
+    """
+    Rewrite a function to write its results into caller-provided outputs.
+
+    Every returned tensor must be produced by a call_tir (i.e. the module
+    has been legalized, e.g. by the zero pipeline). The function gets one
+    trailing parameter per returned tensor, and each producing call_tir
+    becomes a call_tir_inplace on that parameter, so the VM allocates no
+    result tensors.
+
+    Args:
+        relax_mod: Legalized Relax IRModule
+        func_name: Function to rewrite
+
+    Returns:
+        IRModule: Module whose func_name takes (inputs..., outputs...)
+    """
+    func = relax_mod[func_name]
+    body = func.body
+    values = {binding.var: binding.value for block in body.blocks for binding in block.bindings}
+    results = list(body.body.fields) if isinstance(body.body, relax.Tuple) else [body.body]
+
+    call_tir = tvm.ir.Op.get("relax.call_tir")
+    outputs = {}
+    for index, result in enumerate(results):
+        value = values.get(result)
+        if not isinstance(value, relax.Call) or value.op != call_tir:
+            raise ValueError(f"Result {index} of {func_name} is not produced by a call_tir")
+        if result in outputs:
+            raise ValueError(f"Result {index} of {func_name} is returned twice")
+        outputs[result] = relax.Var(f"output{index}", result.struct_info)
+
+    def rewrite(binding):
+        output = outputs.get(binding.var)
+        if output is None:
+            return binding
+        call = binding.value
+        args = list(call.args[1].fields) + [output]
+        tir_vars = call.args[2] if len(call.args) > 2 else None
+        value = relax.op.call_tir_inplace(call.args[0], args, [len(args) - 1], call.sinfo_args[0], tir_vars)
+        return relax.VarBinding(binding.var, value)
+
+    blocks = []
+    for block in body.blocks:
+        block_type = relax.DataflowBlock if isinstance(block, relax.DataflowBlock) else relax.BindingBlock
+        blocks.append(block_type([rewrite(binding) for binding in block.bindings]))
+
+    params = list(func.params) + [outputs[result] for result in results]
+    new_func = relax.Function(params, relax.SeqExpr(blocks, body.body), func.ret_struct_info, func.is_pure, func.attrs)
+    mod = relax_mod.shallow_copy()
+    mod[func_name] = new_func
+    return mod
+
+
+def _as_tensor(array):
+    """
+    Wrap a writable numpy array as a TVM tensor without copying.
+    """
+    return tvm.runtime.from_dlpack(array)
+
+
+class InferenceSession:
+    """
+    Relax VM with inputs and outputs bound to caller-owned buffers.
+
+    Usage:
+        session = InferenceSession("compiled_lib.so")
+        session.bind([input_array], [output_array])
+        session.run()   # output_array now holds the result
+
+    destination_passing is True when the function takes its outputs as
+    trailing parameters (see to_destination_passing).
+    """
+
+    def __init__(self, lib, func_name="main", device="cpu"):
+        """
+        Args:
+            lib: Path to an exported library or a relax.Executable
+            func_name: Relax function to run
+            device: Device name ("cpu", "cuda", ...)
+        """
+        if isinstance(lib, str):
+            lib = tvm.runtime.load_module(lib)
+        self.func_name = func_name
+        self.device = tvm.device(device, 0)
+        self.vm = relax.VirtualMachine(lib, self.device)
+        self._set_input = self.vm.module["set_input"]
+        self._invoke_stateful = self.vm.module["invoke_stateful"]
+        self._get_output = self.vm.module["get_output"]
+        self._arity = int(self.vm.module["get_function_arity"](func_name))
+        self.destination_passing = False
+        self.inputs = []
+        self.outputs = []
+        self._staged = []
+        self._staged_outputs = []
+        self._bound = None
+
+    def bind(self, inputs, outputs):
+        """
+        Bind input and output buffers (writable numpy arrays or TVM tensors).
+
+        On a CPU session the VM reads the inputs (and, with destination
+        passing, writes the outputs) in place. On other devices each buffer
+        gets a device-side staging tensor that run() refreshes from, or
+        copies back to, the host buffer.
+        """
+        self.destination_passing = self._arity == len(inputs) + len(outputs)
+        if not self.destination_passing and self._arity != len(inputs):
+            raise ValueError(
+                f"{self.func_name} takes {self._arity} arguments; got {len(inputs)} inputs and {len(outputs)} outputs"
+            )
+
+        self.inputs = []
+        self._staged = []
+        for array in inputs:
+            tensor = array if isinstance(array, tvm.runtime.Tensor) else _as_tensor(array)
+            if tensor.device != self.device:
+                staging = tvm.runtime.empty(tensor.shape, tensor.dtype, self.device)
+                self._staged.append((tensor, staging))
+                tensor = staging
+            self.inputs.append(tensor)
+        self.outputs = [
+            array if isinstance(array, tvm.runtime.Tensor) else _as_tensor(array)
+            for array in outputs
+        ]
+
+        if not self.destination_passing:
+            self._bound = None
+            self._set_input(self.func_name, *self.inputs)
+            return
+
+        arguments = list(self.inputs)
+        self._staged_outputs = []
+        for output in self.outputs:
+            if output.device != self.device:
+                staging = tvm.runtime.empty(output.shape, output.dtype, self.device)
+                self._staged_outputs.append((staging, output))
+                output = staging
+            arguments.append(output)
+        self.vm.save_function(self.func_name, _BOUND_FUNCTION, *arguments, include_return=False)
+        self._bound = self.vm.module[_BOUND_FUNCTION]
+
+    def run(self):
+        """
+        Run on the bound inputs and write results into the bound outputs.
+        """
+        if self._staged:
+            for host, staging in self._staged:
+                staging.copyfrom(host)
+        if self._bound is not None:
+            self._bound()
+            if self._staged_outputs:
+                for staging, host in self._staged_outputs:
+                    staging.copyto(host)
+            return
+
+        self._invoke_stateful(self.func_name)
+
+        if len(self.outputs) == 1:
+            self._get_output(self.func_name).copyto(self.outputs[0])
+        else:
+            for index, output in enumerate(self.outputs):
+                self._get_output(self.func_name, index).copyto(output)
+
+
+def create_inference_session(lib_path, func_name="main", device="cpu"):
+    """
+    Create an InferenceSession for a compiled Relax library.
+    """
+    return InferenceSession(lib_path, func_name, device)
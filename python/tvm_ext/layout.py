@@ -0,0 +1,189 @@
+"""
+Blocked NCHW[x]c Layout Packing for Conv-Heavy Graphs
+
+Converts conv2d layers from NCHW/OIHW to the blocked NCHW{c}c / OIHW{c}i{c}o
+layouts used by the x86 conv2d_NCHWc kernels, with the channel block c
+matched to the target's vector width (16 floats for AVX-512, 8 for AVX2).
+Layouts are propagated through the elementwise ops between convolutions
+(batch norm is decomposed first so it does not force a transform back),
+and the layout transforms on constant weights are folded at build time,
+so the compiled module only carries pre-packed weights.
+"""
+
+import time
+import numpy as np
+import tvm
+from tvm import relax, topi
+from .target import create_target
+
+
+def default_block_size(target):
+    """
+    Channel block size for float32 on a target: vector width / 32 bits.
+
+    Args:
+        target: tvm.target.Target (LLVM -mattr is inspected)
+
+    Returns:
+        int: 16 (AVX-512), 8 (AVX/AVX2) or 4 (128-bit SIMD)
+    """
+    mattr = [str(attr).lstrip("+") for attr in target.mattr]
+    if not mattr and target.kind.name == "llvm":
+        from .target import detect_host_cpu
+        mattr = detect_host_cpu()["features"]
+    if "avx512f" in mattr:
+        return 16
+    if "avx2" in mattr or "avx" in mattr:
+        return 8
+    return 4
+
+
+def _packed_layouts(block_size):
+    return f"NCHW{block_size}c", f"OIHW{block_size}i{block_size}o"
+
+
+def _legalize_conv2d(bb, call):
+    """
+    Legalize blocked conv2d with topi conv2d_NCHWc; other layouts use the default rule.
+    """
+    attrs = call.attrs
+    data_layout = str(attrs.data_layout)
+    if len(data_layout) > 4 and str(attrs.out_layout) == data_layout and int(attrs.groups) == 1:
+        out_dtype = str(attrs.out_dtype)
+        if out_dtype in ("", "void"):
+            out_dtype = call.args[0].struct_info.dtype
+        return bb.call_te(
+            topi.nn.conv2d_NCHWc,
+            call.args[0],
+            call.args[1],
+            [int(v) for v in attrs.strides],
+            [int(v) for v in attrs.padding],
+            [int(v) for v in attrs.dilation],
+            data_layout,
+            str(attrs.out_layout),
+            out_dtype,
+            primfunc_name_hint="conv2d_NCHWc",
+        )
+    default = tvm.ir.Op.get("relax.nn.conv2d").get_attr("FLegalize")
+    return default(bb, call)
+
+
+def _count_packed_conv2d(relax_mod):
+    count = 0
+
+    def visit(expr):
+        nonlocal count
+        if (
+            isinstance(expr, relax.Call)
+            and isinstance(expr.op, tvm.ir.Op)
+            and expr.op.name == "relax.nn.conv2d"
+            and len(str(expr.attrs.data_layout)) > 4
+        ):
+            count += 1
+
+    for func in relax_mod.functions.values():
+        if isinstance(func, relax.Function):
+            relax.analysis.post_order_visit(func, visit)
+    return count
+
+
+def pack_conv_layout(relax_mod, block_size):
+    """
+    Convert conv2d layers to NCHW{block}c and pre-pack constant weights.
+
+    ConvertLayout keeps NCHW for convolutions whose channels do not divide
+    by the block (e.g. an RGB stem). The result is legalized; run it through
+    the zero pipeline as usual afterwards.
+
+    Args:
+        relax_mod: Relax IRModule (before the zero pipeline)
+        block_size: Channel block (e.g., default_block_size(target))
+
+    Returns:
+        tuple: (packed module, number of packed conv2d layers)
+    """
+    data_layout, kernel_layout = _packed_layouts(int(block_size))
+    relax_mod = tvm.transform.Sequential([
+        relax.transform.DecomposeOpsForInference(),
+        relax.transform.FoldConstant(),
+        relax.transform.ConvertLayout({"relax.nn.conv2d": [data_layout, kernel_layout]}),
+        relax.transform.Normalize(),
+    ])(relax_mod)
+    num_packed = _count_packed_conv2d(relax_mod)
+
+    relax_mod = relax.transform.LegalizeOps(customize_legalize_map={"relax.nn.conv2d": _legalize_conv2d})(relax_mod)
+    # Layout transforms of constant weights become pre-packed constants
+    relax_mod = relax.transform.FoldConstant()(relax_mod)
+    return relax_mod, num_packed
+
+
+def _time_module(relax_mod, target, inputs, num_runs, num_warmup=3):
+    with target:
+        relax_mod = relax.get_pipeline("zero")(relax_mod)
+    vm = relax.VirtualMachine(relax.build(relax_mod, target), tvm.cpu())
+    for _ in range(num_warmup):
+        output = vm["main"](*inputs)
+    times = []
+    for _ in range(num_runs):
+        start = time.perf_counter()
+        output = vm["main"](*inputs)
+        times.append((time.perf_counter() - start) * 1000.0)
+    if not isinstance(output, tvm.runtime.Tensor):
+        output = output[0]
+    return float(np.mean(times)), float(np.median(times)), output.numpy()
+
+
+def compare_layout_packing(relax_mod_ir="", target_name="llvm", block_size=0, num_runs=20):
+    """
+    Measure a module with and without NCHW[x]c packing (untuned).
+
+    Args:
+        relax_mod_ir: Relax module IR JSON ("" = pretrained ResNet18)
+        target_name: Target name (e.g., "llvm")
+        block_size: Channel block (0 = from the target's vector width)
+        num_runs: Timed runs per build
+
+    Returns:
+        dict: status, block_size, data_layout, kernel_layout, num_packed_conv2d,
+            nchw/packed mean_ms and p50_ms, speedup and max_rel_error
+    """
+    from .profiling import _random_inputs
+
+    try:
+        if relax_mod_ir:
+            relax_mod = tvm.ir.load_json(relax_mod_ir)
+        else:
+            from .resnet_schedule import create_resnet18_relax_mod
+            relax_mod = create_resnet18_relax_mod(pretrained=True)
+
+        target = create_target(target_name)
+        if block_size <= 0:
+            block_size = default_block_size(target)
+        inputs = _random_inputs(relax_mod["main"], tvm.cpu())
+
+        nchw_mean, nchw_p50, nchw_out = _time_module(relax_mod, target, inputs, num_runs)
+        packed_mod, num_packed = pack_conv_layout(relax_mod, block_size)
+        packed_mean, packed_p50, packed_out = _time_module(packed_mod, target, inputs, num_runs)
+
+        scale = float(np.max(np.abs(nchw_out))) or 1.0
+        data_layout, kernel_layout = _packed_layouts(block_size)
+        return {
+            "status": "success",
+            "target": str(target),
+            "block_size": block_size,
+            "data_layout": data_layout,
+            "kernel_layout": kernel_layout,
+            "num_packed_conv2d": num_packed,
+            "nchw_mean_ms": nchw_mean,
+            "nchw_p50_ms": nchw_p50,
+            "packed_mean_ms": packed_mean,
+            "packed_p50_ms": packed_p50,
+            "speedup": nchw_mean / packed_mean if packed_mean > 0 else 0.0,
+            "max_rel_error": float(np.max(np.abs(nchw_out - packed_out))) / scale,
+        }
+
+    except Exception as e:
+        return {
+            "status": "error",
+            "error": str(e)
+        }
@@ -0,0 +1,257 @@
+"""
+Static Memory Planning Reports
+
+Runs Relax's StaticPlanBlockMemory on a compiled module's Relax function
+and reports what it planned: storage tokens and their sizes, the tensors
+placed in each (reuse), allocations left to the runtime (outputs, dynamic
+shapes) and the peak of live tensor bytes over the program. An optional
+runtime check runs the built module with a VM instrument that records
+every storage allocation, and compares it (and the RSS growth of the first
+run) with the plan.
+"""
+
+import time
+import numpy as np
+import tvm
+from tvm import relax
+from .relax_pipeline import static_memory_planning, run_relax_pipeline
+from .target import create_target
+from .timing import current_rss_kb
+
+
+def _static_bytes(shape_expr, dtype):
+    """
+    Bytes of a ShapeExpr of the given dtype, or None for symbolic shapes.
+    """
+    if not isinstance(shape_expr, relax.ShapeExpr):
+        return None
+    count = 1
+    for dim in shape_expr.values:
+        if not isinstance(dim, tvm.tir.IntImm):
+            return None
+        count *= int(dim)
+    dtype = tvm.runtime.DataType(dtype)
+    return count * ((dtype.bits * dtype.lanes + 7) // 8)
+
+
+def _op_name(expr):
+    if isinstance(expr, relax.Call) and isinstance(expr.op, tvm.ir.Op):
+        return expr.op.name
+    return None
+
+
+def analyze_memory_plan(planned_mod, func_name="main", top_k=5):
+    """
+    Summarize the static memory plan of a Relax function.
+
+    Args:
+        planned_mod: Module after StaticPlanBlockMemory (see plan_memory)
+        func_name: Relax function to analyze
+        top_k: Number of largest storage tokens to list
+
+    Returns:
+        dict: planned_bytes (sum of storage tokens), requested_bytes (sum of
+            tensors placed in them), unplanned_bytes (tensors left to the
+            runtime allocator), peak_live_bytes (largest sum of simultaneously
+            live tensors), num_storage_tokens, num_planned_tensors,
+            num_unplanned_tensors, num_dynamic_allocations, reuse_ratio
+            (requested / planned), plan_efficiency (peak_live / planned +
+            unplanned) and largest_allocations (storage, bytes, tensors)
+    """
+    func = planned_mod[func_name]
+    bindings = []
+    for block in func.body.blocks:
+        bindings.extend(block.bindings)
+
+    storages = {}        # storage var -> {"bytes", "tensors"}
+    tensors = {}         # tensor var -> bytes
+    defined_at = {}
+    num_planned = 0
+    num_unplanned = 0
+    num_dynamic = 0
+    requested_bytes = 0
+    unplanned_bytes = 0
+
+    for index, binding in enumerate(bindings):
+        value = binding.value
+        op = _op_name(value)
+        if op == "relax.memory.alloc_storage":
+            nbytes = _static_bytes(value.args[0], "uint8")
+            if nbytes is None:
+                num_dynamic += 1
+                continue
+            storages[binding.var] = {"bytes": nbytes, "tensors": []}
+        elif op == "relax.memory.alloc_tensor":
+            nbytes = _static_bytes(value.args[2], str(value.args[3].value))
+            if nbytes is None:
+                num_dynamic += 1
+                continue
+            num_planned += 1
+            requested_bytes += nbytes
+            tensors[binding.var] = nbytes
+            defined_at[binding.var] = index
+            if value.args[0] in storages:
+                storages[value.args[0]]["tensors"].append(binding.var.name_hint)
+        elif op == "relax.builtin.alloc_tensor":
+            nbytes = _static_bytes(value.args[0], str(value.args[1].value))
+            if nbytes is None:
+                num_dynamic += 1
+                continue
+            num_unplanned += 1
+            unplanned_bytes += nbytes
+            tensors[binding.var] = nbytes
+            defined_at[binding.var] = index
+
+    # A tensor is live from its allocation to its last use (the end if returned)
+    last_use = dict(defined_at)
+    for index, binding in enumerate(bindings):
+        for var in relax.analysis.free_vars(binding.value):
+            if var in last_use:
+                last_use[var] = max(last_use[var], index)
+    for var in relax.analysis.free_vars(func.body.body):
+        if var in last_use:
+            last_use[var] = len(bindings)
+
+    delta = np.zeros(len(bindings) + 2, dtype=np.int64)
+    for var, nbytes in tensors.items():
+        delta[defined_at[var]] += nbytes
+        delta[last_use[var] + 1] -= nbytes
+    peak_live_bytes = int(np.max(np.cumsum(delta))) if tensors else 0
+
+    planned_bytes = sum(s["bytes"] for s in storages.values())
+    largest = sorted(storages.items(), key=lambda item: item[1]["bytes"], reverse=True)[:top_k]
+    total = planned_bytes + unplanned_bytes
+    return {
+        "function": func_name,
+        "planned_bytes": planned_bytes,
+        "requested_bytes": requested_bytes,
+        "unplanned_bytes": unplanned_bytes,
+        "peak_live_bytes": peak_live_bytes,
+        "num_storage_tokens": len(storages),
+        "num_planned_tensors": num_planned,
+        "num_unplanned_tensors": num_unplanned,
+        "num_dynamic_allocations": num_dynamic,
+        "reuse_ratio": requested_bytes / planned_bytes if planned_bytes else 0.0,
+        "plan_efficiency": peak_live_bytes / total if total else 0.0,
+        "largest_allocations": [
+            {"storage": var.name_hint, "bytes": s["bytes"], "tensors": s["tensors"]} for var, s in largest
+        ],
+    }
+
+
+def plan_memory(relax_mod, target):
+    """
+    Lower a legalized module to the form relax.build plans and run StaticPlanBlockMemory.
+
+    Modules that are already planned (e.g. the "full" pipeline) pass through unchanged.
+    """
+    with target:
+        return static_memory_planning()(relax_mod)
+
+
+def _as_shape(arg):
+    # Shape arguments of VM builtins are sequences of ints
+    if isinstance(arg, str):
+        return None
+    try:
+        return [int(v) for v in arg]
+    except (TypeError, ValueError):
+        return None
+
+
+def check_runtime_memory(ex, inputs, func_name="main", num_runs=3):
+    """
+    Record the storage the VM allocates per run of a built module.
+
+    Returns:
+        dict: runtime_storage_bytes and runtime_num_allocations (per run),
+            runtime_rss_delta_kb (RSS growth over the first run, includes
+            allocator pooling) and runtime_ms (mean of the instrumented runs)
+    """
+    vm = relax.VirtualMachine(ex, tvm.cpu())
+    allocated = []
+
+    def instrument(func, func_symbol, before_run, ret_value, *args):
+        if before_run and func_symbol == "vm.builtin.alloc_storage":
+            for arg in args:
+                shape = _as_shape(arg)
+                if shape:
+                    allocated.append(int(np.prod(shape, dtype=np.int64)))
+                    break
+
+    vm.set_instrument(instrument)
+    rss_before = current_rss_kb()
+    vm[func_name](*inputs)
+    rss_delta_kb = max(0, current_rss_kb() - rss_before)
+
+    per_run = []
+    times = []
+    for _ in range(num_runs):
+        allocated.clear()
+        start = time.perf_counter()
+        vm[func_name](*inputs)
+        times.append((time.perf_counter() - start) * 1000.0)
+        per_run.append((sum(allocated), len(allocated)))
+    storage_bytes, num_allocations = max(per_run) if per_run else (sum(allocated), len(allocated))
+    return {
+        "runtime_storage_bytes": storage_bytes,
+        "runtime_num_allocations": num_allocations,
+        "runtime_rss_delta_kb": rss_delta_kb,
+        "runtime_ms": float(np.mean(times)) if times else 0.0,
+    }
+
+
+def memory_plan_report(
+    relax_mod_ir="",
+    target_name="llvm",
+    pipeline="zero",
+    top_k=5,
+    check_runtime=False,
+    num_runs=3
+):
+    """
+    Memory-planning report of a module as compile_with_metaschedule builds it.
+
+    Args:
+        relax_mod_ir: Relax module IR JSON ("" = pretrained ResNet18)
+        target_name: Target name (e.g., "llvm")
+        pipeline: Relax pipeline preset or pass list (see relax_pipeline)
+        top_k: Number of largest storage tokens to list
+        check_runtime: Build and run the module and compare the storage the
+            VM allocates with the plan
+        num_runs: Instrumented runs for the runtime check
+
+    Returns:
+        dict: status, target and the fields of analyze_memory_plan; with
+            check_runtime also those of check_runtime_memory and within_plan
+            (runtime storage <= planned + unplanned bytes)
+    """
+    from .profiling import _random_inputs
+
+    try:
+        if relax_mod_ir:
+            relax_mod = tvm.ir.load_json(relax_mod_ir)
+        else:
+            from .resnet_schedule import create_resnet18_relax_mod
+            relax_mod = create_resnet18_relax_mod(pretrained=True)
+
+        target = create_target(target_name)
+        inputs = _random_inputs(relax_mod["main"], tvm.cpu())
+        relax_mod, _ = run_relax_pipeline(relax_mod, target, pipeline, report=False)
+
+        result = {"status": "success", "target": str(target)}
+        result.update(analyze_memory_plan(plan_memory(relax_mod, target), "main", top_k))
+
+        result["runtime_checked"] = bool(check_runtime)
+        if check_runtime:
+            result.update(check_runtime_memory(relax.build(relax_mod, target), inputs, "main", num_runs))
+            result["within_plan"] = (
+                result["runtime_storage_bytes"] <= result["planned_bytes"] + result["unplanned_bytes"]
+            )
+        return result
+
+    except Exception as e:
+        return {
+            "status": "error",
+            "error": str(e)
+        }
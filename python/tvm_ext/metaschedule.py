@@ -3,9 +3,33 @@ TVM MetaSchedule Functions for C++ Integration
 """
 
 import os
+from contextlib import ExitStack
 import tvm
 from tvm import relax
 import multiprocessing
+from .target import create_target
+from .database import indexed_database, normalize_shash, repair_json_database, select_by_confidence, workload_stats
+from .rpc_farm import LocalRPCFarm, pinned_to_cores
+from .timing import PhaseTimer, count_tuning_tasks
+from .relax_pipeline import resolve_pipeline, run_relax_pipeline
+
+# Record rankings of apply_tuning_database
+RECORD_RANKINGS = ("mean", "upper_ci")
+
+
+def _timing_result(timer, trace_path, work_dir, num_tasks):
+    """
+    Collect phase timings, task/record counts and the optional trace file.
+    """
+    stats = workload_stats(work_dir) if work_dir and os.path.isdir(work_dir) else {}
+    result = {
+        "phases": timer.to_list(),
+        "num_tasks": num_tasks,
+        "num_records": sum(s["num_records"] for s in stats.values()),
+    }
+    if trace_path:
+        result["trace_path"] = timer.write_chrome_trace(trace_path)
+    return result
 
 
 def tune_with_metaschedule(
@@ -13,39 +37,55 @@ def tune_with_metaschedule(
     target_name="llvm",
     num_trials=64,
     max_workers=None,
-    work_dir="tuning_database"
+    work_dir="tuning_database",
+    rpc_servers=0,
+    cores_per_server=1,
+    trace_path="",
+    pipeline="zero"
 ):
     """
     Tune TVM Relax module using MetaSchedule.
 
+    With rpc_servers > 0, a local RPC tracker and that many RPC servers are
+    started, each pinned to its own `cores_per_server` cores. Measurements go
+    through an RPCRunner over them, and builder processes are restricted to
+    the remaining cores.
+
     Args:
         relax_mod_ir: Relax module IR string
         target_name: Target name (e.g., "llvm", "cuda")
         num_trials: Maximum number of trials for tuning
         max_workers: Number of parallel workers (default: CPU count)
         work_dir: Directory to store tuning database
+        rpc_servers: Number of local RPC measurement servers (0 = local runner)
+        cores_per_server: Cores pinned to each RPC server
+        trace_path: Write phase timings as a Chrome trace to this path (optional)
+        pipeline: Relax pipeline preset or pass list (see relax_pipeline);
+            must match the one used to compile
 
     Returns:
-        dict: Tuning results with status and work_dir
+        dict: Tuning results with status, work_dir, per-phase timings and
+            per-pass reports ("passes")
     """
     import tvm.meta_schedule as ms
     from tvm.meta_schedule.builder import LocalBuilder
     from tvm.ir.transform import PassContext
 
     try:
+        timer = PhaseTimer()
+
         # Parse IR string to module
-        relax_mod = tvm.ir.load_json(relax_mod_ir)
+        with timer.phase("parse_ir"):
+            relax_mod = tvm.ir.load_json(relax_mod_ir)
 
         # Setup target
         num_cores = multiprocessing.cpu_count()
-        if "llvm" in target_name:
-            target = tvm.target.Target(f"llvm -num-cores {num_cores}")
-        else:
-            target = tvm.target.Target(target_name)
+        target = create_target(target_name)
 
-        # Apply zero pipeline
-        with target:
-            relax_mod = relax.get_pipeline("zero")(relax_mod)
+        # Apply Relax pipeline
+        pipeline_name, _ = resolve_pipeline(pipeline)
+        with timer.phase(f"{pipeline_name}_pipeline"):
+            relax_mod, pass_reports = run_relax_pipeline(relax_mod, target, pipeline)
 
         # Setup work directory
         os.makedirs(work_dir, exist_ok=True)
@@ -54,27 +94,47 @@ def tune_with_metaschedule(
         if max_workers is None:
             max_workers = num_cores
 
-        # Create builder
-        builder = LocalBuilder(max_workers=max_workers)
+        # Reserve cores for the RPC measurement farm
+        farm = None
+        if rpc_servers > 0:
+            farm = LocalRPCFarm(rpc_servers, cores_per_server)
+            max_workers = min(max_workers, len(farm.builder_cores))
+
+        with ExitStack() as stack:
+            runner = "local"
+            if farm is not None:
+                with timer.phase("start_rpc_farm"):
+                    stack.enter_context(farm)
+                stack.enter_context(pinned_to_cores(farm.builder_cores))
+                runner = farm.create_runner()
+
+            # Create builder
+            builder = LocalBuilder(max_workers=max_workers)
 
-        # Run MetaSchedule tuning
-        with target:
-            ms.tune_tir(
-                mod=relax_mod,
-                target=target,
-                work_dir=work_dir,
-                max_trials_global=num_trials,
-                builder=builder,
-                num_tuning_cores=max_workers,
-            )
+            # Run MetaSchedule tuning
+            with timer.phase("tune"), target:
+                ms.tune_tir(
+                    mod=relax_mod,
+                    target=target,
+                    work_dir=work_dir,
+                    max_trials_global=num_trials,
+                    builder=builder,
+                    runner=runner,
+                    num_tuning_cores=max_workers,
+                )
 
-        return {
+        result = {
             "status": "success",
             "work_dir": work_dir,
             "num_trials": num_trials,
             "max_workers": max_workers,
+            "rpc_servers": rpc_servers,
+            "pipeline": pipeline_name,
+            "passes": pass_reports,
             "target": str(target)
         }
+        result.update(_timing_result(timer, trace_path, work_dir, count_tuning_tasks(relax_mod)))
+        return result
 
     except Exception as e:
         return {
@@ -87,7 +147,9 @@ def apply_tuning_database(
     relax_mod_ir,
     target_name="llvm",
     work_dir="tuning_database",
-    opt_level=0
+    opt_level=0,
+    trace_path="",
+    rank_by="mean"
 ):
     """
     Apply tuning database to Relax module and build.
@@ -97,42 +159,71 @@ def apply_tuning_database(
         target_name: Target name (e.g., "llvm", "cuda")
         work_dir: Directory containing tuning database
         opt_level: Optimization level (0-3)
+        trace_path: Write phase timings as a Chrome trace to this path (optional)
+        rank_by: "mean" (the record with the lowest mean, looked up
+            through the database index, see database.indexed_database) or
+            "upper_ci" (per workload the record with the lowest upper
+            confidence bound, see database.select_by_confidence)
 
     Returns:
-        dict: Build results with compiled module path
+        dict: Build results with compiled module path and per-phase timings
     """
     from tvm.ir.transform import PassContext
 
     try:
+        if rank_by not in RECORD_RANKINGS:
+            raise ValueError(f"Unknown record ranking: {rank_by} (expected one of {RECORD_RANKINGS})")
+
+        timer = PhaseTimer()
+
         # Parse IR string to module
-        relax_mod = tvm.ir.load_json(relax_mod_ir)
+        with timer.phase("parse_ir"):
+            relax_mod = tvm.ir.load_json(relax_mod_ir)
 
         # Setup target
-        num_cores = multiprocessing.cpu_count()
-        if "llvm" in target_name:
-            target = tvm.target.Target(f"llvm -num-cores {num_cores}")
+        target = create_target(target_name)
+
+        # Apply only the best record per workload instead of loading every record
+        num_with_interval = 0
+        if rank_by == "mean":
+            with timer.phase("index_lookup"):
+                selected = indexed_database(work_dir, os.path.join(work_dir, "indexed"))
+            if selected["status"] != "success":
+                raise RuntimeError(selected["error"])
+            database_dir = selected["output_dir"]
         else:
-            target = tvm.target.Target(target_name)
+            with timer.phase("select_by_confidence"):
+                selected = select_by_confidence(work_dir, os.path.join(work_dir, "ci_selected"))
+            if selected["status"] != "success":
+                raise RuntimeError(selected["error"])
+            database_dir = selected["output_dir"]
+            num_with_interval = selected["num_with_interval"]
 
         # Apply tuning database
-        with target, PassContext(opt_level=opt_level):
-            application_pass = relax.transform.MetaScheduleApplyDatabase(work_dir)
+        with timer.phase("apply_database"), target, PassContext(opt_level=opt_level):
+            application_pass = relax.transform.MetaScheduleApplyDatabase(database_dir)
             relax_mod = application_pass(relax_mod)
 
         # Build the module
-        ex = relax.build(relax_mod, target)
+        with timer.phase("relax_build"):
+            ex = relax.build(relax_mod, target)
 
         # Save the built module
         lib_path = os.path.join(work_dir, "compiled_lib.so")
-        ex.export_library(lib_path)
+        with timer.phase("export_library"):
+            ex.export_library(lib_path)
 
-        return {
+        result = {
             "status": "success",
             "lib_path": lib_path,
             "work_dir": work_dir,
             "opt_level": opt_level,
+            "rank_by": rank_by,
+            "num_with_interval": num_with_interval,
             "target": str(target)
         }
+        result.update(_timing_result(timer, trace_path, work_dir, count_tuning_tasks(relax_mod)))
+        return result
 
     except Exception as e:
         return {
@@ -148,11 +239,29 @@ def compile_with_metaschedule(
     num_trials=64,
     max_workers=None,
     work_dir="tuning_database",
-    opt_level=0
+    opt_level=0,
+    trace_path="",
+    precision="float32",
+    allow_ops=None,
+    deny_ops=None,
+    pack_layout=False,
+    layout_block=0,
+    backend="tvm",
+    offload_ops=None,
+    pipeline="zero",
+    destination_passing=False
 ):
     """
     Complete compilation pipeline with optional MetaSchedule tuning.
 
+    With precision "bfloat16" or "float16", allowed layers are converted to
+    low-precision storage with float32 accumulation before the zero
+    pipeline (see mixed_precision.to_mixed_precision). With pack_layout,
+    conv2d layers are converted to NCHW[x]c with pre-packed weights (see
+    layout.pack_conv_layout). With backend "dnnl", conv2d/dense/pooling
+    layers are offloaded to oneDNN and only the rest is tuned (see
+    byoc.partition_for_dnnl).
+
     Args:
         relax_mod_ir: Relax module IR string
         target_name: Target name (e.g., "llvm", "cuda")
@@ -161,24 +270,70 @@ def compile_with_metaschedule(
         max_workers: Number of parallel workers
         work_dir: Directory to store tuning database
         opt_level: Optimization level (0-3)
+        trace_path: Write phase timings as a Chrome trace to this path (optional)
+        precision: "float32" (default), "bfloat16" or "float16"
+        allow_ops: Operators to convert (default: conv1d, conv2d, matmul)
+        deny_ops: Operators or layer names kept in float32
+        pack_layout: Convert conv2d layers to blocked NCHW[x]c layouts
+        layout_block: Channel block for pack_layout (0 = target vector width)
+        backend: "tvm" (default) or "dnnl"
+        offload_ops: Op groups offloaded by the dnnl backend (default: conv2d, dense, pool)
+        pipeline: Relax pipeline preset or pass list (see relax_pipeline);
+            must match the one used to tune
+        destination_passing: main takes its outputs as trailing parameters
+            and writes them in place (see inference.to_destination_passing)
 
     Returns:
-        dict: Compilation results
+        dict: Compilation results with per-phase timings and per-pass
+            reports ("passes")
     """
     try:
+        timer = PhaseTimer()
+
         # Parse IR string to module
-        relax_mod = tvm.ir.load_json(relax_mod_ir)
+        with timer.phase("parse_ir"):
+            relax_mod = tvm.ir.load_json(relax_mod_ir)
 
         # Setup target
         num_cores = multiprocessing.cpu_count()
-        if "llvm" in target_name:
-            target = tvm.target.Target(f"llvm -num-cores {num_cores}")
-        else:
-            target = tvm.target.Target(target_name)
+        target = create_target(target_name)
+
+        if backend not in ("tvm", "dnnl"):
+            raise ValueError(f"Unknown backend: {backend} (expected 'tvm' or 'dnnl')")
+        if backend == "dnnl" and pack_layout:
+            raise ValueError("pack_layout cannot be combined with the dnnl backend (oneDNN picks its own layouts)")
+
+        # The library is exported to work_dir with or without tuning
+        os.makedirs(work_dir, exist_ok=True)
 
-        # Apply zero pipeline
-        with target:
-            relax_mod = relax.get_pipeline("zero")(relax_mod)
+        # Mixed precision (opt-in)
+        converted_layers = []
+        if precision != "float32":
+            from .mixed_precision import to_mixed_precision
+            with timer.phase("mixed_precision"):
+                relax_mod, converted_layers = to_mixed_precision(relax_mod, precision, allow_ops, deny_ops)
+
+        # Blocked conv layouts (opt-in)
+        num_packed = 0
+        if pack_layout:
+            from .layout import default_block_size, pack_conv_layout
+            if layout_block <= 0:
+                layout_block = default_block_size(target)
+            with timer.phase("pack_layout"):
+                relax_mod, num_packed = pack_conv_layout(relax_mod, layout_block)
+
+        # DNNL offload (opt-in); partitioned layers are no tuning tasks
+        offloaded = {}
+        if backend == "dnnl":
+            from .byoc import partition_for_dnnl
+            with timer.phase("partition_dnnl"):
+                relax_mod, offloaded = partition_for_dnnl(relax_mod, offload_ops)
+
+        # Apply Relax pipeline
+        pipeline_name, _ = resolve_pipeline(pipeline)
+        with timer.phase(f"{pipeline_name}_pipeline"):
+            relax_mod, pass_reports = run_relax_pipeline(relax_mod, target, pipeline)
+        num_tasks = count_tuning_tasks(relax_mod)
 
         # MetaSchedule tuning (if enabled)
         if use_auto_tuning:
@@ -186,14 +341,12 @@ def compile_with_metaschedule(
             from tvm.meta_schedule.builder import LocalBuilder
             from tvm.ir.transform import PassContext
 
-            os.makedirs(work_dir, exist_ok=True)
-
             if max_workers is None:
                 max_workers = num_cores
 
             builder = LocalBuilder(max_workers=max_workers)
 
-            with target:
+            with timer.phase("tune"), target:
                 ms.tune_tir(
                     mod=relax_mod,
                     target=target,
@@ -204,26 +357,43 @@ def compile_with_metaschedule(
                 )
 
             # Apply database
-            with target, PassContext(opt_level=opt_level):
+            with timer.phase("apply_database"), target, PassContext(opt_level=opt_level):
                 application_pass = relax.transform.MetaScheduleApplyDatabase(work_dir)
                 relax_mod = application_pass(relax_mod)
 
+        if destination_passing:
+            from .inference import to_destination_passing
+            relax_mod = to_destination_passing(relax_mod)
+
         # Build
-        ex = relax.build(relax_mod, target)
+        with timer.phase("relax_build"):
+            ex = relax.build(relax_mod, target)
 
         # Save
         lib_path = os.path.join(work_dir, "compiled_lib.so")
-        ex.export_library(lib_path)
+        with timer.phase("export_library"):
+            ex.export_library(lib_path)
 
-        return {
+        result = {
             "status": "success",
             "lib_path": lib_path,
             "work_dir": work_dir,
             "auto_tuning": use_auto_tuning,
             "num_trials": num_trials if use_auto_tuning else 0,
             "opt_level": opt_level,
+            "precision": precision,
+            "num_converted_layers": len(converted_layers),
+            "layout_block": layout_block if pack_layout else 0,
+            "num_packed_conv2d": num_packed,
+            "backend": backend,
+            "num_offloaded": sum(offloaded.values()),
+            "pipeline": pipeline_name,
+            "passes": pass_reports,
+            "destination_passing": destination_passing,
             "target": str(target)
         }
+        result.update(_timing_result(timer, trace_path, work_dir, num_tasks))
+        return result
 
     except Exception as e:
         return {
@@ -232,11 +402,187 @@ def compile_with_metaschedule(
         }
 
 
-def create_simple_relax_ir():
+def _tune_incremental_mod(
+    relax_mod,
+    target,
+    num_trials,
+    target_trials_per_task,
+    max_workers,
+    work_dir,
+    convergence_window=32,
+    convergence_tol=0.01
+):
+    """
+    Tune the tasks of a pipelined module that the database in work_dir does not cover yet.
+
+    Returns:
+        dict: Counts as returned by tune_incremental plus "tasks", a list of
+            (task name, workload shash, skipped, new records of the workload)
+            per extracted task
+    """
+    import tvm.meta_schedule as ms
+    from tvm.meta_schedule.builder import LocalBuilder
+
+    # Drop records cut off by a previous crash before reading the database
+    os.makedirs(work_dir, exist_ok=True)
+    repaired_files = repair_json_database(work_dir)
+    stats = workload_stats(work_dir, convergence_window, convergence_tol)
+    existing_records = sum(s["num_records"] for s in stats.values())
+
+    # Select tasks that still need trials
+    extracted_tasks = ms.relax_integration.extract_tasks(relax_mod, target)
+    pending_tasks = []
+    remaining_trials = []
+    task_list = []
+    for task in extracted_tasks:
+        shash = normalize_shash(tvm.ir.structural_hash(task.dispatched[0]))
+        task_stats = stats.get(shash)
+        num_records = task_stats["num_records"] if task_stats else 0
+
+        skipped = bool(task_stats and (task_stats["converged"] or num_records >= target_trials_per_task))
+        task_list.append((task.task_name, shash, skipped))
+        if skipped:
+            continue
+
+        pending_tasks.append(task)
+        remaining_trials.append(target_trials_per_task - num_records)
+
+    trials_budget = min(num_trials, sum(remaining_trials))
+
+    if pending_tasks and trials_budget > 0:
+        if not max_workers:
+            max_workers = multiprocessing.cpu_count()
+
+        # tune_tasks only takes one per-task cap, so tasks are tuned in groups
+        # of equal remaining trials (least tuned first) to cap each task at
+        # its own remaining count
+        groups = {}
+        for task, remaining in zip(pending_tasks, remaining_trials):
+            groups.setdefault(remaining, []).append(task)
+
+        budget_left = trials_budget
+        for remaining in sorted(groups, reverse=True):
+            if budget_left <= 0:
+                break
+            group = groups[remaining]
+            tasks, task_weights = ms.relax_integration.extracted_tasks_to_tune_contexts(
+                extracted_tasks=group,
+                work_dir=work_dir,
+                num_tuning_cores=max_workers,
+            )
+            before = sum(s["num_records"] for s in workload_stats(work_dir).values())
+            with target:
+                ms.tune_tasks(
+                    tasks=tasks,
+                    task_weights=task_weights,
+                    work_dir=work_dir,
+                    max_trials_global=min(budget_left, remaining * len(group)),
+                    max_trials_per_task=remaining,
+                    builder=LocalBuilder(max_workers=max_workers),
+                    database=ms.database.JSONDatabase(work_dir=work_dir),
+                )
+            budget_left -= sum(s["num_records"] for s in workload_stats(work_dir).values()) - before
+
+    final_stats = workload_stats(work_dir)
+    total_records = sum(s["num_records"] for s in final_stats.values())
+    def records_of(all_stats, shash):
+        return all_stats[shash]["num_records"] if shash in all_stats else 0
+
+    task_list = [
+        (task_name, shash, skipped, records_of(final_stats, shash) - records_of(stats, shash))
+        for task_name, shash, skipped in task_list
+    ]
+
+    return {
+        "num_tasks": len(extracted_tasks),
+        "skipped_tasks": len(extracted_tasks) - len(pending_tasks),
+        "tuned_tasks": len(pending_tasks) if trials_budget > 0 else 0,
+        "trials_budget": trials_budget,
+        "existing_records": existing_records,
+        "new_records": total_records - existing_records,
+        "repaired_files": repaired_files,
+        "tasks": task_list,
+    }
+
+
+def tune_incremental(
+    relax_mod_ir,
+    target_name="llvm",
+    num_trials=64,
+    target_trials_per_task=64,
+    max_workers=None,
+    work_dir="tuning_database",
+    convergence_window=32,
+    convergence_tol=0.01,
+    pipeline="zero"
+):
+    """
+    Resume MetaSchedule tuning from the existing database in work_dir.
+
+    Tasks whose workload already has `target_trials_per_task` records or has
+    converged are skipped; the new budget is spent only on untuned or
+    under-tuned tasks. Records are appended to the same JSON database, so an
+    interrupted run can be resumed by calling this again.
+
+    Args:
+        relax_mod_ir: Relax module IR string
+        target_name: Target name (e.g., "llvm", "cuda")
+        num_trials: Maximum number of new trials for this run
+        target_trials_per_task: Trials after which a task counts as tuned
+        max_workers: Number of parallel workers (None or 0: CPU count)
+        work_dir: Directory of the tuning database to resume
+        convergence_window: Recent records checked for improvement (0 disables)
+        convergence_tol: Relative improvement below which a task has converged
+        pipeline: Relax pipeline preset or pass list (see relax_pipeline)
+
+    Returns:
+        dict: Tuning results with skipped/tuned task counts and record totals
+    """
+    try:
+        # Parse IR string to module
+        relax_mod = tvm.ir.load_json(relax_mod_ir)
+
+        # Setup target
+        target = create_target(target_name)
+
+        # Apply Relax pipeline
+        relax_mod, _ = run_relax_pipeline(relax_mod, target, pipeline, report=False)
+
+        result = {
+            "status": "success",
+            "work_dir": work_dir,
+            "target": str(target),
+        }
+        result.update(_tune_incremental_mod(
+            relax_mod,
+            target,
+            num_trials,
+            target_trials_per_task,
+            max_workers,
+            work_dir,
+            convergence_window,
+            convergence_tol,
+        ))
+        del result["tasks"]
+        return result
+
+    except Exception as e:
+        return {
+            "status": "error",
+            "error": str(e)
+        }
+
+
+def create_simple_relax_ir(with_params=False):
     """
     Create a simple Relax IR for testing MetaSchedule.
     Creates a simple matrix multiplication module.
 
+    Args:
+        with_params: Treat `y` as a weight: attach a random value as the
+            function's "params" attribute with num_input=1, as the PyTorch
+            frontend does with keep_params_as_input=True
+
     Returns:
         str: Relax module IR as JSON string
     """
@@ -270,8 +616,16 @@ def create_simple_relax_ir():
                 R.output(lv0)
             return lv0
 
+    mod = SimpleMatmul
+    if with_params:
+        import numpy as np
+
+        weight = np.random.uniform(-1.0, 1.0, size=(128, 128)).astype("float32")
+        main = mod["main"].with_attr("num_input", 1).with_attr("params", [tvm.runtime.tensor(weight)])
+        mod = tvm.IRModule({gv: (main if gv.name_hint == "main" else func) for gv, func in mod.functions.items()})
+
     # Convert to JSON string
-    return tvm.ir.save_json(SimpleMatmul)
+    return tvm.ir.save_json(mod)
 
 
 def get_metaschedule_config():
@@ -293,13 +647,14 @@ def get_metaschedule_config():
 
 def check_tuning_database(work_dir="tuning_database"):
     """
-    Check if tuning database exists and get info.
+    Check if tuning database exists and get per-workload statistics.
 
     Args:
         work_dir: Directory to check
 
     Returns:
-        dict: Database information
+        dict: Database information (files, workload/record counts and
+              per-workload record count and best latency)
     """
     if not os.path.exists(work_dir):
         return {
@@ -314,11 +669,21 @@ def check_tuning_database(work_dir="tuning_database"):
             if file.endswith(".json") or file.endswith(".db") or file.endswith(".so"):
                 db_files.append(file)
 
+    stats = workload_stats(work_dir)
+    workloads = [
+        f"{shash}: records={s['num_records']}, best_us={s['best_latency_us']:.3f}"
+        for shash, s in sorted(stats.items(), key=lambda item: item[1]["workload_index"])
+    ]
+
     return {
         "exists": True,
         "path": work_dir,
         "files": db_files,
-        "file_count": len(db_files)
+        "file_count": len(db_files),
+        "num_workloads": len(stats),
+        "num_records": sum(s["num_records"] for s in stats.values()),
+        "num_valid_records": sum(s["num_valid"] for s in stats.values()),
+        "workloads": workloads
     }
 
 
@@ -0,0 +1,233 @@
+"""
+BF16/FP16 Mixed-Precision Compilation
+
+Rewrites compute-heavy layers (conv1d/conv2d/matmul by default) to read
+bfloat16 or float16 activations and weights and accumulate in float32:
+
+    y = conv(cast<low>(x), cast<low>(w), out_dtype="float32")
+
+Constant weights are folded to the low-precision dtype at build time, so
+weight-heavy layers move half the bytes. Everything outside the converted
+layers (and their outputs) stays float32. Which layers are converted is
+controlled by an allow list of operators and a deny list of operators or
+layer names (bound variable names).
+"""
+
+import time
+import numpy as np
+import tvm
+from tvm import relax
+from tvm.relax.expr_functor import PyExprMutator, mutator
+from .target import create_target
+
+PRECISIONS = ("float32", "bfloat16", "float16")
+DEFAULT_ALLOW_OPS = ("nn.conv1d", "nn.conv2d", "matmul")
+
+_CONV_BUILDERS = {
+    "nn.conv1d": lambda: relax.op.nn.conv1d,
+    "nn.conv2d": lambda: relax.op.nn.conv2d,
+}
+
+
+def _op_name(call):
+    if isinstance(call, relax.Call) and isinstance(call.op, tvm.ir.Op) and call.op.name.startswith("relax."):
+        return call.op.name[len("relax."):]
+    return None
+
+
+@mutator
+class _LowPrecisionRewriter(PyExprMutator):
+    """
+    Casts the inputs of selected float32 layers to a low-precision dtype.
+    """
+
+    def __init__(self, mod, dtype, allow_ops, deny):
+        super().__init__(mod)
+        self.dtype = dtype
+        self.allow_ops = set(allow_ops)
+        self.deny = set(deny)
+        self.converted = []
+        self._current = None
+
+    def visit_var_binding_(self, binding):
+        self._current = binding.var.name_hint
+        super().visit_var_binding_(binding)
+
+    def visit_call_(self, call):
+        call = self.visit_expr_post_order(call)
+        name = _op_name(call)
+        if name not in self.allow_ops or name in self.deny or self._current in self.deny:
+            return call
+        if name not in _CONV_BUILDERS and name != "matmul":
+            return call
+        if any(getattr(arg.struct_info, "dtype", None) != "float32" for arg in call.args[:2]):
+            return call
+
+        bb = self.builder_
+        data = bb.emit(relax.op.astype(call.args[0], self.dtype))
+        weight = bb.emit(relax.op.astype(call.args[1], self.dtype))
+        self.converted.append(self._current)
+
+        if name == "matmul":
+            return relax.op.matmul(data, weight, out_dtype="float32")
+
+        attrs = call.attrs
+        return _CONV_BUILDERS[name]()(
+            data,
+            weight,
+            strides=[int(v) for v in attrs.strides],
+            padding=[int(v) for v in attrs.padding],
+            dilation=[int(v) for v in attrs.dilation],
+            groups=int(attrs.groups),
+            data_layout=attrs.data_layout,
+            kernel_layout=attrs.kernel_layout,
+            out_layout=attrs.out_layout or None,
+            out_dtype="float32",
+        )
+
+
+def to_mixed_precision(relax_mod, dtype="bfloat16", allow_ops=None, deny_ops=None):
+    """
+    Convert allowed layers to low-precision storage with float32 accumulation.
+
+    Args:
+        relax_mod: Relax IRModule (before the zero pipeline)
+        dtype: "bfloat16" or "float16" ("float32" returns the module unchanged)
+        allow_ops: Relax operators to convert without the "relax." prefix
+            (default: DEFAULT_ALLOW_OPS)
+        deny_ops: Operators or layer names (bound variable names) to keep in float32
+
+    Returns:
+        tuple: (converted module, list of converted layer names)
+    """
+    if dtype not in PRECISIONS:
+        raise ValueError(f"Unknown precision: {dtype} (expected one of {PRECISIONS})")
+    if dtype == "float32":
+        return relax_mod, []
+
+    allow_ops = list(allow_ops) if allow_ops else list(DEFAULT_ALLOW_OPS)
+    rewriter = _LowPrecisionRewriter(relax_mod, dtype, allow_ops, deny_ops or [])
+    for gv, func in relax_mod.functions.items():
+        if isinstance(func, relax.Function):
+            rewriter.builder_.update_func(gv, rewriter.visit_expr(func))
+
+    # Converts constant weights to the low-precision dtype at build time
+    converted_mod = relax.transform.FoldConstant()(rewriter.builder_.get())
+    return converted_mod, rewriter.converted
+
+
+def _itemsize(dtype):
+    # "float32" -> 4, "bfloat16" -> 2, "int8" -> 1
+    bits = "".join(c for c in dtype if c.isdigit())
+    return max(1, int(bits) // 8) if bits else 1
+
+
+def weight_bytes(relax_mod):
+    """
+    Total size of the constants (embedded weights) in the Relax functions of a module.
+    """
+    total = 0
+
+    def visit(expr):
+        nonlocal total
+        if isinstance(expr, relax.Constant):
+            total += int(np.prod(expr.data.shape, dtype=np.int64)) * _itemsize(str(expr.data.dtype))
+
+    for func in relax_mod.functions.values():
+        if isinstance(func, relax.Function):
+            relax.analysis.post_order_visit(func, visit)
+    return total
+
+
+def _run(ex, inputs, num_runs, num_warmup=3):
+    vm = relax.VirtualMachine(ex, tvm.cpu())
+    for _ in range(num_warmup):
+        output = vm["main"](*inputs)
+    times = []
+    for _ in range(num_runs):
+        start = time.perf_counter()
+        output = vm["main"](*inputs)
+        times.append((time.perf_counter() - start) * 1000.0)
+    if not isinstance(output, tvm.runtime.Tensor):
+        output = output[0]
+    return float(np.mean(times)), output.numpy().astype("float32")
+
+
+def compare_mixed_precision(
+    relax_mod_ir="",
+    target_name="llvm",
+    precision="bfloat16",
+    allow_ops=None,
+    deny_ops=None,
+    num_runs=20
+):
+    """
+    Build a module in float32 and in mixed precision and compare them.
+
+    Both builds run on the same random inputs (untuned, zero pipeline).
+
+    Args:
+        relax_mod_ir: Relax module IR JSON ("" = pretrained ResNet18)
+        target_name: Target name (e.g., "llvm")
+        precision: "bfloat16" or "float16"
+        allow_ops: Operators to convert (default: DEFAULT_ALLOW_OPS)
+        deny_ops: Operators or layer names kept in float32
+        num_runs: Timed runs per build
+
+    Returns:
+        dict: status, num_converted_layers, converted_layers, float/mixed
+            latency_ms, speedup, float/mixed weight_bytes, max_abs_error,
+            mean_abs_error, max_rel_error (relative to the largest float32
+            output magnitude) and top1_agreement (share of output rows with
+            the same argmax)
+    """
+    from .profiling import _random_inputs
+
+    try:
+        if relax_mod_ir:
+            relax_mod = tvm.ir.load_json(relax_mod_ir)
+        else:
+            from .resnet_schedule import create_resnet18_relax_mod
+            relax_mod = create_resnet18_relax_mod(pretrained=True)
+
+        target = create_target(target_name)
+        mixed_mod, converted = to_mixed_precision(relax_mod, precision, allow_ops, deny_ops)
+        inputs = _random_inputs(relax_mod["main"], tvm.cpu())
+
+        results = {}
+        for label, mod in (("float", relax_mod), ("mixed", mixed_mod)):
+            with target:
+                mod = relax.get_pipeline("zero")(mod)
+            ex = relax.build(mod, target)
+            results[label] = _run(ex, inputs, num_runs) + (weight_bytes(mod),)
+
+        float_ms, float_out, float_bytes = results["float"]
+        mixed_ms, mixed_out, mixed_bytes = results["mixed"]
+        error = np.abs(float_out - mixed_out)
+        scale = float(np.max(np.abs(float_out))) or 1.0
+        rows_float = float_out.reshape(-1, float_out.shape[-1]) if float_out.ndim else float_out.reshape(1, 1)
+        rows_mixed = mixed_out.reshape(rows_float.shape)
+
+        return {
+            "status": "success",
+            "target": str(target),
+            "precision": precision,
+            "num_converted_layers": len(converted),
+            "converted_layers": converted,
+            "float_latency_ms": float_ms,
+            "mixed_latency_ms": mixed_ms,
+            "speedup": float_ms / mixed_ms if mixed_ms > 0 else 0.0,
+            "float_weight_bytes": float_bytes,
+            "mixed_weight_bytes": mixed_bytes,
+            "max_abs_error": float(np.max(error)),
+            "mean_abs_error": float(np.mean(error)),
+            "max_rel_error": float(np.max(error)) / scale,
+            "top1_agreement": float(np.mean(
+                np.argmax(rows_float, axis=-1) == np.argmax(rows_mixed, axis=-1))),
+        }
+
+    except Exception as e:
+        return {
+            "status": "error",
+            "error": str(e)
+        }
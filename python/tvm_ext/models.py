@@ -0,0 +1,267 @@
+"""
+Generic FX Model Import and Multi-Model Tuning
+
+Imports any torch.fx-traceable model, given as a torchvision model name or
+an nn.Module, into Relax with explicit input specs, and tunes several
+models through one shared MetaSchedule database. Workloads are keyed by
+structural hash, so a conv shape that appears in several models is tuned
+once; a provenance file in the database directory records which model
+tuned each workload so later models (and later runs) can report what they
+reused from whom.
+"""
+
+import os
+import json
+import torch
+import torch.fx as fx
+import tvm
+from tvm import relax
+from .target import create_target
+
+DEFAULT_INPUT_SPECS = [((1, 3, 224, 224), "float32")]
+PROVENANCE_FILE = "workload_models.json"
+
+
+def load_torchvision_model(name, pretrained=True):
+    """
+    Load a torchvision model in eval mode by name (e.g., "resnet50", "mobilenet_v2").
+
+    Args:
+        name: Name accepted by torchvision.models.get_model
+        pretrained: Load the default pretrained weights
+    """
+    import torchvision
+
+    model = torchvision.models.get_model(name, weights="DEFAULT" if pretrained else None)
+    model.eval()
+    return model
+
+
+def _dim(d):
+    # Symbolic dimensions are given by name
+    return d if isinstance(d, str) else int(d)
+
+
+def normalize_input_specs(input_specs=None):
+    """
+    Input specs as [((dims...), dtype), ...]; accepts (shape, dtype) pairs,
+    {"shape", "dtype"} dicts or bare shapes (float32). A dimension given as
+    a string (e.g. "batch") is symbolic; dimensions with the same name are
+    the same variable across all inputs.
+    """
+    if not input_specs:
+        return list(DEFAULT_INPUT_SPECS)
+    specs = []
+    for spec in input_specs:
+        if isinstance(spec, dict):
+            shape, dtype = spec["shape"], spec.get("dtype", "float32")
+        elif len(spec) == 2 and isinstance(spec[1], str):
+            shape, dtype = spec
+        else:
+            shape, dtype = spec, "float32"
+        specs.append((tuple(_dim(d) for d in shape), dtype or "float32"))
+    return specs
+
+
+def symbolic_dims(input_specs):
+    """
+    Names of the symbolic dimensions in normalized input specs, in order of appearance.
+    """
+    names = []
+    for shape, _ in input_specs:
+        for d in shape:
+            if isinstance(d, str) and d not in names:
+                names.append(d)
+    return names
+
+
+def _relax_input_info(input_specs):
+    # One int64 SizeVar per symbolic name
+    dims = {name: tvm.tir.SizeVar(name, "int64") for name in symbolic_dims(input_specs)}
+    return [(tuple(dims[d] if isinstance(d, str) else d for d in shape), dtype) for shape, dtype in input_specs]
+
+
+def import_fx_model(model, input_specs=None, keep_params=False, pretrained=True):
+    """
+    Trace a model with torch.fx and import it as a Relax IRModule.
+
+    Args:
+        model: torch.nn.Module or torchvision model name
+        input_specs: Input shapes and dtypes (default: one (1, 3, 224, 224) float32 image);
+            named dimensions (e.g. ("batch", 3, "height", "width")) stay symbolic
+        keep_params: Keep parameters as function inputs (False embeds them as constants)
+        pretrained: Pretrained weights when model is a name
+
+    Returns:
+        tvm.IRModule: Relax module with a "main" function
+    """
+    from tvm.relax.frontend.torch import from_fx
+
+    if isinstance(model, str):
+        model = load_torchvision_model(model, pretrained)
+    model.eval()
+
+    with torch.no_grad():
+        traced_model = fx.symbolic_trace(model)
+        input_info = _relax_input_info(normalize_input_specs(input_specs))
+        return from_fx(traced_model, input_info, keep_params_as_input=keep_params)
+
+
+def create_model_relax_ir(model_name, input_specs=None, pretrained=True, keep_params=False):
+    """
+    Import a torchvision model by name and serialize it for C++.
+
+    Returns:
+        dict: status, model, relax_mod_json (loadable IR) and input_specs
+    """
+    try:
+        relax_mod = import_fx_model(model_name, input_specs, keep_params, pretrained)
+        return {
+            "status": "success",
+            "model": model_name,
+            "relax_mod_json": tvm.ir.save_json(relax_mod),
+            "input_specs": str(normalize_input_specs(input_specs)),
+            "pretrained": pretrained,
+        }
+
+    except Exception as e:
+        return {
+            "status": "error",
+            "error": str(e)
+        }
+
+
+def _read_provenance(work_dir):
+    path = os.path.join(work_dir, PROVENANCE_FILE)
+    if not os.path.isfile(path):
+        return {}
+    with open(path) as f:
+        return json.load(f)
+
+
+def _write_provenance(work_dir, provenance):
+    path = os.path.join(work_dir, PROVENANCE_FILE)
+    with open(path + ".tmp", "w") as f:
+        json.dump(provenance, f, indent=1, sort_keys=True)
+    os.replace(path + ".tmp", path)
+
+
+def tune_models(
+    models,
+    target_name="llvm",
+    num_trials_per_model=64,
+    target_trials_per_task=64,
+    max_workers=None,
+    work_dir="tuning_database_shared",
+    pipeline="zero",
+    build=True
+):
+    """
+    Tune several models through one shared database, reusing common workloads.
+
+    Models are tuned in order. A task is skipped when the database already
+    has target_trials_per_task records for its workload (or it converged),
+    whichever model produced them. With build, each model is compiled with
+    the shared database to <work_dir>/<name>.so.
+
+    Args:
+        models: List of model names, or dicts with "name" and optional
+            "input_specs", "pretrained" and "module" (an nn.Module to use
+            instead of loading by name)
+        target_name: Target name (e.g., "llvm")
+        num_trials_per_model: New-trial budget per model
+        target_trials_per_task: Trials after which a workload counts as tuned
+        max_workers: Number of parallel workers (None = CPU count)
+        work_dir: Shared tuning database directory
+        pipeline: Relax pipeline preset or pass list (see relax_pipeline)
+        build: Compile each model with the shared database
+
+    Returns:
+        dict: status, work_dir, total_tasks, unique_workloads,
+            shared_workloads (workloads in more than one model) and "models",
+            one dict per model: name, status, error, num_tasks, tuned_tasks,
+            reused_tasks, reused_from_models (reused tasks tuned for another
+            model), reused_from (model names), new_records and lib_path
+    """
+    from .metaschedule import _tune_incremental_mod
+    from .relax_pipeline import run_relax_pipeline
+
+    try:
+        target = create_target(target_name)
+        os.makedirs(work_dir, exist_ok=True)
+        provenance = _read_provenance(work_dir)
+
+        results = []
+        workload_models = {}    # shash -> models in this call containing it
+        total_tasks = 0
+        for spec in models:
+            if isinstance(spec, str):
+                spec = {"name": spec}
+            name = spec["name"]
+            entry = {"name": name, "status": "success", "error": ""}
+            try:
+                relax_mod = import_fx_model(
+                    spec.get("module") or name,
+                    spec.get("input_specs"),
+                    pretrained=spec.get("pretrained", True),
+                )
+                relax_mod, _ = run_relax_pipeline(relax_mod, target, pipeline, report=False)
+                tuned = _tune_incremental_mod(
+                    relax_mod, target, num_trials_per_model, target_trials_per_task, max_workers, work_dir
+                )
+            except Exception as e:
+                entry.update(status="error", error=str(e))
+                results.append(entry)
+                continue
+
+            reused_from = set()
+            reused_from_models = 0
+            for _, shash, skipped, new_records in tuned["tasks"]:
+                workload_models.setdefault(shash, set()).add(name)
+                owner = provenance.get(shash)
+                if skipped and owner and owner != name:
+                    reused_from_models += 1
+                    reused_from.add(owner)
+                elif owner is None and new_records > 0:
+                    provenance[shash] = name
+            _write_provenance(work_dir, provenance)
+            total_tasks += tuned["num_tasks"]
+
+            entry.update({
+                "num_tasks": tuned["num_tasks"],
+                "tuned_tasks": tuned["tuned_tasks"],
+                "reused_tasks": tuned["skipped_tasks"],
+                "reused_from_models": reused_from_models,
+                "reused_from": sorted(reused_from),
+                "new_records": tuned["new_records"],
+                "lib_path": "",
+            })
+
+            if build:
+                from tvm.ir.transform import PassContext
+
+                try:
+                    with target, PassContext(opt_level=0):
+                        relax_mod = relax.transform.MetaScheduleApplyDatabase(work_dir)(relax_mod)
+                    lib_path = os.path.join(work_dir, f"{name}.so")
+                    relax.build(relax_mod, target).export_library(lib_path)
+                    entry["lib_path"] = lib_path
+                except Exception as e:
+                    entry.update(status="error", error=f"Build failed: {e}")
+            results.append(entry)
+
+        return {
+            "status": "success",
+            "work_dir": work_dir,
+            "target": str(target),
+            "total_tasks": total_tasks,
+            "unique_workloads": len(workload_models),
+            "shared_workloads": sum(1 for names in workload_models.values() if len(names) > 1),
+            "models": results,
+        }
+
+    except Exception as e:
+        return {
+            "status": "error",
+            "error": str(e)
+        }
@@ -0,0 +1,213 @@
+"""
+SDK Parameter File Format
+
+An aligned, memory-mappable weight container: a fixed header, an index of
+tensor name/dtype/shape/offset/size/CRC32, and a page-aligned data section
+with every tensor 64-byte aligned. Loading maps the file and wraps each
+tensor in place, so cold start is bounded by page faults instead of
+parsing. The layout is mirrored by the C++ ParamFile (include/ffi/param_file.h).
+
+Layout (little-endian):
+    header (64 bytes):
+        magic "TSDKPRM\\0", u32 version, u32 flags (bit 0: checksums),
+        u64 num_tensors, u64 index_offset, u64 index_size,
+        u64 data_offset, u64 file_size, u64 reserved
+    index entry (num_tensors times):
+        u32 name_len, name, u32 dtype_len, dtype, u32 ndim, i64 shape[ndim],
+        u64 offset, u64 nbytes, u32 crc32
+    data: tensors at their offsets
+"""
+
+import os
+import struct
+import zlib
+from collections import OrderedDict
+import numpy as np
+
+MAGIC = b"TSDKPRM\0"
+VERSION = 1
+FLAG_CHECKSUMS = 1
+HEADER_FORMAT = "<8sIIQQQQQQ"
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+DATA_ALIGNMENT = 4096
+TENSOR_ALIGNMENT = 64
+
+
+def _align(value, alignment):
+    return (value + alignment - 1) // alignment * alignment
+
+
+def _to_numpy(value):
+    """
+    Convert a numpy array, PyTorch tensor or TVM tensor to a contiguous numpy array.
+    """
+    if hasattr(value, "detach"):  # torch.Tensor
+        value = value.detach().cpu().numpy()
+    elif hasattr(value, "numpy") and not isinstance(value, np.ndarray):  # tvm.runtime.Tensor
+        value = value.numpy()
+    return np.ascontiguousarray(value)
+
+
+def _encode_entry(name, dtype, shape, offset, nbytes, crc):
+    name_bytes = name.encode("utf-8")
+    dtype_bytes = dtype.encode("utf-8")
+    return b"".join([
+        struct.pack("<I", len(name_bytes)), name_bytes,
+        struct.pack("<I", len(dtype_bytes)), dtype_bytes,
+        struct.pack("<I", len(shape)), struct.pack(f"<{len(shape)}q", *shape),
+        struct.pack("<QQI", offset, nbytes, crc),
+    ])
+
+
+def save_param_file(path, params, checksum=True):
+    """
+    Write tensors to an SDK parameter file.
+
+    Args:
+        path: Output file path
+        params: dict or list of (name, array) pairs; arrays may be numpy
+            arrays, PyTorch tensors or TVM tensors. Order is preserved.
+        checksum: Store a CRC32 per tensor
+
+    Returns:
+        dict: num_tensors, data_bytes and file_size
+    """
+    items = list(params.items()) if isinstance(params, dict) else list(params)
+    arrays = [(name, _to_numpy(value)) for name, value in items]
+
+    # The index size does not depend on offsets (fixed-width fields)
+    index_size = sum(
+        len(_encode_entry(name, str(array.dtype), array.shape, 0, 0, 0)) for name, array in arrays
+    )
+    data_offset = _align(HEADER_SIZE + index_size, DATA_ALIGNMENT)
+
+    entries = []
+    offsets = []
+    offset = data_offset
+    for name, array in arrays:
+        crc = zlib.crc32(array.data) & 0xFFFFFFFF if checksum else 0
+        entries.append(_encode_entry(name, str(array.dtype), array.shape, offset, array.nbytes, crc))
+        offsets.append(offset)
+        offset = _align(offset + array.nbytes, TENSOR_ALIGNMENT)
+    file_size = offset
+
+    header = struct.pack(
+        HEADER_FORMAT, MAGIC, VERSION, FLAG_CHECKSUMS if checksum else 0,
+        len(arrays), HEADER_SIZE, index_size, data_offset, file_size, 0,
+    )
+
+    tmp_path = path + ".tmp"
+    with open(tmp_path, "wb") as f:
+        f.write(header)
+        f.write(b"".join(entries))
+        for (_, array), target in zip(arrays, offsets):
+            f.write(b"\0" * (target - f.tell()))
+            f.write(array.data)
+        f.write(b"\0" * (file_size - f.tell()))
+    os.replace(tmp_path, path)
+
+    return {
+        "num_tensors": len(arrays),
+        "data_bytes": sum(array.nbytes for _, array in arrays),
+        "file_size": file_size,
+    }
+
+
+def read_param_index(path):
+    """
+    Read the header and tensor index without touching the data section.
+
+    Returns:
+        tuple: (header dict, list of entry dicts with name, dtype, shape,
+            offset, nbytes, crc32)
+    """
+    with open(path, "rb") as f:
+        raw = f.read(HEADER_SIZE)
+        if len(raw) < HEADER_SIZE:
+            raise ValueError(f"Truncated parameter file: {path}")
+        magic, version, flags, num_tensors, index_offset, index_size, data_offset, file_size, _ = \
+            struct.unpack(HEADER_FORMAT, raw)
+        if magic != MAGIC:
+            raise ValueError(f"Not an SDK parameter file: {path}")
+        if version != VERSION:
+            raise ValueError(f"Unsupported parameter file version {version}: {path}")
+        f.seek(index_offset)
+        index = f.read(index_size)
+
+    entries = []
+    pos = 0
+    for _ in range(num_tensors):
+        (name_len,) = struct.unpack_from("<I", index, pos)
+        pos += 4
+        name = index[pos:pos + name_len].decode("utf-8")
+        pos += name_len
+        (dtype_len,) = struct.unpack_from("<I", index, pos)
+        pos += 4
+        dtype = index[pos:pos + dtype_len].decode("utf-8")
+        pos += dtype_len
+        (ndim,) = struct.unpack_from("<I", index, pos)
+        pos += 4
+        shape = tuple(struct.unpack_from(f"<{ndim}q", index, pos))
+        pos += 8 * ndim
+        offset, nbytes, crc = struct.unpack_from("<QQI", index, pos)
+        pos += 20
+        entries.append({
+            "name": name, "dtype": dtype, "shape": shape,
+            "offset": offset, "nbytes": nbytes, "crc32": crc,
+        })
+
+    header = {
+        "version": version,
+        "checksums": bool(flags & FLAG_CHECKSUMS),
+        "num_tensors": num_tensors,
+        "data_offset": data_offset,
+        "file_size": file_size,
+    }
+    return header, entries
+
+
+def load_param_file(path, verify=False):
+    """
+    Map a parameter file and return zero-copy numpy views of its tensors.
+
+    The mapping is copy-on-write, so the views are writable (as DLPack
+    export requires) while pages stay shared with the page cache and with
+    other processes mapping the same file.
+
+    Args:
+        path: Parameter file path
+        verify: Check every tensor's CRC32 (reads all data)
+
+    Returns:
+        OrderedDict: name -> numpy array backed by the mapping
+    """
+    header, entries = read_param_index(path)
+    mapping = np.memmap(path, dtype=np.uint8, mode="c", shape=(header["file_size"],))
+
+    arrays = OrderedDict()
+    for entry in entries:
+        data = mapping[entry["offset"]:entry["offset"] + entry["nbytes"]]
+        if verify and header["checksums"] and (zlib.crc32(data) & 0xFFFFFFFF) != entry["crc32"]:
+            raise ValueError(f"Checksum mismatch for tensor '{entry['name']}' in {path}")
+        arrays[entry["name"]] = data.view(np.dtype(entry["dtype"])).reshape(entry["shape"])
+    return arrays
+
+
+def load_param_tensors(path, names=None, verify=False):
+    """
+    Load parameters as TVM tensors that alias the file mapping (no copies).
+
+    Args:
+        path: Parameter file path
+        names: Tensor names in the order to return (default: file order)
+        verify: Check CRC32 checksums
+
+    Returns:
+        list: tvm.runtime.Tensor per name
+    """
+    import tvm
+
+    arrays = load_param_file(path, verify=verify)
+    if names is None:
+        names = list(arrays)
+    return [tvm.runtime.from_dlpack(arrays[name]) for name in names]
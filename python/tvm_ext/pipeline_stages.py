@@ -0,0 +1,64 @@
+"""
+Pipeline Stage Factories for the ResNet Flow
+
+Factories for the stages of an image classification pipeline (decode and
+preprocess, inference, softmax/top-k). The C++ Pipeline calls a factory
+once per stage worker, so every worker owns its state (e.g., its own bound
+InferenceSession). Factory arguments arrive as strings from C++.
+"""
+
+import numpy as np
+
+
+def create_preprocess_stage(height="224", width="224"):
+    """
+    Stage: image path -> contiguous float32 NCHW array.
+    """
+    from .resnet_schedule import preprocess_image_for_resnet
+
+    height, width = int(height), int(width)
+
+    def preprocess(image_path):
+        image = preprocess_image_for_resnet(str(image_path))
+        array = np.ascontiguousarray(image.numpy(), dtype="float32")
+        if array.shape[-2:] != (height, width):
+            raise ValueError(f"Expected {height}x{width} input, got {array.shape}")
+        return array
+
+    return preprocess
+
+
+def create_infer_stage(lib_path, func_name="main", device="cpu", num_classes="1000"):
+    """
+    Stage: input array -> logits, using an InferenceSession bound to
+    per-worker buffers (inputs are copied in, logits copied out so the
+    next item can reuse the buffers while downstream stages run).
+    """
+    from .inference import InferenceSession
+
+    session = InferenceSession(lib_path, func_name, device)
+    state = {"input": None, "output": np.empty((1, int(num_classes)), dtype="float32")}
+
+    def infer(array):
+        if state["input"] is None or state["input"].shape != array.shape:
+            state["input"] = np.empty(array.shape, dtype=array.dtype)
+            session.bind([state["input"]], [state["output"]])
+        np.copyto(state["input"], array)
+        session.run()
+        return state["output"].copy()
+
+    return infer
+
+
+def create_postprocess_stage(top_k="5"):
+    """
+    Stage: logits -> list of (class_id, probability) for the top-k classes.
+    """
+    from .postprocess import classify
+
+    top_k = int(top_k)
+
+    def postprocess(logits):
+        return [(p['class_id'], p['probability']) for p in classify(np.reshape(logits, -1), k=top_k)[0]]
+
+    return postprocess
@@ -0,0 +1,145 @@
+"""
+Classification Postprocessing
+
+Numerically stable softmax/log-softmax and partial-selection top-k over
+batched [batch, num_classes] float32 logits. When running embedded in the
+C++ SDK, the work is done by the native _tvm_sdk_postprocess module (see
+include/postprocess.h), which reads the logits buffer in place and releases
+the GIL; otherwise a numpy fallback with the same semantics is used.
+ImageNet labels are loaded once and cached.
+"""
+
+import functools
+import numpy as np
+
+try:
+    import _tvm_sdk_postprocess as _native
+except ImportError:
+    _native = None
+
+
+def _as_logits(logits):
+    array = np.ascontiguousarray(logits, dtype="float32")
+    if array.ndim not in (1, 2) or array.shape[-1] == 0:
+        raise ValueError(f"Expected logits of shape [num_classes] or [batch, num_classes], got {array.shape}")
+    return array
+
+
+def has_native_postprocess():
+    """
+    Whether the native postprocessing module is available.
+    """
+    return _native is not None
+
+
+def softmax(logits, out=None):
+    """
+    Row-wise softmax, computed as exp(x - max) / sum.
+
+    Args:
+        logits: Array of shape [num_classes] or [batch, num_classes]
+        out: Optional float32 output array of the same shape
+
+    Returns:
+        Probabilities (out if given)
+    """
+    logits = _as_logits(logits)
+    if out is None:
+        out = np.empty_like(logits)
+    if _native is not None:
+        _native.softmax(logits, out)
+        return out
+    exp = np.exp(logits - np.max(logits, axis=-1, keepdims=True))
+    np.divide(exp, np.sum(exp, axis=-1, keepdims=True), out=out)
+    return out
+
+
+def log_softmax(logits, out=None):
+    """
+    Row-wise log-softmax, computed as x - max - log(sum(exp(x - max))).
+    """
+    logits = _as_logits(logits)
+    if out is None:
+        out = np.empty_like(logits)
+    if _native is not None:
+        _native.log_softmax(logits, out)
+        return out
+    shifted = logits - np.max(logits, axis=-1, keepdims=True)
+    np.subtract(shifted, np.log(np.sum(np.exp(shifted), axis=-1, keepdims=True)), out=out)
+    return out
+
+
+def _select(scores, k):
+    # Partial selection of the k largest, then sort only those (ties: lower id first)
+    rows = []
+    for row in scores.reshape(-1, scores.shape[-1]):
+        top = np.argpartition(-row, k - 1)[:k]
+        top = top[np.lexsort((top, -row[top]))]
+        rows.append(top)
+    return rows
+
+
+def top_k(scores, k=5):
+    """
+    Row-wise top-k by score without sorting all classes.
+
+    Returns:
+        One list of (class_id, score) per batch row, highest score first
+    """
+    scores = _as_logits(scores)
+    k = int(k)
+    if not 0 < k <= scores.shape[-1]:
+        raise ValueError(f"top-k needs 0 < k <= num_classes (k={k}, num_classes={scores.shape[-1]})")
+    if _native is not None:
+        return _native.top_k(scores, k)
+    rows = scores.reshape(-1, scores.shape[-1])
+    return [[(int(i), float(row[i])) for i in top] for row, top in zip(rows, _select(rows, k))]
+
+
+def classify(logits, k=5, labels=None):
+    """
+    Top-k classes with softmax probabilities, without materializing the full softmax.
+
+    Args:
+        logits: Array of shape [num_classes] or [batch, num_classes]
+        k: Number of classes per row
+        labels: Optional list of class names (e.g., imagenet_labels())
+
+    Returns:
+        One list per batch row of dicts with class_id, probability and
+        (if labels are given) class_name
+    """
+    logits = _as_logits(logits)
+    k = int(k)
+    if not 0 < k <= logits.shape[-1]:
+        raise ValueError(f"top-k needs 0 < k <= num_classes (k={k}, num_classes={logits.shape[-1]})")
+
+    if _native is not None:
+        rows = _native.classify(logits, k)
+    else:
+        rows = []
+        for row, top in zip(logits.reshape(-1, logits.shape[-1]), _select(logits, k)):
+            max_logit = row[top[0]]
+            total = np.sum(np.exp(row - max_logit))
+            rows.append([(int(i), float(np.exp(row[i] - max_logit) / total)) for i in top])
+
+    results = []
+    for row in rows:
+        predictions = []
+        for class_id, probability in row:
+            prediction = {'class_id': int(class_id)}
+            if labels is not None:
+                prediction['class_name'] = labels[class_id] if class_id < len(labels) else ""
+            prediction['probability'] = float(probability)
+            predictions.append(prediction)
+        results.append(predictions)
+    return results
+
+
+@functools.lru_cache(maxsize=None)
+def imagenet_labels():
+    """
+    ImageNet-1k class names from torchvision (loaded once).
+    """
+    from torchvision.models import ResNet18_Weights
+    return list(ResNet18_Weights.IMAGENET1K_V1.meta["categories"])
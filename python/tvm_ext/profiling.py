@@ -0,0 +1,252 @@
+"""
+Per-Operator Profiling for Compiled Relax Modules
+
+Runs a built Relax module under the Relax VM profiler and aggregates the
+per-call report into a per-operator table that links each kernel back to
+its MetaSchedule workload in the tuning database.
+"""
+
+import os
+import json
+import numpy as np
+import tvm
+from tvm import relax
+from .target import create_target
+from .database import normalize_shash
+from .relax_pipeline import run_relax_pipeline
+
+
+def _metric_value(metric):
+    """
+    Unwrap a metric from Report.json() (e.g. {"microseconds": 1.5} -> 1.5).
+    """
+    if isinstance(metric, dict):
+        if not metric:
+            return None
+        return next(iter(metric.values()))
+    return metric
+
+
+def _random_inputs(func, device):
+    """
+    Create random input tensors matching the parameters of a Relax function.
+
+    Args:
+        func: relax.Function to create inputs for
+        device: TVM device to allocate inputs on
+
+    Returns:
+        list: tvm.runtime.Tensor inputs
+    """
+    inputs = []
+    for param in func.params:
+        sinfo = param.struct_info
+        if not isinstance(sinfo, relax.TensorStructInfo) or sinfo.shape is None:
+            raise ValueError(f"Unsupported parameter for profiling: {param.name_hint}")
+        shape = [int(dim) for dim in sinfo.shape.values]
+        data = np.random.uniform(-1.0, 1.0, size=shape).astype(sinfo.dtype)
+        inputs.append(tvm.runtime.tensor(data, device))
+    return inputs
+
+
+def _estimate_kernel_flops(relax_mod):
+    """
+    Estimate FLOPs per call for every PrimFunc in the module.
+
+    Returns:
+        dict: kernel name -> FLOPs (kernels that cannot be analyzed are omitted)
+    """
+    flops = {}
+    for gv, func in relax_mod.functions.items():
+        if not isinstance(func, tvm.tir.PrimFunc):
+            continue
+        try:
+            flops[gv.name_hint] = float(
+                tvm.tir.analysis.estimate_tir_flops(tvm.IRModule({"main": func}))
+            )
+        except Exception:
+            pass
+    return flops
+
+
+def _lookup_workloads(relax_mod, target, work_dir):
+    """
+    Map kernel names to their MetaSchedule workloads in the tuning database.
+
+    Returns:
+        dict: kernel name -> {"workload_hash", "tuning_records", "best_tuned_us"}
+    """
+    import tvm.meta_schedule as ms
+
+    workload_file = os.path.join(work_dir, "database_workload.json")
+    record_file = os.path.join(work_dir, "database_tuning_record.json")
+    if not (os.path.exists(workload_file) and os.path.exists(record_file)):
+        return {}
+
+    database = ms.database.JSONDatabase(
+        path_workload=workload_file,
+        path_tuning_record=record_file,
+        allow_missing=False,
+    )
+
+    workloads = {}
+    for task in ms.relax_integration.extract_tasks(relax_mod, target):
+        task_mod = task.dispatched[0]
+        if not database.has_workload(task_mod):
+            continue
+
+        workload = database.commit_workload(task_mod)
+        records = database.get_top_k(workload, 1 << 30)
+
+        best_us = -1.0
+        if records and records[0].run_secs:
+            best_us = float(np.mean([float(s) for s in records[0].run_secs])) * 1e6
+
+        workloads[task.task_name] = {
+            "workload_hash": normalize_shash(tvm.ir.structural_hash(task_mod)),
+            "tuning_records": len(records),
+            "best_tuned_us": best_us,
+        }
+    return workloads
+
+
+def profile_module(relax_mod, target, num_runs=5):
+    """
+    Build a (pipelined) Relax module and profile it with the Relax VM profiler.
+
+    Args:
+        relax_mod: Relax IRModule, already lowered by the pipeline
+        target: tvm.target.Target to build for
+        num_runs: Number of profiled runs to average over
+
+    Returns:
+        tuple: (end-to-end time in us, dict kernel name -> {"total_us", "calls"}
+                per inference)
+    """
+    ex = relax.build(relax_mod, target)
+    device = tvm.device(target.kind.name, 0)
+    vm = relax.VirtualMachine(ex, device, profile=True)
+    inputs = _random_inputs(relax_mod["main"], device)
+
+    # Warmup
+    vm["main"](*inputs)
+
+    # Profile and aggregate per kernel name
+    num_runs = max(1, int(num_runs))
+    totals = {}
+    e2e_total_us = 0.0
+    for _ in range(num_runs):
+        report = json.loads(vm.profile("main", *inputs).json())
+
+        run_us = 0.0
+        for call in report.get("calls", []):
+            name = _metric_value(call.get("Name"))
+            duration = _metric_value(call.get("Duration (us)")) or 0.0
+            count = _metric_value(call.get("Count")) or 1
+
+            entry = totals.setdefault(str(name), {"total_us": 0.0, "calls": 0})
+            entry["total_us"] += float(duration)
+            entry["calls"] += int(count)
+            run_us += float(duration)
+
+        # Prefer the device-level wall time, fall back to the sum of calls
+        device_us = 0.0
+        for metrics in report.get("device_metrics", {}).values():
+            device_us += float(_metric_value(metrics.get("Duration (us)")) or 0.0)
+        e2e_total_us += device_us if device_us > 0.0 else run_us
+
+    for entry in totals.values():
+        entry["total_us"] /= num_runs
+        entry["calls"] = max(1, entry["calls"] // num_runs)
+
+    return e2e_total_us / num_runs, totals
+
+
+def profile_relax_module(
+    relax_mod_ir,
+    target_name="llvm",
+    work_dir="tuning_database",
+    use_database=True,
+    num_runs=5,
+    opt_level=0,
+    pipeline="zero"
+):
+    """
+    Build a Relax module and profile it per operator with the Relax VM profiler.
+
+    Args:
+        relax_mod_ir: Relax module IR string
+        target_name: Target name (e.g., "llvm", "cuda")
+        work_dir: Directory containing the MetaSchedule tuning database
+        use_database: Apply tuning records from work_dir before building
+        num_runs: Number of profiled runs to average over
+        opt_level: Optimization level (0-3)
+        pipeline: Relax pipeline preset or pass list (see relax_pipeline);
+            must match the one used to tune for records to apply
+
+    Returns:
+        dict: End-to-end time and per-operator rows sorted by total time
+    """
+    from tvm.ir.transform import PassContext
+
+    try:
+        # Parse IR string to module
+        relax_mod = tvm.ir.load_json(relax_mod_ir)
+
+        # Setup target
+        target = create_target(target_name)
+
+        # Apply Relax pipeline
+        relax_mod, _ = run_relax_pipeline(relax_mod, target, pipeline, report=False)
+
+        # Kernel metadata must be collected before the database rewrites kernels
+        kernel_flops = _estimate_kernel_flops(relax_mod)
+        workloads = _lookup_workloads(relax_mod, target, work_dir)
+
+        if use_database and workloads:
+            with target, PassContext(opt_level=opt_level):
+                application_pass = relax.transform.MetaScheduleApplyDatabase(work_dir)
+                relax_mod = application_pass(relax_mod)
+
+        e2e_us, totals = profile_module(relax_mod, target, num_runs)
+        num_runs = max(1, int(num_runs))
+
+        operators = []
+        for name, entry in totals.items():
+            total_us = entry["total_us"]
+            call_count = entry["calls"]
+            flops = kernel_flops.get(name, -1.0)
+            workload = workloads.get(name, {})
+
+            operators.append({
+                "name": name,
+                "call_count": call_count,
+                "total_us": total_us,
+                "mean_us": total_us / call_count,
+                "share": total_us / e2e_us if e2e_us > 0.0 else 0.0,
+                "flops": flops,
+                "gflops_per_sec": (
+                    flops * call_count / (total_us * 1e3)
+                    if flops > 0.0 and total_us > 0.0 else -1.0
+                ),
+                "workload_hash": workload.get("workload_hash", ""),
+                "tuning_records": workload.get("tuning_records", 0),
+                "best_tuned_us": workload.get("best_tuned_us", -1.0),
+            })
+
+        operators.sort(key=lambda row: row["total_us"], reverse=True)
+
+        return {
+            "status": "success",
+            "target": str(target),
+            "work_dir": work_dir,
+            "num_runs": num_runs,
+            "e2e_time_us": e2e_us,
+            "operators": operators
+        }
+
+    except Exception as e:
+        return {
+            "status": "error",
+            "error": str(e)
+        }
@@ -0,0 +1,505 @@
+"""
+INT8 Post-Training Quantization for Relax Modules
+
+Calibrates activation ranges on a sample image set (ResNet preprocessing)
+and rewrites every conv2d and dense layer with constant float32 weights
+into quantize -> int8 conv2d/matmul with int32 accumulation -> dequantize:
+
+    x_q = clip(round(x / s_x))            uint8 if x >= 0 (post-ReLU), else int8
+    w_q = clip(round(w / s_w[c]))         int8, symmetric per output channel
+    y   = float(conv(x_q, w_q) : int32) * (s_x * s_w[c])
+
+The int8 module is tuned with MetaSchedule like any other module and is
+compared against the float32 model for latency and top-1/top-5 agreement.
+"""
+
+import os
+import time
+import multiprocessing
+import numpy as np
+import tvm
+from tvm import relax
+from tvm.relax.expr_functor import PyExprMutator, mutator
+from .target import create_target
+from .timing import PhaseTimer, count_tuning_tasks
+
+CALIBRATION_METHODS = ("minmax", "average")
+IMAGE_EXTENSIONS = (".jpg", ".jpeg", ".png", ".bmp")
+
+
+def _match_layer(call, lookup_binding):
+    """
+    Match a quantizable layer: NCHW/OIHW conv2d or matmul with a constant weight.
+
+    Args:
+        call: relax.Call to inspect
+        lookup_binding: Maps a relax.Var to its bound value (or None)
+
+    Returns:
+        dict with kind ("conv2d" or "dense"), data and weight (numpy, float32;
+        dense weights as [K, N]), or None
+    """
+    if not isinstance(call, relax.Call) or not isinstance(call.op, tvm.ir.Op):
+        return None
+    data = call.args[0] if call.args else None
+    if data is None or getattr(data.struct_info, "dtype", None) != "float32":
+        return None
+
+    if call.op.name == "relax.nn.conv2d":
+        weight = call.args[1]
+        if not isinstance(weight, relax.Constant):
+            return None
+        if call.attrs.data_layout != "NCHW" or call.attrs.kernel_layout != "OIHW":
+            return None
+        return {"kind": "conv2d", "data": data, "weight": weight.data.numpy()}
+
+    if call.op.name == "relax.matmul":
+        # from_fx lowers nn.Linear to matmul(x, permute_dims(W))
+        weight = call.args[1]
+        transposed = False
+        if isinstance(weight, relax.Var):
+            bound = lookup_binding(weight)
+            if (
+                isinstance(bound, relax.Call)
+                and isinstance(bound.op, tvm.ir.Op)
+                and bound.op.name == "relax.permute_dims"
+                and isinstance(bound.args[0], relax.Constant)
+                and (bound.attrs.axes is None or [int(a) for a in bound.attrs.axes] == [1, 0])
+            ):
+                weight = bound.args[0]
+                transposed = True
+        if not isinstance(weight, relax.Constant):
+            return None
+        array = weight.data.numpy()
+        if array.ndim != 2 or array.dtype != np.float32:
+            return None
+        return {"kind": "dense", "data": data, "weight": array.T if transposed else array}
+
+    return None
+
+
+def _function_bindings(func):
+    return [binding for block in func.body.blocks for binding in block.bindings]
+
+
+def find_quantizable_layers(relax_mod, func_name="main"):
+    """
+    List the quantizable layers of a function, in binding order.
+
+    Returns:
+        list of dicts: name (bound variable), kind, data (input var) and
+            weight_shape
+    """
+    func = relax_mod[func_name]
+    bindings = _function_bindings(func)
+    values = {binding.var: binding.value for binding in bindings if isinstance(binding, relax.VarBinding)}
+    layers = []
+    for binding in bindings:
+        if not isinstance(binding, relax.VarBinding):
+            continue
+        layer = _match_layer(binding.value, values.get)
+        if layer is not None:
+            layers.append({
+                "name": binding.var.name_hint,
+                "kind": layer["kind"],
+                "data": layer["data"],
+                "weight_shape": list(layer["weight"].shape),
+            })
+    return layers
+
+
+def _with_range_outputs(relax_mod, layers, func_name="main"):
+    """
+    Copy of the module whose function also returns min/max of each layer input.
+    """
+    func = relax_mod[func_name]
+    if len(func.body.blocks) != 1 or not isinstance(func.body.blocks[0], relax.DataflowBlock):
+        raise ValueError("Calibration expects a single dataflow block (as produced by the frontend)")
+
+    bb = relax.BlockBuilder()
+    with bb.function(func_name, func.params, attrs=func.attrs):
+        with bb.dataflow():
+            for binding in func.body.blocks[0].bindings:
+                bb.emit_normalized(binding)
+            stats = []
+            for layer in layers:
+                stats.append(bb.emit(relax.op.min(layer["data"])))
+                stats.append(bb.emit(relax.op.max(layer["data"])))
+            output = bb.emit_output(relax.Tuple([func.body.body] + stats))
+        bb.emit_func_output(output)
+
+    new_func = bb.get()[func_name]
+    return tvm.IRModule({
+        gv: (new_func if gv.name_hint == func_name else f) for gv, f in relax_mod.functions.items()
+    })
+
+
+def load_calibration_images(calibration_dir, num_samples=None):
+    """
+    Preprocess up to num_samples images (sorted by name) for ResNet.
+
+    Args:
+        calibration_dir: Directory of images, or a single image path
+        num_samples: Maximum number of images (None = all)
+
+    Returns:
+        list: (path, contiguous float32 [1, 3, 224, 224] array)
+    """
+    from .resnet_schedule import preprocess_image_for_resnet
+
+    if os.path.isdir(calibration_dir):
+        paths = sorted(
+            os.path.join(calibration_dir, name) for name in os.listdir(calibration_dir)
+            if name.lower().endswith(IMAGE_EXTENSIONS)
+        )
+    else:
+        paths = [calibration_dir]
+    if num_samples:
+        paths = paths[:int(num_samples)]
+    if not paths or not os.path.isfile(paths[0]):
+        raise FileNotFoundError(f"No calibration images found in {calibration_dir}")
+
+    return [
+        (path, np.ascontiguousarray(preprocess_image_for_resnet(path).numpy(), dtype="float32"))
+        for path in paths
+    ]
+
+
+def calibrate_relax_module(relax_mod, samples, target, method="minmax", func_name="main"):
+    """
+    Measure the input range of every quantizable layer on sample inputs.
+
+    Args:
+        relax_mod: Relax IRModule with embedded (constant) weights
+        samples: List of numpy inputs for the function
+        target: tvm.target.Target to run calibration on
+        method: "minmax" (range over all samples) or "average" (mean of
+            per-sample ranges, less sensitive to outliers)
+
+    Returns:
+        list of (min, max) per layer, in find_quantizable_layers order
+    """
+    if method not in CALIBRATION_METHODS:
+        raise ValueError(f"Unknown calibration method: {method} (expected one of {CALIBRATION_METHODS})")
+    layers = find_quantizable_layers(relax_mod, func_name)
+    if not layers:
+        return []
+
+    calib_mod = _with_range_outputs(relax_mod, layers, func_name)
+    with target:
+        calib_mod = relax.get_pipeline("zero")(calib_mod)
+    vm = relax.VirtualMachine(relax.build(calib_mod, target), tvm.cpu())
+
+    per_sample = []
+    for sample in samples:
+        outputs = vm[func_name](tvm.runtime.tensor(sample))
+        values = [float(outputs[i].numpy()) for i in range(1, len(outputs))]
+        per_sample.append(np.array(values, dtype="float64").reshape(-1, 2))
+    per_sample = np.stack(per_sample)
+
+    if method == "minmax":
+        lows, highs = per_sample[:, :, 0].min(axis=0), per_sample[:, :, 1].max(axis=0)
+    else:
+        lows, highs = per_sample[:, :, 0].mean(axis=0), per_sample[:, :, 1].mean(axis=0)
+    return [(float(low), float(high)) for low, high in zip(lows, highs)]
+
+
+def _activation_params(low, high):
+    # Non-negative inputs (after ReLU) use the full uint8 range
+    if low >= 0.0:
+        scale = high / 255.0
+        return ("uint8", 0, 255, scale if scale > 0.0 else 1.0)
+    scale = max(abs(low), abs(high)) / 127.0
+    return ("int8", -127, 127, scale if scale > 0.0 else 1.0)
+
+
+def _quantize_weight(weight, axis):
+    """
+    Symmetric per-channel int8 weights along `axis`.
+    """
+    reduce_axes = tuple(i for i in range(weight.ndim) if i != axis)
+    scale = np.max(np.abs(weight), axis=reduce_axes) / 127.0
+    scale = np.where(scale > 0.0, scale, 1.0).astype("float32")
+    shape = [1] * weight.ndim
+    shape[axis] = -1
+    quantized = np.clip(np.round(weight / scale.reshape(shape)), -127, 127).astype("int8")
+    return quantized, scale
+
+
+@mutator
+class _Int8Rewriter(PyExprMutator):
+    """
+    Rewrites matched layers in binding order using calibrated ranges.
+    """
+
+    def __init__(self, mod, ranges):
+        super().__init__(mod)
+        self.ranges = ranges
+        self.index = 0
+
+    def visit_call_(self, call):
+        call = self.visit_expr_post_order(call)
+        layer = _match_layer(call, self.lookup_binding)
+        if layer is None:
+            return call
+        if self.index >= len(self.ranges):
+            raise ValueError("Calibration ranges do not match the quantizable layers")
+        low, high = self.ranges[self.index]
+        self.index += 1
+
+        bb = self.builder_
+        act_dtype, qmin, qmax, act_scale = _activation_params(low, high)
+        scaled = bb.emit(relax.op.multiply(layer["data"], relax.const(1.0 / act_scale, "float32")))
+        rounded = bb.emit(relax.op.round(scaled))
+        clipped = bb.emit(relax.op.clip(rounded, float(qmin), float(qmax)))
+        data_q = bb.emit(relax.op.astype(clipped, act_dtype))
+
+        if layer["kind"] == "conv2d":
+            weight_q, weight_scale = _quantize_weight(layer["weight"], axis=0)
+            attrs = call.attrs
+            accum = bb.emit(relax.op.nn.conv2d(
+                data_q,
+                relax.const(weight_q, "int8"),
+                strides=[int(v) for v in attrs.strides],
+                padding=[int(v) for v in attrs.padding],
+                dilation=[int(v) for v in attrs.dilation],
+                groups=int(attrs.groups),
+                data_layout=attrs.data_layout,
+                kernel_layout=attrs.kernel_layout,
+                out_layout=attrs.out_layout or None,
+                out_dtype="int32",
+            ))
+            output_scale = (act_scale * weight_scale).reshape(1, -1, 1, 1)
+        else:
+            weight_q, weight_scale = _quantize_weight(layer["weight"], axis=1)
+            accum = bb.emit(relax.op.matmul(data_q, relax.const(weight_q, "int8"), out_dtype="int32"))
+            output_scale = act_scale * weight_scale
+
+        dequantized = bb.emit(relax.op.astype(accum, "float32"))
+        return relax.op.multiply(dequantized, relax.const(output_scale.astype("float32"), "float32"))
+
+
+def quantize_relax_module(relax_mod, ranges, func_name="main"):
+    """
+    Rewrite quantizable layers into int8 compute with calibrated ranges.
+
+    Args:
+        relax_mod: Relax IRModule with embedded (constant) weights
+        ranges: Per-layer (min, max) from calibrate_relax_module
+
+    Returns:
+        tvm.IRModule: Quantized module
+    """
+    rewriter = _Int8Rewriter(relax_mod, ranges)
+    gv = relax_mod.get_global_var(func_name)
+    rewriter.builder_.update_func(gv, rewriter.visit_expr(relax_mod[func_name]))
+    if rewriter.index != len(ranges):
+        raise ValueError(f"Quantized {rewriter.index} layers but got {len(ranges)} ranges")
+    # Drops the now unused float weight transposes
+    return relax.transform.DeadCodeElimination()(rewriter.builder_.get())
+
+
+def _tune_and_build(relax_mod, target, use_auto_tuning, num_trials, max_workers, work_dir, opt_level, timer, label):
+    """
+    Zero pipeline, optional MetaSchedule tuning, build and export into work_dir.
+    """
+    from tvm.ir.transform import PassContext
+
+    with timer.phase(f"zero_pipeline_{label}"), target:
+        relax_mod = relax.get_pipeline("zero")(relax_mod)
+    num_tasks = count_tuning_tasks(relax_mod)
+    os.makedirs(work_dir, exist_ok=True)
+
+    if use_auto_tuning and num_trials > 0:
+        import tvm.meta_schedule as ms
+        from tvm.meta_schedule.builder import LocalBuilder
+
+        with timer.phase(f"tune_{label}"), target:
+            ms.tune_tir(
+                mod=relax_mod,
+                target=target,
+                work_dir=work_dir,
+                max_trials_global=num_trials,
+                builder=LocalBuilder(max_workers=max_workers),
+                num_tuning_cores=max_workers,
+            )
+        with timer.phase(f"apply_database_{label}"), target, PassContext(opt_level=opt_level):
+            relax_mod = relax.transform.MetaScheduleApplyDatabase(work_dir)(relax_mod)
+
+    with timer.phase(f"relax_build_{label}"):
+        ex = relax.build(relax_mod, target)
+    lib_path = os.path.join(work_dir, "compiled_lib.so")
+    with timer.phase(f"export_library_{label}"):
+        ex.export_library(lib_path)
+    return lib_path, num_tasks
+
+
+def _output_spec(func):
+    """
+    Static (shape, dtype) of a Relax function's [batch, num_classes] logits output.
+    """
+    sinfo = func.ret_struct_info
+    if isinstance(sinfo, relax.TupleStructInfo):
+        sinfo = sinfo.fields[0]
+    if not isinstance(sinfo, relax.TensorStructInfo) or sinfo.shape is None:
+        raise ValueError(f"Expected a tensor output, got {sinfo}")
+    if not all(isinstance(dim, tvm.tir.IntImm) for dim in sinfo.shape.values):
+        raise ValueError(f"Expected a static output shape, got {sinfo.shape}")
+    shape = tuple(int(dim) for dim in sinfo.shape.values)
+    if len(shape) != 2:
+        raise ValueError(f"Expected [batch, num_classes] logits, got shape {list(shape)}")
+    return shape, sinfo.dtype
+
+
+def _measure(lib_path, samples, output_spec, num_runs, num_warmup=5):
+    """
+    Mean latency (ms) on the first sample and the top-5 class ids per sample.
+
+    Args:
+        output_spec: (shape, dtype) of the logits output (see _output_spec)
+    """
+    from .inference import InferenceSession
+    from .postprocess import top_k
+
+    session = InferenceSession(lib_path)
+    input_buffer = np.empty_like(samples[0])
+    output = np.empty(*output_spec)
+    session.bind([input_buffer], [output])
+
+    np.copyto(input_buffer, samples[0])
+    for _ in range(num_warmup):
+        session.run()
+    times = []
+    for _ in range(num_runs):
+        start = time.perf_counter()
+        session.run()
+        times.append((time.perf_counter() - start) * 1000.0)
+
+    predictions = []
+    for sample in samples:
+        np.copyto(input_buffer, sample)
+        session.run()
+        predictions.append([class_id for class_id, _ in top_k(output, min(5, output.shape[-1]))[0]])
+    return float(np.mean(times)), predictions
+
+
+def quantize_with_metaschedule(
+    relax_mod_ir="",
+    calibration_dir="",
+    target_name="llvm",
+    use_auto_tuning=True,
+    num_trials=64,
+    max_workers=None,
+    work_dir="tuning_database_int8",
+    num_calibration=32,
+    calibration_method="minmax",
+    eval_dir="",
+    trace_path="",
+    num_runs=20,
+    opt_level=0
+):
+    """
+    INT8 post-training quantization pipeline with MetaSchedule tuning.
+
+    Calibrates on images from calibration_dir, quantizes conv2d/dense
+    layers, tunes and builds both the float32 and the int8 module (into
+    work_dir/float32 and work_dir/int8) and compares them on eval_dir.
+
+    Args:
+        relax_mod_ir: Relax module IR JSON with embedded weights taking a
+            [1, 3, 224, 224] image ("" = pretrained ResNet18)
+        calibration_dir: Directory of calibration images (or one image)
+        target_name: Target name (e.g., "llvm" for the host CPU, with VNNI if present)
+        use_auto_tuning: Tune both modules with MetaSchedule
+        num_trials: Trials per module
+        max_workers: Number of parallel workers (default: CPU count)
+        work_dir: Output directory
+        num_calibration: Maximum number of calibration images
+        calibration_method: "minmax" or "average"
+        eval_dir: Images for the accuracy comparison ("" = calibration images)
+        trace_path: Write phase timings as a Chrome trace to this path (optional)
+        num_runs: Timed runs per module
+        opt_level: Optimization level for applying the database
+
+    Returns:
+        dict: status, lib_path (int8), float_lib_path, num_quantized_layers,
+            float_latency_ms, int8_latency_ms, speedup, top1_agreement
+            (same top-1 class), top5_agreement (float top-1 within int8
+            top-5), num_eval_images and per-phase timings
+    """
+    from .metaschedule import _timing_result
+
+    try:
+        timer = PhaseTimer()
+
+        with timer.phase("parse_ir"):
+            if relax_mod_ir:
+                relax_mod = tvm.ir.load_json(relax_mod_ir)
+            else:
+                from .resnet_schedule import create_resnet18_relax_mod
+                relax_mod = create_resnet18_relax_mod(pretrained=True)
+
+        input_sinfo = relax_mod["main"].params[0].struct_info
+        input_shape = [int(dim) for dim in input_sinfo.shape.values]
+        if input_shape != [1, 3, 224, 224] or input_sinfo.dtype != "float32":
+            raise ValueError(f"Expected a float32 [1, 3, 224, 224] image input, got {input_shape} {input_sinfo.dtype}")
+
+        target = create_target(target_name)
+        if max_workers is None:
+            max_workers = multiprocessing.cpu_count()
+
+        with timer.phase("load_images"):
+            calibration = load_calibration_images(calibration_dir, num_calibration)
+            evaluation = load_calibration_images(eval_dir) if eval_dir else calibration
+
+        with timer.phase("calibrate"):
+            ranges = calibrate_relax_module(
+                relax_mod, [array for _, array in calibration], target, calibration_method)
+        if not ranges:
+            raise ValueError("Module has no quantizable conv2d/dense layers with constant weights")
+
+        with timer.phase("quantize"):
+            int8_mod = quantize_relax_module(relax_mod, ranges)
+
+        float_lib, _ = _tune_and_build(
+            relax_mod, target, use_auto_tuning, num_trials, max_workers,
+            os.path.join(work_dir, "float32"), opt_level, timer, "float32")
+        int8_lib, num_tasks = _tune_and_build(
+            int8_mod, target, use_auto_tuning, num_trials, max_workers,
+            os.path.join(work_dir, "int8"), opt_level, timer, "int8")
+
+        with timer.phase("evaluate"):
+            samples = [array for _, array in evaluation]
+            output_spec = _output_spec(relax_mod["main"])
+            float_ms, float_top5 = _measure(float_lib, samples, output_spec, num_runs)
+            int8_ms, int8_top5 = _measure(int8_lib, samples, output_spec, num_runs)
+
+        top1 = np.mean([f[0] == q[0] for f, q in zip(float_top5, int8_top5)])
+        top5 = np.mean([f[0] in q for f, q in zip(float_top5, int8_top5)])
+
+        result = {
+            "status": "success",
+            "lib_path": int8_lib,
+            "float_lib_path": float_lib,
+            "work_dir": work_dir,
+            "target": str(target),
+            "auto_tuning": use_auto_tuning,
+            "num_trials": num_trials if use_auto_tuning else 0,
+            "calibration_method": calibration_method,
+            "num_calibration_images": len(calibration),
+            "num_eval_images": len(evaluation),
+            "num_quantized_layers": len(ranges),
+            "float_latency_ms": float_ms,
+            "int8_latency_ms": int8_ms,
+            "speedup": float_ms / int8_ms if int8_ms > 0 else 0.0,
+            "top1_agreement": float(top1),
+            "top5_agreement": float(top5),
+        }
+        result.update(_timing_result(timer, trace_path, os.path.join(work_dir, "int8"), num_tasks))
+        return result
+
+    except Exception as e:
+        return {
+            "status": "error",
+            "error": str(e)
+        }
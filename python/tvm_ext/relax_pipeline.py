@@ -0,0 +1,250 @@
+"""
+Configurable Relax Optimization Pipelines
+
+Replaces the hard-coded relax.get_pipeline("zero") with named presets or
+custom lists of passes from RELAX_PASSES. Each pass is run and timed
+individually, and its effect on IR size (Relax bindings, PrimFuncs and TIR
+nodes) is recorded, so the latency/compile-time tradeoff of a pipeline can
+be compared per model.
+"""
+
+import time
+import numpy as np
+import tvm
+from tvm import relax
+from tvm.ir.transform import PassContext
+
+
+def static_memory_planning():
+    """
+    StaticPlanBlockMemory preceded by the lowering it expects (non-dataflow,
+    purity checks removed, call_tir rewritten to explicit allocations).
+    """
+    return tvm.transform.Sequential([
+        relax.transform.ToNonDataflow(),
+        relax.transform.RemovePurityChecking(),
+        relax.transform.CallTIRRewrite(),
+        relax.transform.StaticPlanBlockMemory(),
+    ], name="StaticMemoryPlanning")
+
+
+# Pass name -> factory
+RELAX_PASSES = {
+    "decompose_ops": relax.transform.DecomposeOpsForInference,
+    "canonicalize_bindings": relax.transform.CanonicalizeBindings,
+    "cse": relax.transform.EliminateCommonSubexpr,
+    "fold_constant": relax.transform.FoldConstant,
+    "dead_code_elimination": relax.transform.DeadCodeElimination,
+    "legalize": relax.transform.LegalizeOps,
+    "annotate_op_pattern": relax.transform.AnnotateTIROpPattern,
+    "fuse_ops": relax.transform.FuseOps,
+    "fuse_tir": relax.transform.FuseTIR,
+    "static_memory_planning": static_memory_planning,
+}
+
+_ZERO = ["legalize", "annotate_op_pattern", "fold_constant", "fuse_ops", "fuse_tir"]
+_CLEANUP = ["canonicalize_bindings", "cse", "fold_constant", "dead_code_elimination"]
+
+PIPELINE_PRESETS = {
+    # One kernel per operator, no fusion
+    "minimal": ["legalize"],
+    # Same passes as relax.get_pipeline("zero")
+    "zero": list(_ZERO),
+    # Graph-level cleanup before and after fusion
+    "optimized": _CLEANUP + _ZERO + ["dead_code_elimination"],
+    # Plus static memory planning of intermediate tensors
+    "full": _CLEANUP + _ZERO + ["dead_code_elimination", "static_memory_planning"],
+}
+
+
+def resolve_pipeline(pipeline="zero"):
+    """
+    Pass names of a pipeline.
+
+    Args:
+        pipeline: Preset name from PIPELINE_PRESETS or a list of pass names
+            from RELAX_PASSES
+
+    Returns:
+        tuple: (pipeline name, list of pass names); custom lists are named "custom"
+    """
+    if isinstance(pipeline, str):
+        if pipeline not in PIPELINE_PRESETS:
+            raise ValueError(f"Unknown pipeline preset: {pipeline} (expected one of {sorted(PIPELINE_PRESETS)})")
+        return pipeline, list(PIPELINE_PRESETS[pipeline])
+
+    passes = list(pipeline)
+    unknown = [name for name in passes if name not in RELAX_PASSES]
+    if unknown:
+        raise ValueError(f"Unknown Relax passes: {unknown} (expected names from {sorted(RELAX_PASSES)})")
+    if not passes:
+        raise ValueError("Empty Relax pass list")
+    return "custom", passes
+
+
+def ir_stats(relax_mod):
+    """
+    Size of a module: Relax functions and bindings, PrimFuncs and TIR nodes.
+    """
+    stats = {"relax_functions": 0, "bindings": 0, "primfuncs": 0, "tir_nodes": 0}
+
+    def visit_relax(expr):
+        if isinstance(expr, relax.SeqExpr):
+            stats["bindings"] += sum(len(block.bindings) for block in expr.blocks)
+
+    def visit_tir(_):
+        stats["tir_nodes"] += 1
+
+    for func in relax_mod.functions.values():
+        if isinstance(func, relax.Function):
+            stats["relax_functions"] += 1
+            relax.analysis.post_order_visit(func, visit_relax)
+        elif isinstance(func, tvm.tir.PrimFunc):
+            stats["primfuncs"] += 1
+            tvm.tir.stmt_functor.post_order_visit(func.body, visit_tir)
+    return stats
+
+
+# Passes such as EliminateCommonSubexpr and DeadCodeElimination are registered
+# with opt_level 1; a listed pass must never be skipped, so pipelines run at
+# the highest level regardless of the caller's opt_level
+_PIPELINE_OPT_LEVEL = 3
+
+
+def run_relax_pipeline(relax_mod, target, pipeline="zero", report=True):
+    """
+    Apply a pipeline pass by pass under the target.
+
+    Every listed pass runs: the passes are additionally marked as required
+    and the pipeline runs at opt_level 3, so the module is the same for
+    tuning and compiling whatever opt_level those use elsewhere.
+
+    Args:
+        relax_mod: Relax IRModule
+        target: tvm.target.Target
+        pipeline: Preset name or list of pass names (see resolve_pipeline)
+        report: Record IR size before and after each pass (costs a module walk)
+
+    Returns:
+        tuple: (transformed module, list of per-pass dicts with name, wall_ms
+            and, with report, *_before/*_after of bindings, primfuncs, tir_nodes)
+    """
+    _, passes = resolve_pipeline(pipeline)
+    reports = []
+    before = ir_stats(relax_mod) if report else None
+
+    transforms = [RELAX_PASSES[name]() for name in passes]
+    required = [transform.info.name for transform in transforms]
+    with target, PassContext(opt_level=_PIPELINE_OPT_LEVEL, required_pass=required):
+        for name, transform in zip(passes, transforms):
+            start = time.perf_counter()
+            relax_mod = transform(relax_mod)
+            entry = {"name": name, "wall_ms": (time.perf_counter() - start) * 1000.0}
+            if report:
+                after = ir_stats(relax_mod)
+                for key in ("bindings", "primfuncs", "tir_nodes"):
+                    entry[f"{key}_before"] = before[key]
+                    entry[f"{key}_after"] = after[key]
+                before = after
+            reports.append(entry)
+    return relax_mod, reports
+
+
+def get_relax_pipeline_presets():
+    """
+    Preset names and their pass lists.
+    """
+    return {name: list(passes) for name, passes in PIPELINE_PRESETS.items()}
+
+
+def compare_relax_pipelines(
+    relax_mod_ir="",
+    target_name="llvm",
+    pipelines=None,
+    num_runs=20,
+    opt_level=0
+):
+    """
+    Build a module with several pipelines (untuned) and compare them.
+
+    Args:
+        relax_mod_ir: Relax module IR JSON ("" = pretrained ResNet18)
+        target_name: Target name (e.g., "llvm")
+        pipelines: Preset names and/or pass lists (default: all presets)
+        num_runs: Timed runs per build
+        opt_level: PassContext optimization level of relax.build (the
+            pipeline passes always run, see run_relax_pipeline)
+
+    Returns:
+        dict: status, target and "results", one dict per pipeline: pipeline,
+            passes (list of names), status, error, pass_reports, pipeline_ms,
+            build_ms, mean_ms, p50_ms, num_primfuncs and max_rel_error
+            (against the first successful pipeline)
+    """
+    from .profiling import _random_inputs
+    from .target import create_target
+
+    try:
+        if relax_mod_ir:
+            relax_mod = tvm.ir.load_json(relax_mod_ir)
+        else:
+            from .resnet_schedule import create_resnet18_relax_mod
+            relax_mod = create_resnet18_relax_mod(pretrained=True)
+
+        target = create_target(target_name)
+        inputs = _random_inputs(relax_mod["main"], tvm.cpu())
+        pipelines = list(pipelines) if pipelines else list(PIPELINE_PRESETS)
+
+        results = []
+        reference = None
+        for pipeline in pipelines:
+            name, passes = resolve_pipeline(pipeline)
+            entry = {"pipeline": name, "passes": passes, "status": "success", "error": "", "pass_reports": []}
+            try:
+                mod, pass_reports = run_relax_pipeline(relax_mod, target, passes)
+                start = time.perf_counter()
+                with PassContext(opt_level=opt_level):
+                    ex = relax.build(mod, target)
+                build_ms = (time.perf_counter() - start) * 1000.0
+
+                vm = relax.VirtualMachine(ex, tvm.cpu())
+                for _ in range(3):
+                    output = vm["main"](*inputs)
+                times = []
+                for _ in range(num_runs):
+                    start = time.perf_counter()
+                    output = vm["main"](*inputs)
+                    times.append((time.perf_counter() - start) * 1000.0)
+                if not isinstance(output, tvm.runtime.Tensor):
+                    output = output[0]
+                output = output.numpy()
+            except Exception as e:
+                entry.update(status="error", error=str(e))
+                results.append(entry)
+                continue
+
+            if reference is None:
+                reference = output
+            scale = float(np.max(np.abs(reference))) or 1.0
+            entry.update({
+                "pass_reports": pass_reports,
+                "pipeline_ms": sum(report["wall_ms"] for report in pass_reports),
+                "build_ms": build_ms,
+                "mean_ms": float(np.mean(times)),
+                "p50_ms": float(np.median(times)),
+                "num_primfuncs": ir_stats(mod)["primfuncs"],
+                "max_rel_error": float(np.max(np.abs(output - reference))) / scale,
+            })
+            results.append(entry)
+
+        return {
+            "status": "success",
+            "target": str(target),
+            "results": results,
+        }
+
+    except Exception as e:
+        return {
+            "status": "error",
+            "error": str(e)
+        }
@@ -7,13 +7,16 @@ for ResNet18 model using MetaSchedule.
 
 import os
 import torch
-import torch.fx as fx
 import tvm
 from tvm import relax
 import tvm.meta_schedule as ms
 from tvm.meta_schedule.builder import LocalBuilder
 from tvm.ir.transform import PassContext
 import multiprocessing
+from .target import create_target
+from .budget import tune_with_budget_allocation_mod
+from .inference import InferenceSession, to_destination_passing
+from .models import import_fx_model
 
 
 def load_resnet18_pytorch(pretrained=True):
@@ -38,6 +41,21 @@ def load_resnet18_pytorch(pretrained=True):
     return model
 
 
+def create_resnet18_relax_mod(pretrained=True, keep_params=False):
+    """
+    Trace ResNet18 with torch.fx and import it as a Relax IRModule
+
+    Args:
+        pretrained (bool): Use pretrained weights
+        keep_params (bool): Keep parameters as input (False embeds them as constants)
+
+    Returns:
+        tvm.IRModule: Relax module taking a float32 (1, 3, 224, 224) input
+    """
+    pytorch_model = load_resnet18_pytorch(pretrained=pretrained)
+    return import_fx_model(pytorch_model, [((1, 3, 224, 224), "float32")], keep_params=keep_params)
+
+
 def create_resnet18_relax_ir(pretrained=True, keep_params=False):
     """
     Convert ResNet18 PyTorch model to TVM Relax IR
@@ -47,37 +65,27 @@ def create_resnet18_relax_ir(pretrained=True, keep_params=False):
         keep_params (bool): Keep parameters as input (False embeds them)
 
     Returns:
-        dict: Contains 'relax_mod' (IR module as string) and metadata
+        dict: Contains 'relax_mod' (IR module as string) and metadata; with
+            keep_params also 'relax_mod_json' (loadable IR with the weights
+            in the "params" attribute, for export_with_params_as_input)
     """
     try:
-        # Load PyTorch model
-        pytorch_model = load_resnet18_pytorch(pretrained=pretrained)
-
-        # Trace model using torch.fx
-        with torch.no_grad():
-            traced_model = fx.symbolic_trace(pytorch_model)
-
-        # Convert to TVM Relax IR
-        from tvm.relax.frontend.torch import from_fx
-        input_info = [((1, 3, 224, 224), "float32")]
-
-        with torch.no_grad():
-            relax_mod = from_fx(
-                traced_model,
-                input_info,
-                keep_params_as_input=keep_params
-            )
+        # Trace with torch.fx and convert to TVM Relax IR
+        relax_mod = create_resnet18_relax_mod(pretrained=pretrained, keep_params=keep_params)
 
         # Convert IR to string for C++ consumption
         relax_mod_str = str(relax_mod)
 
-        return {
+        result = {
             'status': 'success',
             'relax_mod': relax_mod_str,
             'input_shape': '(1, 3, 224, 224)',
             'dtype': 'float32',
             'pretrained': str(pretrained)
         }
+        if keep_params:
+            result['relax_mod_json'] = tvm.ir.save_json(relax_mod)
+        return result
 
     except Exception as e:
         return {
@@ -119,7 +127,8 @@ def tune_resnet18_with_metaschedule(
     num_trials=64,
     opt_level=3,
     max_workers=None,
-    work_dir="tuning_database"
+    work_dir="tuning_database",
+    allocate_budget=False
 ):
     """
     Compile and tune ResNet18 using TVM MetaSchedule
@@ -131,30 +140,19 @@ def tune_resnet18_with_metaschedule(
         opt_level (int): Optimization level (0-3)
         max_workers (int): Number of parallel workers (None = auto)
         work_dir (str): Directory for tuning database
+        allocate_budget (bool): Split num_trials across tasks by their profiled
+            share of end-to-end latency instead of fixed per-task limits
 
     Returns:
         dict: Compilation and inference results
     """
     try:
         # Load model and convert to Relax IR
-        pytorch_model = load_resnet18_pytorch(pretrained=True)
-
-        with torch.no_grad():
-            traced_model = fx.symbolic_trace(pytorch_model)
-
-        from tvm.relax.frontend.torch import from_fx
-        input_info = [((1, 3, 224, 224), "float32")]
-
-        with torch.no_grad():
-            relax_mod = from_fx(
-                traced_model,
-                input_info,
-                keep_params_as_input=False
-            )
+        relax_mod = create_resnet18_relax_mod(pretrained=True)
 
         # Setup target
         num_cores = multiprocessing.cpu_count()
-        target = tvm.target.Target(f"llvm -num-cores {num_cores}")
+        target = create_target("llvm")
 
         # Apply pipeline
         with target:
@@ -167,44 +165,54 @@ def tune_resnet18_with_metaschedule(
             if max_workers is None:
                 max_workers = num_cores
 
-            builder = LocalBuilder(max_workers=max_workers)
-
-            with target, PassContext(opt_level=opt_level):
-                ms.tune_tir(
-                    mod=relax_mod,
-                    target=target,
+            if allocate_budget:
+                # Profile-guided per-task budgets, re-weighted between rounds
+                tune_with_budget_allocation_mod(
+                    relax_mod,
+                    target,
+                    num_trials=num_trials,
+                    max_workers=max_workers,
                     work_dir=work_dir,
-                    max_trials_per_task=200,        # 각 task당 최대 200 trials
-                    num_trials_per_iter=64,         # 반복당 64 trials -> batch size
-                    max_trials_global=num_trials,
-                    builder=builder,
-                    num_tuning_cores=max_workers,
-                    post_optimization=True,         # 후처리 최적화 활성화
                 )
+            else:
+                builder = LocalBuilder(max_workers=max_workers)
+
+                with target, PassContext(opt_level=opt_level):
+                    ms.tune_tir(
+                        mod=relax_mod,
+                        target=target,
+                        work_dir=work_dir,
+                        max_trials_per_task=200,        # 각 task당 최대 200 trials
+                        num_trials_per_iter=64,         # 반복당 64 trials -> batch size
+                        max_trials_global=num_trials,
+                        builder=builder,
+                        num_tuning_cores=max_workers,
+                        post_optimization=True,         # 후처리 최적화 활성화
+                    )
 
             # Apply tuning database
             with target, PassContext(opt_level=opt_level):
                 application_pass = relax.transform.MetaScheduleApplyDatabase(work_dir)
                 relax_mod = application_pass(relax_mod)
 
-        # Build
-        ex = relax.build(relax_mod, target)
+        # Build with the output written into the bound buffer
+        ex = relax.build(to_destination_passing(relax_mod), target)
 
-        # Create VM
-        device = tvm.cpu()
-        vm = relax.VirtualMachine(ex, device)
+        # Create VM with input/output buffers bound once
+        session = InferenceSession(ex, "main", "cpu")
 
         # Load and preprocess image
         import time
         import numpy as np
 
         image_tensor = preprocess_image_for_resnet(image_path)
-        img_np = image_tensor.numpy()
-        img_tvm = tvm.runtime.tensor(img_np)
+        img_np = np.ascontiguousarray(image_tensor.numpy())
+        output_np = np.empty((1, 1000), dtype="float32")
+        session.bind([img_np], [output_np])
 
         # Warmup
         for _ in range(5):
-            _ = vm["main"](img_tvm)
+            session.run()
 
         # Benchmark
         num_iterations = 10
@@ -212,7 +220,7 @@ def tune_resnet18_with_metaschedule(
 
         for _ in range(num_iterations):
             start_time = time.time()
-            output = vm["main"](img_tvm)
+            session.run()
             end_time = time.time()
             inference_times.append((end_time - start_time) * 1000)
 
@@ -222,29 +230,14 @@ def tune_resnet18_with_metaschedule(
         min_time = float(np.min(inference_times))
         max_time = float(np.max(inference_times))
 
-        # Get predictions
-        output_np = output.numpy()
-        exp_output = np.exp(output_np - np.max(output_np))
-        probabilities = exp_output / np.sum(exp_output)
-
-        top_indices = np.argsort(probabilities[0])[::-1][:5]
-
-        # Load ImageNet labels
-        from torchvision.models import ResNet18_Weights
-        weights = ResNet18_Weights.IMAGENET1K_V1
-        categories = weights.meta["categories"]
-
-        top5_predictions = []
-        for idx in top_indices:
-            top5_predictions.append({
-                'class_id': int(idx),
-                'class_name': categories[idx],
-                'probability': float(probabilities[0][idx])
-            })
+        # Get predictions (output_np holds the last result)
+        from .postprocess import classify, imagenet_labels
+        top5_predictions = classify(output_np, k=5, labels=imagenet_labels())[0]
 
         return {
             'status': 'success',
             'tuning_enabled': str(use_auto_tuning),
+            'budget_allocation': str(allocate_budget),
             'num_trials': str(num_trials),
             'opt_level': str(opt_level),
             'work_dir': work_dir,
@@ -252,8 +245,8 @@ def tune_resnet18_with_metaschedule(
             'std_inference_time_ms': str(std_time),
             'min_inference_time_ms': str(min_time),
             'max_inference_time_ms': str(max_time),
-            'top1_class': categories[top_indices[0]],
-            'top1_probability': str(float(probabilities[0][top_indices[0]])),
+            'top1_class': top5_predictions[0]['class_name'],
+            'top1_probability': str(top5_predictions[0]['probability']),
             'num_iterations': str(num_iterations)
         }
 
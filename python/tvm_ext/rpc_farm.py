@@ -0,0 +1,227 @@
+"""
+Local RPC Measurement Farm for MetaSchedule Tuning
+
+Starts a local RPC tracker and N RPC servers, each pinned to its own core
+set, so that MetaSchedule measurements run on dedicated cores through an
+RPCRunner while builds run in separate processes on the remaining cores.
+"""
+
+import os
+import sys
+import time
+import socket
+import subprocess
+import multiprocessing
+
+
+def _free_port():
+    """
+    Ask the OS for a free TCP port on localhost.
+    """
+    with socket.socket(socket.AF_INET, socket.SOCK_STREAM) as s:
+        s.bind(("127.0.0.1", 0))
+        return s.getsockname()[1]
+
+
+def _available_cores():
+    try:
+        return sorted(os.sched_getaffinity(0))
+    except AttributeError:
+        return list(range(multiprocessing.cpu_count()))
+
+
+def partition_cores(num_servers, cores_per_server=1, cores=None):
+    """
+    Split cores into one set per RPC server plus the remainder for builders.
+
+    Args:
+        num_servers: Number of RPC servers
+        cores_per_server: Cores pinned to each server
+        cores: Cores to partition (default: cores available to this process)
+
+    Returns:
+        tuple: (list of per-server core lists, list of builder cores)
+    """
+    if cores is None:
+        cores = _available_cores()
+
+    needed = num_servers * cores_per_server
+    if needed >= len(cores):
+        raise ValueError(
+            f"{num_servers} servers x {cores_per_server} cores leave no core for "
+            f"builders ({len(cores)} cores available)"
+        )
+
+    server_cores = [
+        cores[i * cores_per_server:(i + 1) * cores_per_server]
+        for i in range(num_servers)
+    ]
+    builder_cores = cores[needed:]
+    return server_cores, builder_cores
+
+
+class LocalRPCFarm:
+    """
+    Local RPC tracker plus pinned RPC servers, usable as a context manager.
+
+    Each server runs in its own process with its CPU affinity set to its core
+    set and TVM_NUM_THREADS matching the number of cores, so concurrent
+    measurements do not share cores with each other or with builders.
+    """
+
+    def __init__(self, num_servers, cores_per_server=1, key="tvm-sdk-local", host="127.0.0.1"):
+        self.num_servers = num_servers
+        self.cores_per_server = cores_per_server
+        self.key = key
+        self.host = host
+        self.tracker_port = None
+        self.server_cores, self.builder_cores = partition_cores(num_servers, cores_per_server)
+        self._procs = []
+
+    def _spawn(self, args, cores):
+        env = dict(os.environ)
+        command = [sys.executable, "-m"] + args
+        if cores:
+            env["TVM_NUM_THREADS"] = str(len(cores))
+            # Pin in the child itself; preexec_fn is unsafe in threaded parents
+            module = args[0]
+            command = [
+                sys.executable,
+                "-c",
+                f"import os, runpy, sys; os.sched_setaffinity(0, {list(cores)}); "
+                f"runpy.run_module({module!r}, run_name='__main__', alter_sys=True)",
+            ] + args[1:]
+
+        proc = subprocess.Popen(
+            command,
+            env=env,
+            stdout=subprocess.DEVNULL,
+            stderr=subprocess.DEVNULL,
+        )
+        self._procs.append(proc)
+        return proc
+
+    def start(self, timeout_sec=30):
+        """
+        Start the tracker and all servers and wait until they registered.
+        """
+        from tvm import rpc
+
+        self.tracker_port = _free_port()
+        self._spawn([
+            "tvm.exec.rpc_tracker",
+            "--host", self.host,
+            "--port", str(self.tracker_port),
+            "--port-end", str(self.tracker_port + 1),
+        ], self.builder_cores)
+
+        for cores in self.server_cores:
+            port = _free_port()
+            self._spawn([
+                "tvm.exec.rpc_server",
+                "--host", self.host,
+                "--port", str(port),
+                "--port-end", str(port + 1),
+                "--tracker", f"{self.host}:{self.tracker_port}",
+                "--key", self.key,
+            ], cores)
+
+        deadline = time.time() + timeout_sec
+        while True:
+            try:
+                tracker = rpc.connect_tracker(self.host, self.tracker_port)
+                summary = tracker.summary()
+                free = 0
+                for item in summary.get("queue_info", {}).values():
+                    free += item.get("free", 0)
+                if free >= self.num_servers:
+                    return self
+            except Exception:
+                pass
+            if time.time() > deadline:
+                self.stop()
+                raise RuntimeError(
+                    f"RPC farm did not come up within {timeout_sec}s "
+                    f"({self.num_servers} servers on port {self.tracker_port})"
+                )
+            time.sleep(0.5)
+
+    def stop(self):
+        """
+        Terminate all servers and the tracker.
+        """
+        for proc in reversed(self._procs):
+            if proc.poll() is None:
+                proc.terminate()
+        for proc in self._procs:
+            try:
+                proc.wait(timeout=5)
+            except subprocess.TimeoutExpired:
+                proc.kill()
+        self._procs = []
+
+    def create_runner(
+        self,
+        number=3,
+        repeat=1,
+        min_repeat_ms=100,
+        session_timeout_sec=60,
+        enable_cpu_cache_flush=False
+    ):
+        """
+        Create a MetaSchedule RPCRunner measuring on this farm.
+
+        enable_cpu_cache_flush defaults to the LocalRunner behaviour (no
+        flush), so farm and local measurements are comparable.
+        """
+        import tvm.meta_schedule as ms
+
+        rpc_config = ms.runner.RPCConfig(
+            tracker_host=self.host,
+            tracker_port=self.tracker_port,
+            tracker_key=self.key,
+            session_timeout_sec=session_timeout_sec,
+        )
+        evaluator_config = ms.runner.EvaluatorConfig(
+            number=number,
+            repeat=repeat,
+            min_repeat_ms=min_repeat_ms,
+            enable_cpu_cache_flush=enable_cpu_cache_flush,
+        )
+        return ms.runner.RPCRunner(
+            rpc_config=rpc_config,
+            evaluator_config=evaluator_config,
+            max_workers=self.num_servers,
+        )
+
+    def __enter__(self):
+        return self.start()
+
+    def __exit__(self, exc_type, exc_value, tb):
+        self.stop()
+
+
+class pinned_to_cores:
+    """
+    Temporarily restrict the calling thread (and processes it spawns) to a core set.
+
+    On Linux the affinity applies to the calling thread only: other threads
+    of this process, including worker processes or threads created before
+    entering, keep their affinity. Used around tuning so that builder
+    worker processes, which are spawned from the tuning thread and inherit
+    its affinity at spawn time, stay off the cores reserved for RPC servers.
+    """
+
+    def __init__(self, cores):
+        self.cores = cores
+        self._saved = None
+
+    def __enter__(self):
+        if self.cores and hasattr(os, "sched_setaffinity"):
+            self._saved = os.sched_getaffinity(0)
+            os.sched_setaffinity(0, self.cores)
+        return self
+
+    def __exit__(self, exc_type, exc_value, tb):
+        if self._saved is not None:
+            os.sched_setaffinity(0, self._saved)
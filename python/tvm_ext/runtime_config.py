@@ -0,0 +1,414 @@
+"""
+TVM Runtime Thread Pool Configuration
+
+Sets the worker count, core placement (big/little clusters or explicit CPU
+lists), NUMA node and spin-vs-sleep waiting of the TVM runtime thread pool,
+instead of letting every executor and tuning job assume it owns all cores.
+Includes a benchmark of inference scaling over thread counts and sockets.
+"""
+
+import os
+import glob
+import time
+import multiprocessing
+import tvm
+from tvm import relax
+from .rpc_farm import pinned_to_cores
+from .target import create_target
+
+# runtime.config_threadpool affinity modes (threading_backend.h)
+_MODE_BIG = 1
+_MODE_LITTLE = -1
+_MODE_ONE_CORE_PER_THREAD = -2
+_MODE_SHARE_ALL_CORES = -3
+
+CORE_MODES = ("default", "big", "little")
+WAIT_POLICIES = ("default", "spin", "sleep")
+
+# Last configuration applied by configure_runtime (None: TVM defaults)
+_current = None
+
+# Environment variables overridden by configure_runtime, restored by reset_runtime
+_RUNTIME_ENV = ("TVM_NUM_THREADS", "TVM_THREAD_POOL_SPIN_COUNT", "OMP_WAIT_POLICY")
+_saved_env = None
+
+# Affinity of the calling thread before configure_runtime pinned it to a NUMA node
+_saved_affinity = None
+
+
+def _parse_cpulist(text):
+    """
+    Parse a kernel CPU list such as "0-3,8-11".
+    """
+    cpus = []
+    for part in text.strip().split(","):
+        if not part:
+            continue
+        if "-" in part:
+            first, last = part.split("-")
+            cpus.extend(range(int(first), int(last) + 1))
+        else:
+            cpus.append(int(part))
+    return cpus
+
+
+def _read_text(path):
+    try:
+        with open(path) as f:
+            return f.read()
+    except OSError:
+        return None
+
+
+def _allowed_cpus():
+    try:
+        return sorted(os.sched_getaffinity(0))
+    except AttributeError:
+        return list(range(multiprocessing.cpu_count()))
+
+
+def cpu_topology():
+    """
+    Describe the CPUs available to this process.
+
+    NUMA nodes come from /sys/devices/system/node; big and little cores are
+    told apart by their maximum frequency (all cores are "big" on symmetric
+    machines or when cpufreq is unavailable).
+
+    Returns:
+        dict: cpus, numa_nodes (node -> cpus), big_cores, little_cores
+    """
+    cpus = _allowed_cpus()
+    allowed = set(cpus)
+
+    numa_nodes = {}
+    for node_dir in sorted(glob.glob("/sys/devices/system/node/node[0-9]*")):
+        text = _read_text(os.path.join(node_dir, "cpulist"))
+        node_cpus = [cpu for cpu in _parse_cpulist(text or "") if cpu in allowed]
+        if node_cpus:
+            numa_nodes[int(os.path.basename(node_dir)[4:])] = node_cpus
+    if not numa_nodes:
+        numa_nodes = {0: cpus}
+
+    max_freq = {}
+    for cpu in cpus:
+        text = _read_text(f"/sys/devices/system/cpu/cpu{cpu}/cpufreq/cpuinfo_max_freq")
+        if text:
+            max_freq[cpu] = int(text)
+    if len(max_freq) == len(cpus) and len(set(max_freq.values())) > 1:
+        top = max(max_freq.values())
+        big_cores = [cpu for cpu in cpus if max_freq[cpu] == top]
+        little_cores = [cpu for cpu in cpus if max_freq[cpu] != top]
+    else:
+        big_cores, little_cores = list(cpus), []
+
+    return {
+        "cpus": cpus,
+        "numa_nodes": numa_nodes,
+        "big_cores": big_cores,
+        "little_cores": little_cores,
+    }
+
+
+def default_num_threads():
+    """
+    Thread count to plan for: the configured worker count, else
+    TVM_NUM_THREADS, else the number of CPUs this process may run on.
+    """
+    if _current is not None and _current["num_threads"] > 0:
+        return _current["num_threads"]
+    env = os.environ.get("TVM_NUM_THREADS", "")
+    if env.isdigit() and int(env) > 0:
+        return int(env)
+    return len(_allowed_cpus())
+
+
+def configure_runtime(
+    num_threads=0,
+    core_mode="default",
+    cpus=None,
+    numa_node=-1,
+    pin_threads=True,
+    wait_policy="default",
+    spin_count=-1
+):
+    """
+    Configure the TVM runtime thread pool of this process.
+
+    Args:
+        num_threads: Worker count (0 = one per selected core)
+        core_mode: "default", "big" or "little" core cluster (ignored with cpus/numa_node)
+        cpus: Explicit CPU ids for the workers; with numa_node, those on the
+            node are used (an error if none is, before anything changes)
+        numa_node: Restrict workers to this NUMA node's CPUs (-1 = any). The
+            calling thread is pinned there too, so weights and workspaces it
+            allocates afterwards are placed on that node (first touch);
+            reset_runtime restores its previous affinity.
+        pin_threads: Pin each worker to one core (False: workers share the set)
+        wait_policy: "spin", "sleep" or "default". Read by the runtime when its
+            pool first starts, so set it before the first parallel kernel runs.
+        spin_count: Explicit spin iterations before sleeping (-1 = from wait_policy)
+
+    Returns:
+        dict: Applied configuration (num_threads, cpus, core_mode, numa_node,
+            wait_policy, spin_count)
+    """
+    global _current, _saved_env, _saved_affinity
+
+    try:
+        if core_mode not in CORE_MODES:
+            raise ValueError(f"Unknown core mode '{core_mode}' (expected one of {CORE_MODES})")
+        if wait_policy not in WAIT_POLICIES:
+            raise ValueError(f"Unknown wait policy '{wait_policy}' (expected one of {WAIT_POLICIES})")
+
+        topology = cpu_topology()
+        if numa_node >= 0:
+            if numa_node not in topology["numa_nodes"]:
+                raise ValueError(f"NUMA node {numa_node} has no CPUs available to this process")
+            node_cpus = topology["numa_nodes"][numa_node]
+            if cpus:
+                requested = cpus
+                cpus = [cpu for cpu in cpus if cpu in node_cpus]
+                if not cpus:
+                    raise ValueError(f"None of cpus {list(requested)} is on NUMA node {numa_node}")
+            else:
+                cpus = node_cpus
+        elif not cpus and core_mode != "default":
+            cpus = topology["big_cores"] if core_mode == "big" else topology["little_cores"]
+            if not cpus:
+                raise ValueError(f"No {core_mode} cores on this machine")
+        cpus = [int(cpu) for cpu in cpus] if cpus else []
+
+        if num_threads <= 0:
+            num_threads = len(cpus) if cpus else len(topology["cpus"])
+        if cpus and pin_threads and num_threads > len(cpus):
+            raise ValueError(f"{num_threads} pinned threads need at least as many cpus, got {len(cpus)}")
+
+        if _saved_env is None:
+            _saved_env = {name: os.environ.get(name) for name in _RUNTIME_ENV}
+        if spin_count < 0 and wait_policy != "default":
+            spin_count = 0 if wait_policy == "sleep" else 300000
+        if spin_count >= 0:
+            os.environ["TVM_THREAD_POOL_SPIN_COUNT"] = str(spin_count)
+        if wait_policy != "default":
+            # OpenMP-backed runtimes
+            os.environ["OMP_WAIT_POLICY"] = "ACTIVE" if wait_policy == "spin" else "PASSIVE"
+        # Inherited by builder and RPC server processes
+        os.environ["TVM_NUM_THREADS"] = str(num_threads)
+
+        config_threadpool = tvm.get_global_func("runtime.config_threadpool")
+        if cpus:
+            mode = _MODE_ONE_CORE_PER_THREAD if pin_threads else _MODE_SHARE_ALL_CORES
+            config_threadpool(mode, num_threads, [str(cpu) for cpu in cpus])
+        else:
+            config_threadpool(_MODE_LITTLE if core_mode == "little" else _MODE_BIG, num_threads, [])
+
+        if numa_node >= 0 and hasattr(os, "sched_setaffinity"):
+            if _saved_affinity is None:
+                _saved_affinity = os.sched_getaffinity(0)
+            os.sched_setaffinity(0, cpus)
+
+        _current = {
+            "num_threads": num_threads,
+            "cpus": cpus,
+            "core_mode": core_mode,
+            "numa_node": numa_node,
+            "pin_threads": pin_threads,
+            "wait_policy": wait_policy,
+            "spin_count": spin_count,
+        }
+        return dict(_current, status="success")
+
+    except Exception as e:
+        return {
+            "status": "error",
+            "error": str(e)
+        }
+
+
+def reset_runtime():
+    """
+    Return the thread pool to TVM's defaults and undo environment and
+    calling-thread affinity changes.
+    """
+    global _current, _saved_env, _saved_affinity
+
+    tvm.get_global_func("runtime.config_threadpool")(_MODE_BIG, 0, [])
+    if _saved_affinity is not None:
+        os.sched_setaffinity(0, _saved_affinity)
+        _saved_affinity = None
+    if _saved_env is not None:
+        for name, value in _saved_env.items():
+            if value is None:
+                os.environ.pop(name, None)
+            else:
+                os.environ[name] = value
+    _current = None
+    _saved_env = None
+
+
+def runtime_config():
+    """
+    Configuration last applied by configure_runtime (None: TVM defaults).
+    """
+    return dict(_current) if _current is not None else None
+
+
+def localize_tensors(tensors, numa_node):
+    """
+    Copy CPU tensors into memory on one NUMA node.
+
+    The copies are made from a thread pinned to the node, so the kernel
+    places their pages there on first touch. Used to give each socket its
+    own replica of shared weights.
+
+    Args:
+        tensors: tvm.runtime.Tensor list
+        numa_node: Target NUMA node
+
+    Returns:
+        list: Node-local tvm.runtime.Tensor copies
+    """
+    node_cpus = cpu_topology()["numa_nodes"].get(numa_node)
+    if not node_cpus:
+        raise ValueError(f"NUMA node {numa_node} has no CPUs available to this process")
+
+    with pinned_to_cores(node_cpus):
+        local = []
+        for tensor in tensors:
+            copy = tvm.runtime.empty(tensor.shape, tensor.dtype, tvm.cpu())
+            copy.copyfrom(tensor)
+            local.append(copy)
+        return local
+
+
+def _placement_cpus(topology, num_threads, placement):
+    """
+    Choose CPUs for num_threads workers: "compact" fills one NUMA node
+    before the next, "spread" alternates between nodes.
+    """
+    nodes = [topology["numa_nodes"][node] for node in sorted(topology["numa_nodes"])]
+    if placement == "compact":
+        order = [cpu for node_cpus in nodes for cpu in node_cpus]
+    else:
+        order = []
+        for i in range(max(len(node_cpus) for node_cpus in nodes)):
+            order.extend(node_cpus[i] for node_cpus in nodes if i < len(node_cpus))
+    return order[:num_threads]
+
+
+def benchmark_thread_scaling(
+    relax_mod_ir,
+    target_name="llvm",
+    thread_counts=None,
+    num_runs=20,
+    num_warmup=3,
+    pipeline="zero"
+):
+    """
+    Measure inference latency over thread counts and NUMA placements.
+
+    The module is built once. For every thread count, the runtime pool is
+    reconfigured and a fresh VM is created on the chosen cores, so its
+    workspaces are local to them. On multi-socket hosts each count is run
+    "compact" (fill one socket first) and "spread" (alternate sockets).
+
+    Args:
+        relax_mod_ir: Relax module IR string
+        target_name: Target name (e.g., "llvm")
+        thread_counts: Thread counts to run (default: powers of two up to the CPU count)
+        num_runs: Timed runs per configuration
+        num_warmup: Untimed runs per configuration
+        pipeline: Relax pipeline preset or pass list (see relax_pipeline)
+
+    Returns:
+        dict: Benchmark status, num_numa_nodes and a results list with
+            placement, num_threads, numa_nodes_used, mean_ms, p50_ms, std_ms,
+            speedup (vs. 1 thread) and efficiency (speedup / threads)
+    """
+    import numpy as np
+    from .profiling import _random_inputs
+    from .relax_pipeline import run_relax_pipeline
+
+    previous = runtime_config()
+    try:
+        topology = cpu_topology()
+        max_threads = len(topology["cpus"])
+        if not thread_counts:
+            thread_counts = []
+            count = 1
+            while count < max_threads:
+                thread_counts.append(count)
+                count *= 2
+            thread_counts.append(max_threads)
+        thread_counts = sorted({1} | {int(n) for n in thread_counts if 0 < int(n) <= max_threads})
+
+        relax_mod = tvm.ir.load_json(relax_mod_ir)
+        target = create_target(target_name)
+        relax_mod, _ = run_relax_pipeline(relax_mod, target, pipeline, report=False)
+        ex = relax.build(relax_mod, target)
+        device = tvm.cpu()
+
+        placements = ["compact"] if len(topology["numa_nodes"]) == 1 else ["compact", "spread"]
+        results = []
+        for placement in placements:
+            baseline_ms = None
+            for num_threads in thread_counts:
+                cpus = _placement_cpus(topology, num_threads, placement)
+                applied = configure_runtime(num_threads=num_threads, cpus=cpus)
+                if applied["status"] != "success":
+                    raise RuntimeError(applied["error"])
+
+                with pinned_to_cores(cpus):
+                    vm = relax.VirtualMachine(ex, device)
+                    inputs = _random_inputs(relax_mod["main"], device)
+                    for _ in range(num_warmup):
+                        vm["main"](*inputs)
+                    times = []
+                    for _ in range(num_runs):
+                        start = time.perf_counter()
+                        vm["main"](*inputs)
+                        times.append((time.perf_counter() - start) * 1000.0)
+
+                mean_ms = float(np.mean(times))
+                if baseline_ms is None:
+                    baseline_ms = mean_ms
+                speedup = baseline_ms / mean_ms if mean_ms > 0 else 0.0
+                used_nodes = [
+                    node for node, node_cpus in topology["numa_nodes"].items()
+                    if set(node_cpus) & set(cpus)
+                ]
+                results.append({
+                    "placement": placement,
+                    "num_threads": num_threads,
+                    "numa_nodes_used": len(used_nodes),
+                    "mean_ms": mean_ms,
+                    "p50_ms": float(np.median(times)),
+                    "std_ms": float(np.std(times)),
+                    "speedup": speedup,
+                    "efficiency": speedup / num_threads,
+                })
+
+        return {
+            "status": "success",
+            "target": str(target),
+            "num_numa_nodes": len(topology["numa_nodes"]),
+            "num_runs": num_runs,
+            "results": results,
+        }
+
+    except Exception as e:
+        return {
+            "status": "error",
+            "error": str(e)
+        }
+
+    finally:
+        if previous is not None:
+            configure_runtime(**previous)
+        else:
+            reset_runtime()
+
+
+if __name__ == "__main__":
+    print(f"CPU topology: {cpu_topology()}")
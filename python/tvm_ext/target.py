@@ -0,0 +1,393 @@
+"""
+Host CPU Detection and LLVM Target Construction
+
+Detects the host microarchitecture and ISA extensions so that targets are
+built with -mcpu/-mattr instead of a bare `llvm -num-cores N`, and builds
+per-CPU library variants that are selected at load time.
+"""
+
+import os
+import json
+import platform
+import multiprocessing
+import tvm
+from tvm import relax
+
+
+# /proc/cpuinfo flag -> LLVM feature name
+_X86_FEATURES = {
+    "sse4_1": "sse4.1",
+    "sse4_2": "sse4.2",
+    "avx": "avx",
+    "avx2": "avx2",
+    "fma": "fma",
+    "f16c": "f16c",
+    "bmi2": "bmi2",
+    "avx512f": "avx512f",
+    "avx512bw": "avx512bw",
+    "avx512dq": "avx512dq",
+    "avx512vl": "avx512vl",
+    "avx512cd": "avx512cd",
+    "avx512_vnni": "avx512vnni",
+    "avx_vnni": "avxvnni",
+    "avx512_bf16": "avx512bf16",
+    "avx512_fp16": "avx512fp16",
+    "amx_tile": "amx-tile",
+    "amx_int8": "amx-int8",
+    "amx_bf16": "amx-bf16",
+}
+
+_AARCH64_FEATURES = {
+    "asimd": "neon",
+    "asimddp": "dotprod",
+    "fphp": "fullfp16",
+    "i8mm": "i8mm",
+    "bf16": "bf16",
+    "sve": "sve",
+    "sve2": "sve2",
+}
+
+_AVX512_BASE = ["avx2", "fma", "avx512f", "avx512bw", "avx512dq", "avx512vl", "avx512cd"]
+
+# Known CPU variants (LLVM -mcpu name) and the ISA features they require
+CPU_VARIANTS = {
+    "x86-64": [],
+    "haswell": ["avx2", "fma"],
+    "skylake-avx512": _AVX512_BASE,
+    "cascadelake": _AVX512_BASE + ["avx512vnni"],
+    "cooperlake": _AVX512_BASE + ["avx512vnni", "avx512bf16"],
+    "sapphirerapids": _AVX512_BASE + ["avx512vnni", "avx512bf16", "amx-tile", "amx-int8", "amx-bf16"],
+    "znver3": ["avx2", "fma"],
+    "znver4": _AVX512_BASE + ["avx512vnni", "avx512bf16"],
+    "generic": [],
+    "neoverse-n1": ["neon", "dotprod", "fullfp16"],
+    "neoverse-v1": ["neon", "dotprod", "fullfp16", "i8mm", "bf16", "sve"],
+}
+
+# Architecture (triple prefix) of each known CPU variant
+_VARIANT_ARCH = {
+    mcpu: ("aarch64" if mcpu in ("generic", "neoverse-n1", "neoverse-v1") else "x86_64")
+    for mcpu in CPU_VARIANTS
+}
+
+VARIANT_MANIFEST = "cpu_variants.json"
+
+
+def _read_cpuinfo_flags():
+    """
+    Read ISA flags of the first processor from /proc/cpuinfo.
+
+    Returns:
+        set: Raw flag names (empty if unavailable)
+    """
+    try:
+        with open("/proc/cpuinfo") as f:
+            for line in f:
+                key, _, value = line.partition(":")
+                if key.strip() in ("flags", "Features"):
+                    return set(value.split())
+    except OSError:
+        pass
+    return set()
+
+
+def _system_llvm_cpu():
+    """
+    Query the host CPU name from TVM's LLVM backend.
+    """
+    try:
+        return str(tvm.target.codegen.llvm_get_system_cpu())
+    except Exception:
+        return ""
+
+
+def _system_llvm_triple():
+    try:
+        return str(tvm.target.codegen.llvm_get_system_triple())
+    except Exception:
+        return ""
+
+
+def _normalize_arch(arch):
+    return {"amd64": "x86_64", "arm64": "aarch64"}.get(arch, arch)
+
+
+def variant_triple(mcpu, host_triple=None):
+    """
+    LLVM triple for a known CPU variant.
+
+    The host triple is reused when it has the variant's architecture,
+    otherwise its architecture component is replaced (or a Linux triple is
+    formed when the host triple is unknown).
+
+    Args:
+        mcpu: Name in CPU_VARIANTS
+        host_triple: Host triple (default: detected)
+
+    Returns:
+        str: Triple, e.g. "aarch64-unknown-linux-gnu"
+    """
+    arch = _VARIANT_ARCH[mcpu]
+    if host_triple is None:
+        host_triple = _system_llvm_triple()
+    if not host_triple:
+        return f"{arch}-unknown-linux-gnu"
+    host_arch, sep, rest = host_triple.partition("-")
+    if _normalize_arch(host_arch) == arch:
+        return host_triple
+    return arch + sep + rest if sep else f"{arch}-unknown-linux-gnu"
+
+
+def detect_host_cpu():
+    """
+    Detect host microarchitecture and ISA extensions.
+
+    Returns:
+        dict: mcpu, triple, arch, features (LLVM names), vector_width_bits, num_cores
+    """
+    arch = platform.machine().lower()
+    flags = _read_cpuinfo_flags()
+    table = _AARCH64_FEATURES if arch in ("aarch64", "arm64") else _X86_FEATURES
+    features = sorted(table[flag] for flag in flags if flag in table)
+
+    if "avx512f" in features:
+        vector_width_bits = 512
+    elif "avx2" in features or "avx" in features:
+        vector_width_bits = 256
+    else:
+        vector_width_bits = 128
+
+    return {
+        "mcpu": _system_llvm_cpu(),
+        "triple": _system_llvm_triple(),
+        "arch": arch,
+        "features": features,
+        "vector_width_bits": vector_width_bits,
+        "num_cores": multiprocessing.cpu_count(),
+    }
+
+
+def build_llvm_target_string(mcpu=None, mattr=None, num_cores=None, triple=None):
+    """
+    Build a fully specified LLVM target string for the host.
+
+    Args:
+        mcpu: CPU name (default: detected host CPU)
+        mattr: List of LLVM features (default: detected host features)
+        num_cores: Number of cores (default: the configured runtime thread
+            count, see runtime_config.default_num_threads)
+        triple: LLVM triple (default: detected host triple)
+
+    Returns:
+        str: Target string, e.g. "llvm -mcpu=cascadelake -mattr=+avx2,... -num-cores 16"
+    """
+    host = detect_host_cpu()
+    if mcpu is None:
+        mcpu = host["mcpu"]
+    if mattr is None:
+        mattr = host["features"]
+    if num_cores is None:
+        from .runtime_config import default_num_threads
+        num_cores = default_num_threads()
+    if triple is None:
+        triple = host["triple"]
+
+    parts = ["llvm"]
+    if triple:
+        parts.append(f"-mtriple={triple}")
+    if mcpu:
+        parts.append(f"-mcpu={mcpu}")
+    if mattr:
+        parts.append("-mattr=" + ",".join(f"+{feat}" for feat in mattr))
+    parts.append(f"-num-cores {num_cores}")
+    return " ".join(parts)
+
+
+def create_target(target_name="llvm"):
+    """
+    Create a TVM target, fully specifying bare "llvm" for the host CPU.
+
+    A bare "llvm" is expanded with the detected -mcpu/-mattr. LLVM targets
+    that already carry options are kept as given (with -num-cores added
+    when missing). -num-cores follows the runtime thread configuration
+    rather than the machine's CPU count. Other targets are passed through
+    unchanged.
+
+    Args:
+        target_name: Target name or string (e.g., "llvm", "llvm -mcpu=haswell", "cuda")
+
+    Returns:
+        tvm.target.Target: Target object
+    """
+    target_name = target_name.strip()
+    if target_name == "llvm":
+        return tvm.target.Target(build_llvm_target_string())
+    if target_name.startswith("llvm") and "-num-cores" not in target_name:
+        from .runtime_config import default_num_threads
+        return tvm.target.Target(f"{target_name} -num-cores {default_num_threads()}")
+    return tvm.target.Target(target_name)
+
+
+def build_cpu_variants(
+    relax_mod_ir,
+    variants=None,
+    work_dir="tuning_database",
+    opt_level=0,
+    pipeline="zero"
+):
+    """
+    Build one library per CPU variant and write a manifest for runtime selection.
+
+    Args:
+        relax_mod_ir: Relax module IR string
+        variants: List of CPU names from CPU_VARIANTS (None or empty: the
+            known variants of the host architecture, see detect_host_cpu);
+            each is built for its own architecture's triple
+        work_dir: Directory containing tuning database and output libraries
+        opt_level: Optimization level (0-3)
+        pipeline: Relax pipeline preset or pass list (see relax_pipeline);
+            must match the one used to tune for records to apply
+
+    Returns:
+        dict: Build status and per-variant library paths
+    """
+    from tvm.ir.transform import PassContext
+    from .relax_pipeline import run_relax_pipeline
+
+    try:
+        if not variants:
+            host_arch = _normalize_arch(detect_host_cpu()["arch"])
+            variants = [mcpu for mcpu in CPU_VARIANTS if _VARIANT_ARCH[mcpu] == host_arch]
+            if not variants:
+                raise ValueError(f"No known CPU variants for host architecture {host_arch!r}")
+
+        unknown = [mcpu for mcpu in variants if mcpu not in CPU_VARIANTS]
+        if unknown:
+            raise ValueError(f"Unknown CPU variants {unknown} (known: {sorted(CPU_VARIANTS)})")
+
+        relax_mod = tvm.ir.load_json(relax_mod_ir)
+        os.makedirs(work_dir, exist_ok=True)
+        use_database = os.path.exists(os.path.join(work_dir, "database_workload.json"))
+
+        host_triple = _system_llvm_triple()
+        manifest = []
+        for mcpu in variants:
+            features = CPU_VARIANTS[mcpu]
+            target = tvm.target.Target(
+                build_llvm_target_string(mcpu=mcpu, mattr=features, triple=variant_triple(mcpu, host_triple))
+            )
+
+            mod, _ = run_relax_pipeline(relax_mod, target, pipeline, report=False)
+
+            if use_database:
+                with target, PassContext(opt_level=opt_level):
+                    mod = relax.transform.MetaScheduleApplyDatabase(work_dir)(mod)
+
+            lib_path = os.path.join(work_dir, f"compiled_lib_{mcpu}.so")
+            relax.build(mod, target).export_library(lib_path)
+
+            manifest.append({
+                "mcpu": mcpu,
+                "arch": _VARIANT_ARCH[mcpu],
+                "features": features,
+                "lib_path": lib_path,
+                "target": str(target),
+            })
+
+        manifest_path = os.path.join(work_dir, VARIANT_MANIFEST)
+        with open(manifest_path, "w") as f:
+            json.dump({"variants": manifest}, f, indent=2)
+
+        return {
+            "status": "success",
+            "manifest_path": manifest_path,
+            "variants": [entry["mcpu"] for entry in manifest],
+            "lib_paths": [entry["lib_path"] for entry in manifest],
+            "work_dir": work_dir
+        }
+
+    except Exception as e:
+        return {
+            "status": "error",
+            "error": str(e)
+        }
+
+
+def select_cpu_variant(work_dir="tuning_database"):
+    """
+    Pick the best library variant from the manifest for the running CPU.
+
+    A variant is eligible when it is a known CPU of the host's architecture
+    and all its required features are present on the host; unknown CPU
+    names are never eligible. Among eligible variants an exact -mcpu match
+    wins, otherwise the one requiring the most features.
+
+    Args:
+        work_dir: Directory containing the variant manifest
+
+    Returns:
+        dict: Selected variant (mcpu, lib_path, target)
+    """
+    try:
+        manifest_path = os.path.join(work_dir, VARIANT_MANIFEST)
+        with open(manifest_path) as f:
+            variants = json.load(f)["variants"]
+
+        host = detect_host_cpu()
+        host_features = set(host["features"])
+        host_arch = _normalize_arch(host["arch"])
+
+        eligible = [
+            v for v in variants
+            if v["mcpu"] in CPU_VARIANTS
+            and _VARIANT_ARCH[v["mcpu"]] == host_arch
+            and set(v["features"]) <= host_features
+        ]
+        if not eligible:
+            return {
+                "status": "error",
+                "error": f"No compatible CPU variant in {manifest_path}"
+            }
+
+        best = max(eligible, key=lambda v: (v["mcpu"] == host["mcpu"], len(v["features"])))
+
+        return {
+            "status": "success",
+            "mcpu": best["mcpu"],
+            "lib_path": best["lib_path"],
+            "target": best["target"],
+            "host_mcpu": host["mcpu"]
+        }
+
+    except Exception as e:
+        return {
+            "status": "error",
+            "error": str(e)
+        }
+
+
+def load_cpu_variant(work_dir="tuning_database", device=None):
+    """
+    Load the best library variant for the running CPU into a Relax VM.
+
+    Args:
+        work_dir: Directory containing the variant manifest
+        device: TVM device (default: tvm.cpu())
+
+    Returns:
+        relax.VirtualMachine: VM over the selected library
+    """
+    selected = select_cpu_variant(work_dir)
+    if selected["status"] != "success":
+        raise RuntimeError(selected["error"])
+
+    if device is None:
+        device = tvm.cpu()
+    lib = tvm.runtime.load_module(selected["lib_path"])
+    return relax.VirtualMachine(lib, device)
+
+
+if __name__ == "__main__":
+    host = detect_host_cpu()
+    print(f"Host CPU: {host}")
+    print(f"Target: {build_llvm_target_string()}")
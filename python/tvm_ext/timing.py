@@ -0,0 +1,146 @@
+"""
+Phase-Level Timing for Compile and Tune Pipelines
+
+Records wall time, CPU time and peak RSS per pipeline phase (IR parsing,
+zero pipeline, tuning, database application, build, export) and writes
+them as a Chrome trace (chrome://tracing / Perfetto).
+"""
+
+import os
+import json
+import time
+import threading
+from contextlib import contextmanager
+from . import tracing
+
+try:
+    import resource
+except ImportError:  # Windows
+    resource = None
+
+
+def _peak_rss_kb():
+    """
+    Peak resident set size of this process and of its waited-for children (KB).
+    """
+    if resource is None:
+        return 0, 0
+    self_kb = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    children_kb = resource.getrusage(resource.RUSAGE_CHILDREN).ru_maxrss
+    return int(self_kb), int(children_kb)
+
+
+def current_rss_kb():
+    """
+    Current (not peak) resident set size of this process in KB (0 if unknown).
+    """
+    try:
+        with open("/proc/self/statm") as f:
+            pages = int(f.read().split()[1])
+        return pages * os.sysconf("SC_PAGE_SIZE") // 1024
+    except (OSError, ValueError, IndexError):
+        return 0
+
+
+def _children_cpu_secs():
+    times = os.times()
+    return times.children_user + times.children_system
+
+
+class PhaseTimer:
+    """
+    Collects per-phase timings of a pipeline run.
+
+    Usage:
+        timer = PhaseTimer()
+        with timer.phase("relax_build"):
+            ex = relax.build(mod, target)
+        timer.to_list()
+    """
+
+    def __init__(self):
+        self.phases = []
+        self._origin = time.perf_counter()
+
+    @contextmanager
+    def phase(self, name):
+        """
+        Time a phase; nested phases are recorded independently.
+
+        The phase is also recorded on the SDK trace timeline when tracing
+        is enabled.
+        """
+        start_trace = tracing.now_us()
+        start_wall = time.perf_counter()
+        start_cpu = time.process_time()
+        start_children_cpu = _children_cpu_secs()
+        try:
+            yield
+        finally:
+            wall = time.perf_counter() - start_wall
+            cpu = time.process_time() - start_cpu
+            children_cpu = _children_cpu_secs() - start_children_cpu
+            rss_kb, children_rss_kb = _peak_rss_kb()
+            tracing.record(name, start_trace, wall * 1e6, category="pipeline")
+            self.phases.append({
+                "name": name,
+                "start_us": (start_wall - self._origin) * 1e6,
+                "wall_ms": wall * 1e3,
+                "cpu_ms": cpu * 1e3,
+                "children_cpu_ms": children_cpu * 1e3,
+                "peak_rss_kb": rss_kb,
+                "children_peak_rss_kb": children_rss_kb,
+            })
+
+    def to_list(self):
+        """
+        Phases in completion order as a list of dicts.
+        """
+        return list(self.phases)
+
+    def write_chrome_trace(self, path):
+        """
+        Write phases as complete ("X") events in Chrome trace format.
+        """
+        pid = os.getpid()
+        tid = threading.get_ident() & 0xFFFFFFFF
+        events = []
+        for phase in self.phases:
+            events.append({
+                "name": phase["name"],
+                "cat": "pipeline",
+                "ph": "X",
+                "ts": phase["start_us"],
+                "dur": phase["wall_ms"] * 1e3,
+                "pid": pid,
+                "tid": tid,
+                "args": {
+                    "cpu_ms": phase["cpu_ms"],
+                    "children_cpu_ms": phase["children_cpu_ms"],
+                    "peak_rss_kb": phase["peak_rss_kb"],
+                },
+            })
+
+        directory = os.path.dirname(path)
+        if directory:
+            os.makedirs(directory, exist_ok=True)
+        with open(path, "w") as f:
+            json.dump({"traceEvents": events, "displayTimeUnit": "ms"}, f)
+        return path
+
+
+def count_tuning_tasks(relax_mod):
+    """
+    Number of PrimFuncs MetaSchedule will extract as tuning tasks.
+    """
+    import tvm
+
+    count = 0
+    for _, func in relax_mod.functions.items():
+        if not isinstance(func, tvm.tir.PrimFunc):
+            continue
+        attrs = func.attrs
+        if attrs is not None and "tir.is_scheduled" in attrs and bool(attrs["tir.is_scheduled"]):
+            continue
+        count += 1
+    return count
@@ -0,0 +1,179 @@
+"""
+Python Side of the SDK Trace Timeline
+
+Records Python scopes, tvm_ext/torch_ext function calls and TVM runtime
+kernels into the C++ tracer's per-thread buffers (embedded module
+`_tvm_sdk_trace`), so that they appear on one Chrome trace timeline with
+C++ SDK calls and GIL waits. Without the embedded module (plain Python
+process), everything here is a no-op.
+"""
+
+import os
+import sys
+import threading
+from contextlib import contextmanager
+from functools import wraps
+
+try:
+    import _tvm_sdk_trace as _native
+except ImportError:
+    _native = None
+
+
+_PYTHON_ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+_TRACED_PACKAGES = ("tvm_ext", "torch_ext")
+
+
+def enabled():
+    """
+    Check if the C++ tracer is recording.
+    """
+    return _native is not None and _native.enabled()
+
+
+def now_us():
+    """
+    Current time on the tracer clock (microseconds).
+    """
+    return _native.now_us() if _native is not None else 0.0
+
+
+def record(name, start_us, dur_us, category="python"):
+    """
+    Record a complete event on the calling thread.
+    """
+    if enabled():
+        _native.record(category, name, start_us, dur_us)
+
+
+@contextmanager
+def trace_scope(name, category="python"):
+    """
+    Trace a block of Python code.
+
+    Usage:
+        with trace_scope("preprocess"):
+            ...
+    """
+    if not enabled() or not _native.sample():
+        yield
+        return
+    start = _native.now_us()
+    try:
+        yield
+    finally:
+        _native.record(category, name, start, _native.now_us() - start)
+
+
+def traced(name=None, category="python"):
+    """
+    Decorator tracing every call of a function.
+    """
+    def decorator(func):
+        event_name = name or f"{func.__module__}.{func.__qualname__}"
+
+        @wraps(func)
+        def wrapper(*args, **kwargs):
+            with trace_scope(event_name, category):
+                return func(*args, **kwargs)
+        return wrapper
+    return decorator
+
+
+class _ProfileHook:
+    """
+    sys.setprofile hook timing calls of functions defined in the given packages.
+    """
+
+    def __init__(self, packages):
+        self.prefixes = tuple(os.path.join(_PYTHON_ROOT, package) + os.sep for package in packages)
+        self.own_file = os.path.abspath(__file__)
+        self.starts = {}
+
+    def _traced(self, code):
+        filename = code.co_filename
+        return filename.startswith(self.prefixes) and filename != self.own_file
+
+    def __call__(self, frame, event, arg):
+        if event == "call":
+            if self._traced(frame.f_code) and _native.sample():
+                self.starts[id(frame)] = _native.now_us()
+        elif event == "return":
+            start = self.starts.pop(id(frame), None)
+            if start is not None:
+                code = frame.f_code
+                name = f"{frame.f_globals.get('__name__', '?')}.{getattr(code, 'co_qualname', code.co_name)}"
+                _native.record("python", name, start, _native.now_us() - start)
+
+
+_hook = None
+
+
+def install_profile_hook(packages=_TRACED_PACKAGES):
+    """
+    Trace every Python function call in the given packages.
+
+    Installed for the calling thread and for threads started afterwards
+    (all threads on Python 3.12+). Called by Tracer::start() when
+    TraceConfig::trace_python is set.
+
+    Returns:
+        bool: Whether the hook was installed
+    """
+    global _hook
+    if _native is None:
+        return False
+    _hook = _ProfileHook(packages)
+    if hasattr(threading, "setprofile_all_threads"):
+        threading.setprofile_all_threads(_hook)
+    else:
+        threading.setprofile(_hook)
+        sys.setprofile(_hook)
+    return True
+
+
+def uninstall_profile_hook():
+    """
+    Remove the hook installed by install_profile_hook().
+    """
+    global _hook
+    if _hook is None:
+        return
+    if hasattr(threading, "setprofile_all_threads"):
+        threading.setprofile_all_threads(None)
+    else:
+        threading.setprofile(None)
+        sys.setprofile(None)
+    _hook = None
+
+
+def trace_vm_kernels(vm, func_name, *args):
+    """
+    Run a Relax VM function under the VM profiler and record its kernels.
+
+    The VM report carries durations but no timestamps, so kernel events are
+    laid out back to back from the start of the profiled run.
+
+    Args:
+        vm: relax.VirtualMachine created with profile=True
+        func_name: Function to run (e.g., "main")
+        *args: Function arguments
+
+    Returns:
+        Report: The VM profiler report
+    """
+    import json
+    from .profiling import _metric_value
+
+    start = now_us()
+    report = vm.profile(func_name, *args)
+    if not enabled():
+        return report
+
+    cursor = start
+    for call in json.loads(report.json()).get("calls", []):
+        name = _metric_value(call.get("Name")) or "?"
+        dur = float(_metric_value(call.get("Duration (us)")) or 0.0)
+        _native.record("kernel", str(name), cursor, dur)
+        cursor += dur
+    return report
@@ -0,0 +1,295 @@
+"""
+Configurable MetaSchedule Tuning
+
+Maps a plain tuning configuration dict (built from the C++ TuningConfig)
+onto MetaSchedule cost models, search strategies, space generators,
+postprocessors and an early-stopping measure callback.
+"""
+
+import os
+import multiprocessing
+import tvm
+from tvm import relax
+from .relax_pipeline import run_relax_pipeline
+from .target import create_target
+
+
+_MUTATORS = {
+    "tile_size": lambda ms: ms.mutator.MutateTileSize(),
+    "parallel": lambda ms: ms.mutator.MutateParallel(max_jobs_per_core=16),
+    "unroll": lambda ms: ms.mutator.MutateUnroll(),
+    "compute_location": lambda ms: ms.mutator.MutateComputeLocation(),
+    "thread_binding": lambda ms: ms.mutator.MutateThreadBinding(),
+}
+
+_POSTPROCS = {
+    "disallow_dynamic_loop": lambda ms: ms.postproc.DisallowDynamicLoop(),
+    "rewrite_parallel_vectorize_unroll": lambda ms: ms.postproc.RewriteParallelVectorizeUnroll(),
+    "rewrite_reduction_block": lambda ms: ms.postproc.RewriteReductionBlock(),
+    "rewrite_layout": lambda ms: ms.postproc.RewriteLayout(),
+    "rewrite_cooperative_fetch": lambda ms: ms.postproc.RewriteCooperativeFetch(),
+    "rewrite_unbound_block": lambda ms: ms.postproc.RewriteUnboundBlock(),
+    "verify_gpu_code": lambda ms: ms.postproc.VerifyGPUCode(),
+}
+
+
+def create_cost_model(kind="xgb", num_tuning_cores=None):
+    """
+    Create a MetaSchedule cost model.
+
+    Args:
+        kind: "random" (baseline), "xgb" or "mlp"
+        num_tuning_cores: Threads for model training
+
+    Returns:
+        ms.CostModel: Cost model
+    """
+    import tvm.meta_schedule as ms
+
+    if kind == "random":
+        return ms.cost_model.RandomModel()
+    if kind == "xgb":
+        return ms.cost_model.XGBModel(
+            extractor=ms.feature_extractor.PerStoreFeature(),
+            adaptive_training=True,
+            num_tuning_cores=num_tuning_cores,
+        )
+    if kind == "mlp":
+        from tvm.meta_schedule.cost_model.mlp_model import MLPModel
+        return MLPModel()
+    raise ValueError(f"Unknown cost model: {kind}")
+
+
+def create_search_strategy(kind="evolutionary", evolutionary=None):
+    """
+    Create a MetaSchedule search strategy.
+
+    Args:
+        kind: "evolutionary", "replay-trace" or "replay-func"
+        evolutionary: dict of EvolutionarySearch parameters
+
+    Returns:
+        ms.SearchStrategy: Search strategy
+    """
+    import tvm.meta_schedule as ms
+
+    if kind == "evolutionary":
+        return ms.search_strategy.EvolutionarySearch(**(evolutionary or {}))
+    if kind == "replay-trace":
+        return ms.search_strategy.ReplayTrace()
+    if kind == "replay-func":
+        return ms.search_strategy.ReplayFunc()
+    raise ValueError(f"Unknown search strategy: {kind}")
+
+
+def create_space_generator(kind="post-order-apply", mutator_probs=None, postprocs=None):
+    """
+    Create a MetaSchedule space generator.
+
+    Args:
+        kind: "post-order-apply"
+        mutator_probs: dict mutator name -> probability (empty: target defaults)
+        postprocs: list of postprocessor names (empty: target defaults)
+
+    Returns:
+        ms.SpaceGenerator: Space generator
+    """
+    import tvm.meta_schedule as ms
+
+    if kind != "post-order-apply":
+        raise ValueError(f"Unknown space generator: {kind}")
+
+    mutators = None
+    if mutator_probs:
+        unknown = set(mutator_probs) - set(_MUTATORS)
+        if unknown:
+            raise ValueError(f"Unknown mutators: {sorted(unknown)}")
+        mutators = {_MUTATORS[name](ms): float(prob) for name, prob in mutator_probs.items()}
+
+    processors = None
+    if postprocs:
+        unknown = set(postprocs) - set(_POSTPROCS)
+        if unknown:
+            raise ValueError(f"Unknown postprocessors: {sorted(unknown)}")
+        processors = [_POSTPROCS[name](ms) for name in postprocs]
+
+    return ms.space_generator.PostOrderApply(
+        sch_rules="from-target",
+        postprocs=processors if processors is not None else "from-target",
+        mutator_probs=mutators if mutators is not None else "from-target",
+    )
+
+
+def create_early_stopping(patience=0, min_improvement=0.01):
+    """
+    Create a measure callback that stops a task once it stops improving.
+
+    A task is terminated after `patience` consecutive measured candidates
+    without improving its best latency by more than `min_improvement`
+    (relative).
+
+    Args:
+        patience: Candidates without improvement before stopping (0 disables)
+        min_improvement: Relative improvement that resets the patience counter
+
+    Returns:
+        ms.MeasureCallback or None
+    """
+    import tvm.meta_schedule as ms
+
+    if patience <= 0:
+        return None
+
+    @ms.derived_object
+    class EarlyStopping(ms.measure_callback.PyMeasureCallback):
+        def __init__(self):
+            self.best = {}
+            self.stale = {}
+            self.stopped = set()
+
+        def apply(self, task_scheduler, task_id, measure_candidates, builder_results, runner_results):
+            for result in runner_results:
+                if result.error_msg is not None or not result.run_secs:
+                    latency = None
+                else:
+                    latency = sum(float(s) for s in result.run_secs) / len(result.run_secs)
+
+                best = self.best.get(task_id)
+                if latency is not None and (best is None or latency < best * (1.0 - min_improvement)):
+                    self.best[task_id] = latency
+                    self.stale[task_id] = 0
+                else:
+                    if latency is not None and latency < best:
+                        self.best[task_id] = latency
+                    self.stale[task_id] = self.stale.get(task_id, 0) + 1
+
+            if self.stale.get(task_id, 0) >= patience and task_id not in self.stopped:
+                self.stopped.add(task_id)
+                task_scheduler.terminate_task(task_id)
+
+    return EarlyStopping()
+
+
+def tune_with_config(
+    relax_mod_ir,
+    target_name="llvm",
+    config=None,
+    work_dir="tuning_database"
+):
+    """
+    Tune a Relax module with an explicit MetaSchedule configuration.
+
+    Args:
+        relax_mod_ir: Relax module IR string
+        target_name: Target name (e.g., "llvm", "cuda")
+        config: dict with keys num_trials, max_trials_per_task,
+            num_trials_per_iter, max_workers, cost_model, search_strategy,
+            evolutionary, space_generator, mutator_probs, postprocs,
+            early_stopping_patience, early_stopping_min_improvement, seed,
+            post_optimization, measurement (dict with "mode" "fixed" or
+            "adaptive" and the adaptive_runner options), pipeline (Relax
+            pipeline preset or pass list, default "zero"; must match the
+            one used to compile)
+        work_dir: Directory to store tuning database
+
+    Returns:
+        dict: Tuning results with status and the effective configuration;
+            with adaptive measurement also measurement_* repeat statistics
+    """
+    import tvm.meta_schedule as ms
+    from tvm.meta_schedule.builder import LocalBuilder
+    from .adaptive_runner import create_runner
+
+    try:
+        config = dict(config or {})
+
+        # Parse IR string to module
+        relax_mod = tvm.ir.load_json(relax_mod_ir)
+
+        # Setup target
+        target = create_target(target_name)
+
+        # Apply Relax pipeline
+        relax_mod, _ = run_relax_pipeline(relax_mod, target, config.get("pipeline", "zero"), report=False)
+
+        os.makedirs(work_dir, exist_ok=True)
+
+        num_trials = config.get("num_trials", 64)
+        max_workers = config.get("max_workers") or multiprocessing.cpu_count()
+        seed = config.get("seed", -1)
+
+        space = create_space_generator(
+            config.get("space_generator", "post-order-apply"),
+            config.get("mutator_probs"),
+            config.get("postprocs"),
+        )
+        strategy = create_search_strategy(
+            config.get("search_strategy", "evolutionary"),
+            config.get("evolutionary"),
+        )
+        cost_model = create_cost_model(config.get("cost_model", "xgb"), max_workers)
+
+        measure_callbacks = ms.measure_callback.MeasureCallback.create("default")
+        early_stopping = create_early_stopping(
+            config.get("early_stopping_patience", 0),
+            config.get("early_stopping_min_improvement", 0.01),
+        )
+        if early_stopping is not None:
+            measure_callbacks.append(early_stopping)
+
+        extracted_tasks = ms.relax_integration.extract_tasks(relax_mod, target)
+        tasks, task_weights = ms.relax_integration.extracted_tasks_to_tune_contexts(
+            extracted_tasks=extracted_tasks,
+            work_dir=work_dir,
+            space=space,
+            strategy=strategy,
+            num_tuning_cores=max_workers,
+            seed=seed if seed >= 0 else None,
+        )
+
+        measurement = config.get("measurement") or {}
+        runner = create_runner(measurement)
+        if runner != "local":
+            measure_callbacks.append(runner.measure_callback())
+
+        try:
+            with target:
+                ms.tune_tasks(
+                    tasks=tasks,
+                    task_weights=task_weights,
+                    work_dir=work_dir,
+                    max_trials_global=num_trials,
+                    max_trials_per_task=config.get("max_trials_per_task") or num_trials,
+                    num_trials_per_iter=config.get("num_trials_per_iter", 64),
+                    builder=LocalBuilder(max_workers=max_workers),
+                    runner=runner,
+                    database=ms.database.JSONDatabase(work_dir=work_dir),
+                    cost_model=cost_model,
+                    measure_callbacks=measure_callbacks,
+                    post_optimization=config.get("post_optimization", False),
+                )
+        finally:
+            if runner != "local":
+                runner.close()
+
+        result = {
+            "status": "success",
+            "work_dir": work_dir,
+            "target": str(target),
+            "num_tasks": len(extracted_tasks),
+            "num_trials": num_trials,
+            "max_workers": max_workers,
+            "cost_model": config.get("cost_model", "xgb"),
+            "search_strategy": config.get("search_strategy", "evolutionary"),
+            "early_stopped_tasks": len(early_stopping.stopped) if early_stopping is not None else 0,
+            "measurement": measurement.get("mode", "fixed"),
+        }
+        if runner != "local":
+            result.update({f"measurement_{key}": value for key, value in runner.summary().items()})
+        return result
+
+    except Exception as e:
+        return {
+            "status": "error",
+            "error": str(e)
+        }
@@ -0,0 +1,454 @@
+"""
+Warm-Start Tuning Transfer Across Shapes and Targets
+
+Seeds MetaSchedule from existing tuning databases instead of starting from
+scratch. For every task of a new module the nearest source records are
+found: the same workload tuned for another (related) target, otherwise the
+same operator (same TIR block structure) at the closest shape. Their traces
+are replayed on the new workload, where tile decisions that no longer
+divide the loop extents are re-fitted, measured on the new target and
+committed to the new database. Evolutionary search draws the measured part
+of its initial population from that database, and the cost model is
+pre-trained on the seeds and the matched source records before the first
+search round. An optional cold run on the same budget reports how much
+faster the warm run converges.
+"""
+
+import os
+import math
+import shutil
+import time
+import multiprocessing
+import tvm
+from .database import normalize_shash, read_json_database, record_latency_secs
+from .relax_pipeline import run_relax_pipeline
+from .target import create_target
+
+# Records per source workload used to pre-train the cost model
+_PRETRAIN_RECORDS_PER_WORKLOAD = 64
+
+
+def block_signature(workload_mod):
+    """
+    Names of the TIR blocks of a workload in order; independent of shapes.
+    """
+    names = []
+
+    def visit(node):
+        if isinstance(node, tvm.tir.Block):
+            names.append(node.name_hint)
+
+    tvm.tir.stmt_functor.post_order_visit(workload_mod["main"].body, visit)
+    return tuple(names)
+
+
+def _buffer_shapes(workload_mod):
+    shapes = []
+    for buffer in workload_mod["main"].buffer_map.values():
+        if not all(isinstance(dim, tvm.tir.IntImm) for dim in buffer.shape):
+            return None
+        shapes.append([int(dim) for dim in buffer.shape])
+    return shapes
+
+
+def shape_distance(a, b):
+    """
+    Sum of |log2| ratios between the buffer dimensions of two workloads (None if incomparable).
+    """
+    shapes_a, shapes_b = _buffer_shapes(a), _buffer_shapes(b)
+    if shapes_a is None or shapes_b is None or len(shapes_a) != len(shapes_b):
+        return None
+    distance = 0.0
+    for shape_a, shape_b in zip(shapes_a, shapes_b):
+        if len(shape_a) != len(shape_b):
+            return None
+        distance += sum(abs(math.log2(max(x, 1) / max(y, 1))) for x, y in zip(shape_a, shape_b))
+    return distance
+
+
+def load_source_records(source_work_dirs):
+    """
+    Valid tuning records of existing databases, grouped by workload.
+
+    Returns:
+        list: One dict per source workload: shash, mod, signature, and
+            records as (trace, run_secs, latency_secs, target string)
+            sorted by latency
+    """
+    import tvm.meta_schedule as ms
+
+    groups = {}
+    for work_dir in source_work_dirs:
+        database = ms.database.JSONDatabase(work_dir=work_dir, allow_missing=False)
+        for record in database.get_all_tuning_records():
+            run_secs = [float(s) for s in record.run_secs] if record.run_secs else []
+            latency = record_latency_secs([None, run_secs])
+            if latency is None:
+                continue
+            mod = record.workload.mod
+            shash = normalize_shash(tvm.ir.structural_hash(mod))
+            group = groups.setdefault(shash, {
+                "shash": shash,
+                "mod": mod,
+                "signature": block_signature(mod),
+                "records": [],
+            })
+            group["records"].append((record.trace, run_secs, latency, str(record.target)))
+
+    for group in groups.values():
+        group["records"].sort(key=lambda record: record[2])
+    return list(groups.values())
+
+
+def find_seed_records(task_mod, source_groups, seeds_per_task=4):
+    """
+    Nearest source records for one task.
+
+    The same workload (tuned for any target) is preferred; otherwise the
+    source workload with the same block signature and the smallest shape
+    distance is used.
+
+    Returns:
+        tuple: (match kind "same_workload", "same_op" or "none", shape
+            distance, matched source group or None, list of seed records)
+    """
+    shash = normalize_shash(tvm.ir.structural_hash(task_mod))
+    for group in source_groups:
+        if group["shash"] == shash:
+            return "same_workload", 0.0, group, group["records"][:seeds_per_task]
+
+    signature = block_signature(task_mod)
+    best = None
+    for group in source_groups:
+        if group["signature"] != signature:
+            continue
+        distance = shape_distance(task_mod, group["mod"])
+        if distance is not None and (best is None or distance < best[0]):
+            best = (distance, group)
+    if best is None:
+        return "none", -1.0, None, []
+    return "same_op", best[0], best[1], best[1]["records"][:seeds_per_task]
+
+
+def replay_trace(trace, workload_mod):
+    """
+    Apply a tuned trace to another workload of the same operator.
+
+    Tile sizes that no longer divide the new loop extents are re-fitted by
+    SamplePerfectTile. Postprocessing is replayed as recorded and dropped
+    if it does not apply to the new shape.
+
+    Returns:
+        tir.Schedule or None if the trace does not apply
+    """
+    for remove_postproc in (False, True):
+        try:
+            sch = tvm.tir.Schedule(workload_mod)
+            trace.apply_to_schedule(sch, remove_postproc=remove_postproc)
+            return sch
+        except Exception:
+            continue
+    return None
+
+
+def _measure(schedules, target, builder, runner):
+    """
+    Build and run schedules of one workload; returns run_secs per schedule (None if failed).
+    """
+    from tvm.meta_schedule.arg_info import ArgInfo
+    from tvm.meta_schedule.builder import BuilderInput
+    from tvm.meta_schedule.runner import RunnerInput
+
+    builder_results = builder.build([BuilderInput(sch.mod, target) for sch in schedules])
+    run_secs = [None] * len(schedules)
+    runner_inputs = []
+    indices = []
+    for index, (sch, built) in enumerate(zip(schedules, builder_results)):
+        if built.error_msg is None:
+            runner_inputs.append(RunnerInput(
+                built.artifact_path,
+                device_type=target.kind.name if target.kind.name != "llvm" else "cpu",
+                args_info=ArgInfo.from_prim_func(sch.mod["main"]),
+            ))
+            indices.append(index)
+    futures = runner.run(runner_inputs) if runner_inputs else []
+    for index, future in zip(indices, futures):
+        result = future.result()
+        if result.error_msg is None and result.run_secs:
+            run_secs[index] = [float(s) for s in result.run_secs]
+    for built in builder_results:
+        if built.artifact_path and os.path.exists(built.artifact_path):
+            os.remove(built.artifact_path)
+    return run_secs
+
+
+def _pretrain(cost_model, samples, target, max_workers):
+    """
+    Update a cost model with (workload mod, schedule, run_secs) samples, one update per workload.
+    """
+    import tvm.meta_schedule as ms
+    from tvm.meta_schedule.arg_info import ArgInfo
+    from tvm.meta_schedule.runner import RunnerResult
+
+    by_workload = {}
+    for mod, sch, run_secs in samples:
+        by_workload.setdefault(normalize_shash(tvm.ir.structural_hash(mod)), (mod, []))[1].append((sch, run_secs))
+
+    num_samples = 0
+    for mod, items in by_workload.values():
+        context = ms.TuneContext(mod=mod, target=target, num_threads=max_workers)
+        candidates = [ms.MeasureCandidate(sch, ArgInfo.from_prim_func(sch.mod["main"])) for sch, _ in items]
+        results = [RunnerResult(run_secs=run_secs, error_msg=None) for _, run_secs in items]
+        cost_model.update(context, candidates, results)
+        num_samples += len(items)
+    return num_samples
+
+
+def convergence_curve(work_dir, task_weights, first_record=0):
+    """
+    Weighted model latency over the records a run appended to a database.
+
+    Args:
+        work_dir: JSON database directory
+        task_weights: {normalize_shash(workload shash): weight (calls per inference)}
+        first_record: Index of the first record of the run
+
+    Returns:
+        list: [trials, total_ms] after each record once every task has a
+            valid record; total_ms = sum of weight * best latency
+    """
+    workloads, records = read_json_database(work_dir)
+    shashes = [normalize_shash(workload[0]) for workload in workloads]
+    best = {}
+    curve = []
+    for trials, (workload_index, record_json) in enumerate(records[first_record:], start=1):
+        shash = shashes[workload_index] if workload_index < len(shashes) else None
+        latency = record_latency_secs(record_json)
+        if shash in task_weights and latency is not None and latency < best.get(shash, float("inf")):
+            best[shash] = latency
+        if len(best) == len(task_weights):
+            curve.append([trials, sum(task_weights[s] * best[s] for s in best) * 1000.0])
+    return curve
+
+
+def trials_to_reach(curve, target_ms):
+    """
+    First trial count at which a convergence curve is at or below target_ms (-1 if never).
+    """
+    for trials, total_ms in curve:
+        if total_ms <= target_ms:
+            return trials
+    return -1
+
+
+def _num_records(work_dir):
+    return len(read_json_database(work_dir)[1]) if os.path.isdir(work_dir) else 0
+
+
+def _fresh_work_dir(work_dir):
+    # Curves and record counts are only comparable when a run starts from an empty database
+    if os.path.isdir(work_dir) and os.listdir(work_dir):
+        raise ValueError(f"{work_dir} is not empty; warm-start runs need a fresh tuning database")
+    os.makedirs(work_dir, exist_ok=True)
+
+
+def _tune(extracted_tasks, target, work_dir, num_trials, max_workers, cost_model):
+    import tvm.meta_schedule as ms
+    from tvm.meta_schedule.builder import LocalBuilder
+
+    if num_trials <= 0:
+        return
+    tasks, task_weights = ms.relax_integration.extracted_tasks_to_tune_contexts(
+        extracted_tasks=extracted_tasks,
+        work_dir=work_dir,
+        num_tuning_cores=max_workers,
+    )
+    with target:
+        ms.tune_tasks(
+            tasks=tasks,
+            task_weights=task_weights,
+            work_dir=work_dir,
+            max_trials_global=num_trials,
+            builder=LocalBuilder(max_workers=max_workers),
+            database=ms.database.JSONDatabase(work_dir=work_dir),
+            cost_model=cost_model,
+        )
+
+
+def tune_with_warm_start(
+    relax_mod_ir,
+    target_name="llvm",
+    source_work_dirs=None,
+    num_trials=64,
+    max_workers=None,
+    work_dir="tuning_database_warm",
+    pipeline="zero",
+    seeds_per_task=4,
+    pretrain_cost_model=True,
+    compare=False,
+    tolerance=0.05
+):
+    """
+    Tune a module seeded from the nearest records of existing databases.
+
+    num_trials is the total measurement budget of the run, seeds included,
+    so a cold run with the same num_trials measures as many candidates.
+    work_dir must be empty or missing; the cold run's <work_dir>_cold is
+    removed and recreated. Wall time is reported per phase: seed_secs
+    (replaying, measuring seeds and pre-training) and tune_secs (search).
+
+    Args:
+        relax_mod_ir: Relax module IR JSON
+        target_name: Target name (e.g., "llvm")
+        source_work_dirs: Databases to transfer from (other shapes and/or targets)
+        num_trials: Total trials including seed measurements
+        max_workers: Number of parallel workers (None = CPU count)
+        work_dir: Database of the new run (empty or missing)
+        pipeline: Relax pipeline preset or pass list (see relax_pipeline)
+        seeds_per_task: Source records replayed and measured per task
+        pretrain_cost_model: Pre-train the XGBoost cost model on the seeds and
+            matched source records
+        compare: Also tune from scratch in a fresh <work_dir>_cold with the same budget
+        tolerance: Relative distance to the cold run's final latency at
+            which a run counts as converged
+
+    Returns:
+        dict: status, target, work_dir, num_tasks, num_source_records,
+            num_seed_trials, num_valid_seeds, pretrain_samples, "tasks" (task
+            name, weight, match, shape_distance, source_target, num_seeds,
+            num_valid_seeds, best_seed_us), "warm" and with compare "cold"
+            (work_dir, num_records, seed_secs, tune_secs, final_ms, trials_to_target,
+            curve) plus trials_saved
+    """
+    import tvm.meta_schedule as ms
+    from tvm.meta_schedule.builder import LocalBuilder
+    from tvm.meta_schedule.runner import LocalRunner
+    from .tuning_config import create_cost_model
+
+    try:
+        if not source_work_dirs:
+            raise ValueError("At least one source tuning database is required")
+
+        relax_mod = tvm.ir.load_json(relax_mod_ir)
+        target = create_target(target_name)
+        if not max_workers:
+            max_workers = multiprocessing.cpu_count()
+        relax_mod, _ = run_relax_pipeline(relax_mod, target, pipeline, report=False)
+
+        source_groups = load_source_records(source_work_dirs)
+        extracted_tasks = ms.relax_integration.extract_tasks(relax_mod, target)
+        task_weights = {}
+        for task in extracted_tasks:
+            shash = normalize_shash(tvm.ir.structural_hash(task.dispatched[0]))
+            task_weights[shash] = task_weights.get(shash, 0) + int(task.weight)
+
+        # Replay and measure the nearest source records on the new target
+        _fresh_work_dir(work_dir)
+        database = ms.database.JSONDatabase(work_dir=work_dir)
+        builder = LocalBuilder(max_workers=max_workers)
+        runner = LocalRunner()
+        task_reports = []
+        samples = []
+        num_seed_trials = 0
+        start = time.perf_counter()
+        for task in extracted_tasks:
+            task_mod = task.dispatched[0]
+            match, distance, group, seeds = find_seed_records(task_mod, source_groups, seeds_per_task)
+            schedules = [sch for sch in (replay_trace(seed[0], task_mod) for seed in seeds) if sch is not None]
+            run_secs = _measure(schedules, target, builder, runner) if schedules else []
+            num_seed_trials += len(schedules)
+
+            workload = database.commit_workload(task_mod)
+            valid = []
+            for sch, secs in zip(schedules, run_secs):
+                if secs is None:
+                    continue
+                database.commit_tuning_record(ms.database.TuningRecord(
+                    sch.trace, workload, secs, target, ms.arg_info.ArgInfo.from_prim_func(sch.mod["main"])
+                ))
+                valid.append(sum(secs) / len(secs))
+                samples.append((task_mod, sch, secs))
+
+            if pretrain_cost_model and group is not None:
+                for trace, secs, _, _ in group["records"][:_PRETRAIN_RECORDS_PER_WORKLOAD]:
+                    sch = replay_trace(trace, group["mod"])
+                    if sch is not None:
+                        samples.append((group["mod"], sch, secs))
+
+            task_reports.append({
+                "task_name": task.task_name,
+                "weight": int(task.weight),
+                "match": match,
+                "shape_distance": distance,
+                "source_target": seeds[0][3] if seeds else "",
+                "num_seeds": len(schedules),
+                "num_valid_seeds": len(valid),
+                "best_seed_us": min(valid) * 1e6 if valid else -1.0,
+            })
+
+        cost_model = create_cost_model("xgb", max_workers)
+        pretrain_samples = _pretrain(cost_model, samples, target, max_workers) if pretrain_cost_model else 0
+        seed_secs = time.perf_counter() - start
+
+        start = time.perf_counter()
+        _tune(extracted_tasks, target, work_dir, num_trials - num_seed_trials, max_workers, cost_model)
+        warm_secs = time.perf_counter() - start
+        warm_curve = convergence_curve(work_dir, task_weights)
+
+        result = {
+            "status": "success",
+            "target": str(target),
+            "work_dir": work_dir,
+            "num_tasks": len(extracted_tasks),
+            "num_source_records": sum(len(group["records"]) for group in source_groups),
+            "num_seed_trials": num_seed_trials,
+            "num_valid_seeds": sum(task["num_valid_seeds"] for task in task_reports),
+            "pretrain_samples": pretrain_samples,
+            "tasks": task_reports,
+        }
+
+        warm = {
+            "work_dir": work_dir,
+            "num_records": _num_records(work_dir),
+            "seed_secs": seed_secs,
+            "tune_secs": warm_secs,
+            "final_ms": warm_curve[-1][1] if warm_curve else -1.0,
+            "trials_to_target": -1,     # set with compare
+            "curve": warm_curve,
+        }
+        result["warm"] = warm
+
+        if compare:
+            cold_dir = work_dir.rstrip("/") + "_cold"
+            shutil.rmtree(cold_dir, ignore_errors=True)
+            _fresh_work_dir(cold_dir)
+            start = time.perf_counter()
+            _tune(extracted_tasks, target, cold_dir, num_trials, max_workers, create_cost_model("xgb", max_workers))
+            cold_curve = convergence_curve(cold_dir, task_weights)
+            cold = {
+                "work_dir": cold_dir,
+                "num_records": _num_records(cold_dir),
+                "seed_secs": 0.0,
+                "tune_secs": time.perf_counter() - start,
+                "final_ms": cold_curve[-1][1] if cold_curve else -1.0,
+                "trials_to_target": -1,
+                "curve": cold_curve,
+            }
+            # Both runs are measured against the quality the cold run reaches
+            if cold_curve:
+                target_ms = cold["final_ms"] * (1.0 + tolerance)
+                cold["trials_to_target"] = trials_to_reach(cold_curve, target_ms)
+                warm["trials_to_target"] = trials_to_reach(warm_curve, target_ms)
+            result["cold"] = cold
+            result["trials_saved"] = (
+                cold["trials_to_target"] - warm["trials_to_target"]
+                if cold["trials_to_target"] > 0 and warm["trials_to_target"] > 0 else 0
+            )
+
+        return result
+
+    except Exception as e:
+        return {
+            "status": "error",
+            "error": str(e)
+        }
@@ -0,0 +1,15 @@
+#include "ffi/backend.h"
+
+namespace tvm_sdk {
+namespace ffi {
+
+const char* to_string(Backend backend) {
+    switch (backend) {
+        case Backend::TVM: return "tvm";
+        case Backend::DNNL: return "dnnl";
+    }
+    return "tvm";
+}
+
+} // namespace ffi
+} // namespace tvm_sdk
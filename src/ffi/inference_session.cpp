@@ -0,0 +1,213 @@
+#include "ffi/inference_session.h"
+#include "python_hook.h"
+#include "trace.h"
+#include <pybind11/numpy.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace tvm_sdk {
+namespace ffi {
+
+namespace {
+
+constexpr const char* MODULE_PATH = "tvm_ext.inference";
+constexpr const char* POOL_MODULE_PATH = "tvm_ext.executor_pool";
+
+size_t dtype_bytes(const std::string& dtype) {
+    if (dtype == "bool") {
+        return 1;
+    }
+    size_t pos = dtype.size();
+    while (pos > 0 && std::isdigit(static_cast<unsigned char>(dtype[pos - 1]))) {
+        pos--;
+    }
+    if (pos == dtype.size() || pos == 0) {
+        throw std::invalid_argument("Unsupported dtype: " + dtype);
+    }
+    int bits = std::stoi(dtype.substr(pos));
+    if (bits % 8 != 0) {
+        throw std::invalid_argument("Unsupported dtype: " + dtype);
+    }
+    return static_cast<size_t>(bits / 8);
+}
+
+py::array as_numpy(TensorBuffer* buffer) {
+    // Non-owning view: the capsule keeps no reference, the caller owns the memory
+    py::capsule base(buffer->data(), [](void*) {});
+    return py::array(py::dtype(buffer->dtype()), buffer->shape(), buffer->data(), base);
+}
+
+py::list as_numpy_list(const std::vector<TensorBuffer*>& buffers) {
+    py::list arrays;
+    for (TensorBuffer* buffer : buffers) {
+        arrays.append(as_numpy(buffer));
+    }
+    return arrays;
+}
+
+} // namespace
+
+TensorBuffer::TensorBuffer(std::vector<int64_t> shape, std::string dtype)
+    : shape_(std::move(shape)), dtype_(std::move(dtype)) {
+    for (int64_t dim : shape_) {
+        if (dim < 0) {
+            throw std::invalid_argument("TensorBuffer shape must be non-negative");
+        }
+        num_elements_ *= dim;
+    }
+    nbytes_ = static_cast<size_t>(num_elements_) * dtype_bytes(dtype_);
+
+    // aligned_alloc requires a size that is a multiple of the alignment
+    size_t alloc_bytes = std::max<size_t>(kAlignment, (nbytes_ + kAlignment - 1) / kAlignment * kAlignment);
+    data_ = std::aligned_alloc(kAlignment, alloc_bytes);
+    if (data_ == nullptr) {
+        throw std::bad_alloc();
+    }
+    std::memset(data_, 0, alloc_bytes);
+}
+
+TensorBuffer::~TensorBuffer() {
+    std::free(data_);
+}
+
+std::shared_ptr<TensorBuffer> TensorBufferPool::acquire(const std::vector<int64_t>& shape, const std::string& dtype) {
+    auto it = std::find_if(free_.begin(), free_.end(), [&](const std::shared_ptr<TensorBuffer>& buffer) {
+        return buffer->shape() == shape && buffer->dtype() == dtype;
+    });
+    if (it != free_.end()) {
+        std::shared_ptr<TensorBuffer> buffer = std::move(*it);
+        free_.erase(it);
+        return buffer;
+    }
+    num_allocated_++;
+    return std::make_shared<TensorBuffer>(shape, dtype);
+}
+
+void TensorBufferPool::release(std::shared_ptr<TensorBuffer> buffer) {
+    if (buffer) {
+        free_.push_back(std::move(buffer));
+    }
+}
+
+// Hidden like the pybind11 types it holds
+struct __attribute__((visibility("hidden"))) InferenceSession::Impl {
+    py::object session;
+    py::object run;
+};
+
+InferenceSession::InferenceSession(
+    const std::string& lib_path,
+    const std::string& func_name,
+    const std::string& device
+) : impl_(new Impl()), func_name_(func_name) {
+    py::object session = PythonHook::call_function(
+        MODULE_PATH,
+        "create_inference_session",
+        lib_path,
+        func_name,
+        device
+    );
+
+    py::gil_scoped_acquire gil;
+    impl_->session = session;
+    impl_->run = session.attr("run");
+}
+
+InferenceSession::~InferenceSession() {
+    if (impl_ && PythonHook::is_initialized()) {
+        py::gil_scoped_acquire gil;
+        impl_->run = py::object();
+        impl_->session = py::object();
+    }
+}
+
+void InferenceSession::bind(const std::vector<TensorBuffer*>& inputs, const std::vector<TensorBuffer*>& outputs) {
+    py::gil_scoped_acquire gil;
+
+    try {
+        impl_->session.attr("bind")(as_numpy_list(inputs), as_numpy_list(outputs));
+    } catch (const py::error_already_set& e) {
+        throw std::runtime_error(std::string("Failed to bind inference buffers: ") + e.what());
+    }
+}
+
+void InferenceSession::run() {
+    TVM_SDK_TRACE_SCOPE("InferenceSession::run");
+    py::gil_scoped_acquire gil;
+
+    try {
+        impl_->run();
+    } catch (const py::error_already_set& e) {
+        throw std::runtime_error(std::string("Inference failed: ") + e.what());
+    }
+}
+
+void InferenceSession::warmup(int num_runs) {
+    for (int i = 0; i < num_runs; i++) {
+        run();
+    }
+}
+
+// Hidden like the pybind11 types it holds
+struct __attribute__((visibility("hidden"))) ExecutorPool::Impl {
+    py::object pool;
+};
+
+ExecutorPool::ExecutorPool(
+    const std::string& work_dir,
+    int num_instances,
+    int cores_per_instance,
+    const std::string& device,
+    bool numa_local
+) : impl_(new Impl()) {
+    py::object pool = PythonHook::call_function(
+        POOL_MODULE_PATH,
+        "create_executor_pool",
+        work_dir,
+        num_instances,
+        cores_per_instance,
+        device,
+        numa_local
+    );
+
+    py::gil_scoped_acquire gil;
+    impl_->pool = pool;
+}
+
+ExecutorPool::~ExecutorPool() {
+    if (impl_ && PythonHook::is_initialized()) {
+        py::gil_scoped_acquire gil;
+        try {
+            impl_->pool.attr("shutdown")();
+        } catch (const py::error_already_set&) {
+        }
+        impl_->pool = py::object();
+    }
+}
+
+void ExecutorPool::run(const std::vector<TensorBuffer*>& inputs, const std::vector<TensorBuffer*>& outputs) {
+    TVM_SDK_TRACE_SCOPE("ExecutorPool::run");
+    py::gil_scoped_acquire gil;
+
+    try {
+        impl_->pool.attr("run")(as_numpy_list(inputs), as_numpy_list(outputs));
+    } catch (const py::error_already_set& e) {
+        throw std::runtime_error(std::string("Inference failed: ") + e.what());
+    }
+}
+
+std::map<std::string, std::string> ExecutorPool::stats() {
+    py::gil_scoped_acquire gil;
+
+    std::map<std::string, std::string> info;
+    for (auto item : py::cast<py::dict>(impl_->pool.attr("stats")())) {
+        info[py::cast<std::string>(item.first)] = py::cast<std::string>(py::str(item.second));
+    }
+    return info;
+}
+
+} // namespace ffi
+} // namespace tvm_sdk
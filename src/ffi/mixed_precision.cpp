@@ -0,0 +1,16 @@
+#include "ffi/mixed_precision.h"
+
+namespace tvm_sdk {
+namespace ffi {
+
+const char* to_string(Precision precision) {
+    switch (precision) {
+        case Precision::Float32: return "float32";
+        case Precision::BFloat16: return "bfloat16";
+        case Precision::Float16: return "float16";
+    }
+    return "float32";
+}
+
+} // namespace ffi
+} // namespace tvm_sdk
@@ -0,0 +1,305 @@
+#include "ffi/param_file.h"
+#include "ffi/inference_session.h"
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace tvm_sdk {
+namespace ffi {
+
+namespace {
+
+constexpr char MAGIC[8] = {'T', 'S', 'D', 'K', 'P', 'R', 'M', '\0'};
+constexpr uint32_t FLAG_CHECKSUMS = 1;
+constexpr size_t HEADER_SIZE = 64;
+// Smallest index entry: empty name and dtype, no dims, offset, nbytes, crc32
+constexpr uint64_t MIN_INDEX_ENTRY_SIZE = 4 + 4 + 4 + 8 + 8 + 4;
+
+// Mirrors HEADER_FORMAT in tvm_ext/param_file.py
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t num_tensors;
+    uint64_t index_offset;
+    uint64_t index_size;
+    uint64_t data_offset;
+    uint64_t file_size;
+    uint64_t reserved;
+};
+static_assert(sizeof(Header) == HEADER_SIZE, "Parameter file header must be 64 bytes");
+
+uint64_t align_up(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+const std::array<uint32_t, 256>& crc32_table() {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+    return table;
+}
+
+/**
+ * @brief Bounds-checked little-endian reader over the index section
+ */
+class IndexReader {
+public:
+    IndexReader(const uint8_t* data, size_t size, const std::string& path)
+        : data_(data), size_(size), path_(path) {}
+
+    template<typename T>
+    T read() {
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    std::string read_string() {
+        uint32_t length = read<uint32_t>();
+        const uint8_t* bytes = take(length);
+        return std::string(reinterpret_cast<const char*>(bytes), length);
+    }
+
+private:
+    const uint8_t* take(size_t n) {
+        if (n > size_ - pos_) {
+            throw std::runtime_error("Truncated parameter index: " + path_);
+        }
+        const uint8_t* p = data_ + pos_;
+        pos_ += n;
+        return p;
+    }
+
+    const uint8_t* data_;
+    size_t size_;
+    size_t pos_ = 0;
+    const std::string& path_;
+};
+
+template<typename T>
+void append(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void append_string(std::string& out, const std::string& value) {
+    append<uint32_t>(out, static_cast<uint32_t>(value.size()));
+    out.append(value);
+}
+
+} // namespace
+
+uint32_t crc32(const void* data, size_t size) {
+    const auto& table = crc32_table();
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint32_t c = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; i++) {
+        c = table[(c ^ bytes[i]) & 0xFF] ^ (c >> 8);
+    }
+    return c ^ 0xFFFFFFFFu;
+}
+
+ParamFile::ParamFile(const std::string& path, bool verify_checksums) : path_(path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open parameter file " + path + ": " + std::strerror(errno));
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < HEADER_SIZE) {
+        ::close(fd);
+        throw std::runtime_error("Truncated parameter file: " + path);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+
+    // Private writable mapping: copy-on-write, pages shared until written
+    mapping_ = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping_ == MAP_FAILED) {
+        mapping_ = nullptr;
+        throw std::runtime_error("Failed to map parameter file " + path + ": " + std::strerror(errno));
+    }
+
+    try {
+        const uint8_t* base = static_cast<const uint8_t*>(mapping_);
+        Header header;
+        std::memcpy(&header, base, sizeof(Header));
+
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+            throw std::runtime_error("Not an SDK parameter file: " + path);
+        }
+        if (header.version != kVersion) {
+            throw std::runtime_error(
+                "Unsupported parameter file version " + std::to_string(header.version) + ": " + path);
+        }
+        // Layout: header, index, then the page-aligned data section
+        if (header.file_size != size_ || header.index_offset < HEADER_SIZE || header.index_offset > size_ ||
+            header.index_size > size_ - header.index_offset ||
+            header.data_offset < header.index_offset + header.index_size || header.data_offset > size_ ||
+            header.data_offset % kDataAlignment != 0 ||
+            header.num_tensors > header.index_size / MIN_INDEX_ENTRY_SIZE) {
+            throw std::runtime_error("Corrupt parameter file header: " + path);
+        }
+        has_checksums_ = (header.flags & FLAG_CHECKSUMS) != 0;
+
+        IndexReader reader(base + header.index_offset, header.index_size, path);
+        entries_.reserve(static_cast<size_t>(header.num_tensors));
+        for (uint64_t i = 0; i < header.num_tensors; i++) {
+            ParamEntry entry;
+            entry.name = reader.read_string();
+            entry.dtype = reader.read_string();
+            uint32_t ndim = reader.read<uint32_t>();
+            for (uint32_t d = 0; d < ndim; d++) {
+                entry.shape.push_back(reader.read<int64_t>());
+            }
+            entry.offset = reader.read<uint64_t>();
+            entry.nbytes = reader.read<uint64_t>();
+            entry.crc32 = reader.read<uint32_t>();
+
+            if (entry.offset < header.data_offset || entry.offset > size_ || entry.nbytes > size_ - entry.offset) {
+                throw std::runtime_error("Tensor '" + entry.name + "' exceeds parameter file: " + path);
+            }
+            if (entry.offset % kTensorAlignment != 0) {
+                throw std::runtime_error("Tensor '" + entry.name + "' is misaligned in parameter file: " + path);
+            }
+            entry.data = base + entry.offset;
+            entries_.push_back(std::move(entry));
+        }
+
+        if (verify_checksums) {
+            std::vector<std::string> mismatched = verify();
+            if (!mismatched.empty()) {
+                throw std::runtime_error(
+                    "Checksum mismatch for tensor '" + mismatched.front() + "' in " + path);
+            }
+        }
+    } catch (...) {
+        ::munmap(mapping_, size_);
+        mapping_ = nullptr;
+        throw;
+    }
+}
+
+ParamFile::~ParamFile() {
+    if (mapping_ != nullptr) {
+        ::munmap(mapping_, size_);
+    }
+}
+
+const ParamEntry* ParamFile::find(const std::string& name) const {
+    for (const ParamEntry& entry : entries_) {
+        if (entry.name == name) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<std::string> ParamFile::verify() const {
+    std::vector<std::string> mismatched;
+    if (!has_checksums_) {
+        return mismatched;
+    }
+    for (const ParamEntry& entry : entries_) {
+        if (crc32(entry.data, entry.nbytes) != entry.crc32) {
+            mismatched.push_back(entry.name);
+        }
+    }
+    return mismatched;
+}
+
+void ParamFile::save(
+    const std::string& path,
+    const std::vector<std::pair<std::string, const TensorBuffer*>>& tensors,
+    bool checksum
+) {
+    // Encode the index with placeholder offsets first to learn its size;
+    // all fields are fixed-width, so the final index has the same length
+    auto encode_index = [&](const std::vector<uint64_t>& offsets, const std::vector<uint32_t>& crcs) {
+        std::string index;
+        for (size_t i = 0; i < tensors.size(); i++) {
+            const TensorBuffer* buffer = tensors[i].second;
+            append_string(index, tensors[i].first);
+            append_string(index, buffer->dtype());
+            append<uint32_t>(index, static_cast<uint32_t>(buffer->shape().size()));
+            for (int64_t dim : buffer->shape()) {
+                append<int64_t>(index, dim);
+            }
+            append<uint64_t>(index, offsets[i]);
+            append<uint64_t>(index, buffer->nbytes());
+            append<uint32_t>(index, crcs[i]);
+        }
+        return index;
+    };
+
+    std::vector<uint64_t> offsets(tensors.size(), 0);
+    std::vector<uint32_t> crcs(tensors.size(), 0);
+    uint64_t index_size = encode_index(offsets, crcs).size();
+    uint64_t data_offset = align_up(HEADER_SIZE + index_size, kDataAlignment);
+
+    uint64_t offset = data_offset;
+    for (size_t i = 0; i < tensors.size(); i++) {
+        const TensorBuffer* buffer = tensors[i].second;
+        offsets[i] = offset;
+        crcs[i] = checksum ? crc32(buffer->data(), buffer->nbytes()) : 0;
+        offset = align_up(offset + buffer->nbytes(), kTensorAlignment);
+    }
+    uint64_t file_size = offset;
+    std::string index = encode_index(offsets, crcs);
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = kVersion;
+    header.flags = checksum ? FLAG_CHECKSUMS : 0;
+    header.num_tensors = tensors.size();
+    header.index_offset = HEADER_SIZE;
+    header.index_size = index_size;
+    header.data_offset = data_offset;
+    header.file_size = file_size;
+
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Failed to create parameter file: " + tmp_path);
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        out.write(index.data(), static_cast<std::streamsize>(index.size()));
+
+        const std::string padding(kDataAlignment, '\0');
+        uint64_t pos = HEADER_SIZE + index_size;
+        for (size_t i = 0; i <= tensors.size(); i++) {
+            uint64_t target = i < tensors.size() ? offsets[i] : file_size;
+            out.write(padding.data(), static_cast<std::streamsize>(target - pos));
+            if (i < tensors.size()) {
+                const TensorBuffer* buffer = tensors[i].second;
+                out.write(static_cast<const char*>(buffer->data()), static_cast<std::streamsize>(buffer->nbytes()));
+                pos = target + buffer->nbytes();
+            }
+        }
+        if (!out) {
+            throw std::runtime_error("Failed to write parameter file: " + tmp_path);
+        }
+    }
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Failed to replace parameter file " + path + ": " + std::strerror(errno));
+    }
+}
+
+} // namespace ffi
+} // namespace tvm_sdk
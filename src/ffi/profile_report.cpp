@@ -0,0 +1,119 @@
+#include "ffi/profile_report.h"
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace tvm_sdk {
+namespace ffi {
+
+namespace {
+
+std::string json_escape(const std::string& value) {
+    std::ostringstream out;
+    for (char c : value) {
+        switch (c) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                        << static_cast<int>(c) << std::dec;
+                } else {
+                    out << c;
+                }
+        }
+    }
+    return out.str();
+}
+
+std::string csv_escape(const std::string& value) {
+    if (value.find_first_of(",\"\n") == std::string::npos) {
+        return value;
+    }
+    std::string quoted = "\"";
+    for (char c : value) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+bool write_file(const std::string& path, const std::string& content) {
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+    file << content;
+    return static_cast<bool>(file);
+}
+
+} // namespace
+
+std::string ProfileReport::to_csv() const {
+    std::ostringstream out;
+    out << std::setprecision(10);
+    out << "name,call_count,total_us,mean_us,share,flops,gflops_per_sec,"
+        << "workload_hash,tuning_records,best_tuned_us\n";
+
+    for (const auto& op : operators) {
+        out << csv_escape(op.name) << ','
+            << op.call_count << ','
+            << op.total_us << ','
+            << op.mean_us << ','
+            << op.share << ','
+            << op.flops << ','
+            << op.gflops_per_sec << ','
+            << op.workload_hash << ','
+            << op.tuning_records << ','
+            << op.best_tuned_us << '\n';
+    }
+
+    return out.str();
+}
+
+std::string ProfileReport::to_json() const {
+    std::ostringstream out;
+    out << std::setprecision(10);
+    out << "{\"status\": \"" << json_escape(status) << "\"";
+    if (!error.empty()) {
+        out << ", \"error\": \"" << json_escape(error) << "\"";
+    }
+    out << ", \"target\": \"" << json_escape(target) << "\""
+        << ", \"work_dir\": \"" << json_escape(work_dir) << "\""
+        << ", \"num_runs\": " << num_runs
+        << ", \"e2e_time_us\": " << e2e_time_us
+        << ", \"operators\": [";
+
+    for (size_t i = 0; i < operators.size(); i++) {
+        const auto& op = operators[i];
+        if (i > 0) out << ", ";
+        out << "{\"name\": \"" << json_escape(op.name) << "\""
+            << ", \"call_count\": " << op.call_count
+            << ", \"total_us\": " << op.total_us
+            << ", \"mean_us\": " << op.mean_us
+            << ", \"share\": " << op.share
+            << ", \"flops\": " << op.flops
+            << ", \"gflops_per_sec\": " << op.gflops_per_sec
+            << ", \"workload_hash\": \"" << json_escape(op.workload_hash) << "\""
+            << ", \"tuning_records\": " << op.tuning_records
+            << ", \"best_tuned_us\": " << op.best_tuned_us
+            << "}";
+    }
+
+    out << "]}";
+    return out.str();
+}
+
+bool ProfileReport::save_csv(const std::string& path) const {
+    return write_file(path, to_csv());
+}
+
+bool ProfileReport::save_json(const std::string& path) const {
+    return write_file(path, to_json());
+}
+
+} // namespace ffi
+} // namespace tvm_sdk
@@ -0,0 +1,25 @@
+#include "ffi/runtime_config.h"
+
+namespace tvm_sdk {
+namespace ffi {
+
+const char* to_string(CoreMode mode) {
+    switch (mode) {
+        case CoreMode::Default: return "default";
+        case CoreMode::Big: return "big";
+        case CoreMode::Little: return "little";
+    }
+    return "default";
+}
+
+const char* to_string(WaitPolicy policy) {
+    switch (policy) {
+        case WaitPolicy::Default: return "default";
+        case WaitPolicy::Spin: return "spin";
+        case WaitPolicy::Sleep: return "sleep";
+    }
+    return "default";
+}
+
+} // namespace ffi
+} // namespace tvm_sdk
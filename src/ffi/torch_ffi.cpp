@@ -79,12 +79,14 @@ std::map<std::string, std::string> TorchFFI::get_traced_model_info(
 }
 
 std::map<std::string, std::string> TorchFFI::save_model_state(
-    const std::string& output_path
+    const std::string& output_path,
+    const std::string& format
 ) {
     py::object result = PythonHook::call_function(
         MODULE_PATH,
         "save_model_state",
-        output_path
+        output_path,
+        format
     );
 
     py::dict dict_result = py::cast<py::dict>(result);
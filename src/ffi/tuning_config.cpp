@@ -0,0 +1,33 @@
+#include "ffi/tuning_config.h"
+
+namespace tvm_sdk {
+namespace ffi {
+
+const char* to_string(CostModelKind kind) {
+    switch (kind) {
+        case CostModelKind::Random: return "random";
+        case CostModelKind::XGBoost: return "xgb";
+        case CostModelKind::MLP: return "mlp";
+    }
+    return "xgb";
+}
+
+const char* to_string(SearchStrategyKind kind) {
+    switch (kind) {
+        case SearchStrategyKind::Evolutionary: return "evolutionary";
+        case SearchStrategyKind::ReplayTrace: return "replay-trace";
+        case SearchStrategyKind::ReplayFunc: return "replay-func";
+    }
+    return "evolutionary";
+}
+
+const char* to_string(MeasurementMode mode) {
+    switch (mode) {
+        case MeasurementMode::Fixed: return "fixed";
+        case MeasurementMode::Adaptive: return "adaptive";
+    }
+    return "fixed";
+}
+
+} // namespace ffi
+} // namespace tvm_sdk
@@ -1,10 +1,141 @@
 #include "ffi/tvm_ffi.h"
 #include "python_hook.h"
+#include <pybind11/stl.h>
+#include <algorithm>
 #include <stdexcept>
 
 namespace tvm_sdk {
 namespace ffi {
 
+namespace {
+
+std::map<std::string, std::string> dict_to_string_map(const py::dict& dict_result) {
+    std::map<std::string, std::string> info;
+    for (auto item : dict_result) {
+        std::string key = py::cast<std::string>(item.first);
+
+        if (py::isinstance<py::str>(item.second)) {
+            info[key] = py::cast<std::string>(item.second);
+        } else if (py::isinstance<py::bool_>(item.second)) {
+            info[key] = py::cast<bool>(item.second) ? "true" : "false";
+        } else if (py::isinstance<py::int_>(item.second)) {
+            info[key] = std::to_string(py::cast<int64_t>(item.second));
+        } else if (py::isinstance<py::list>(item.second)) {
+            py::list list_val = py::cast<py::list>(item.second);
+            std::string list_str = "[";
+            for (size_t i = 0; i < py::len(list_val); i++) {
+                if (i > 0) list_str += ", ";
+                list_str += py::cast<std::string>(py::str(list_val[i]));
+            }
+            list_str += "]";
+            info[key] = list_str;
+        } else {
+            info[key] = py::cast<std::string>(py::str(item.second));
+        }
+    }
+    return info;
+}
+
+// Preset name, or the custom pass list if one is given
+py::object pipeline_arg(const RelaxPipelineConfig& pipeline) {
+    return pipeline.passes.empty() ? py::cast(pipeline.preset) : py::cast(pipeline.passes);
+}
+
+py::dict model_spec_arg(const ModelSpec& model) {
+    py::list input_specs;
+    for (const auto& input : model.inputs) {
+        py::list shape;
+        for (size_t i = 0; i < input.shape.size(); ++i) {
+            if (i < input.dim_names.size() && !input.dim_names[i].empty()) {
+                shape.append(input.dim_names[i]);
+            } else {
+                shape.append(input.shape[i]);
+            }
+        }
+        py::dict spec;
+        spec["shape"] = shape;
+        spec["dtype"] = input.dtype;
+        input_specs.append(spec);
+    }
+    py::dict spec;
+    spec["name"] = model.name;
+    spec["input_specs"] = input_specs;
+    spec["pretrained"] = model.pretrained;
+    return spec;
+}
+
+std::vector<PassReport> to_pass_reports(const py::handle& list) {
+    std::vector<PassReport> reports;
+    for (auto item : py::cast<py::list>(list)) {
+        py::dict entry = py::cast<py::dict>(item);
+        PassReport report;
+        report.name = py::cast<std::string>(entry["name"]);
+        report.wall_ms = py::cast<double>(entry["wall_ms"]);
+        if (entry.contains("bindings_before")) {
+            report.bindings_before = py::cast<int64_t>(entry["bindings_before"]);
+            report.bindings_after = py::cast<int64_t>(entry["bindings_after"]);
+            report.primfuncs_before = py::cast<int64_t>(entry["primfuncs_before"]);
+            report.primfuncs_after = py::cast<int64_t>(entry["primfuncs_after"]);
+            report.tir_nodes_before = py::cast<int64_t>(entry["tir_nodes_before"]);
+            report.tir_nodes_after = py::cast<int64_t>(entry["tir_nodes_after"]);
+        }
+        reports.push_back(report);
+    }
+    return reports;
+}
+
+void fill_pipeline_timings(const py::dict& dict_result, PipelineTimings* timings) {
+    if (timings == nullptr) {
+        return;
+    }
+    *timings = PipelineTimings();
+    if (dict_result.contains("phases")) {
+        for (auto item : py::cast<py::list>(dict_result["phases"])) {
+            py::dict phase = py::cast<py::dict>(item);
+            PhaseTiming timing;
+            timing.name = py::cast<std::string>(phase["name"]);
+            timing.start_ms = py::cast<double>(phase["start_us"]) / 1000.0;
+            timing.wall_ms = py::cast<double>(phase["wall_ms"]);
+            timing.cpu_ms = py::cast<double>(phase["cpu_ms"]);
+            timing.children_cpu_ms = py::cast<double>(phase["children_cpu_ms"]);
+            timing.peak_rss_kb = py::cast<int64_t>(phase["peak_rss_kb"]);
+            timings->total_wall_ms += timing.wall_ms;
+            timings->peak_rss_kb = std::max(timings->peak_rss_kb, timing.peak_rss_kb);
+            timings->phases.push_back(timing);
+        }
+    }
+    if (dict_result.contains("num_tasks")) {
+        timings->num_tasks = py::cast<int64_t>(dict_result["num_tasks"]);
+    }
+    if (dict_result.contains("num_records")) {
+        timings->num_records = py::cast<int64_t>(dict_result["num_records"]);
+    }
+    if (dict_result.contains("trace_path")) {
+        timings->trace_path = py::cast<std::string>(dict_result["trace_path"]);
+    }
+    if (dict_result.contains("passes")) {
+        timings->passes = to_pass_reports(dict_result["passes"]);
+    }
+}
+
+ConvergenceReport to_convergence_report(const py::dict& run) {
+    ConvergenceReport report;
+    report.work_dir = py::cast<std::string>(run["work_dir"]);
+    report.num_records = py::cast<int64_t>(run["num_records"]);
+    report.seed_secs = py::cast<double>(run["seed_secs"]);
+    report.tune_secs = py::cast<double>(run["tune_secs"]);
+    report.final_ms = py::cast<double>(run["final_ms"]);
+    report.trials_to_target = py::cast<int>(run["trials_to_target"]);
+    for (auto item : py::cast<py::list>(run["curve"])) {
+        py::list point = py::cast<py::list>(item);
+        report.trials.push_back(py::cast<int>(point[0]));
+        report.total_ms.push_back(py::cast<double>(point[1]));
+    }
+    return report;
+}
+
+} // namespace
+
 std::string TVMFFI::get_tvm_version() {
     py::object result = PythonHook::call_function(MODULE_PATH, "get_tvm_version");
     return PythonHook::to_cpp<std::string>(result);
@@ -113,6 +244,249 @@ std::map<std::string, std::string> TVMFFI::check_tuning_database(const std::stri
     return info;
 }
 
+std::vector<WorkloadStats> TVMFFI::get_workload_stats(const std::string& work_dir) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::object result = PythonHook::call_function(MODULE_PATH, "workload_stats", work_dir);
+    py::dict dict_result = py::cast<py::dict>(result);
+
+    std::vector<WorkloadStats> stats(py::len(dict_result));
+    for (auto item : dict_result) {
+        py::dict entry = py::cast<py::dict>(item.second);
+        size_t index = py::cast<size_t>(entry["workload_index"]);
+
+        WorkloadStats& workload = stats[index];
+        workload.shash = py::cast<std::string>(item.first);
+        workload.num_records = py::cast<int64_t>(entry["num_records"]);
+        workload.num_valid = py::cast<int64_t>(entry["num_valid"]);
+        workload.best_latency_us = py::cast<double>(entry["best_latency_us"]);
+        workload.best_ci_us = py::cast<double>(entry["best_ci_us"]);
+        workload.converged = py::cast<bool>(entry["converged"]);
+    }
+
+    return stats;
+}
+
+std::map<std::string, std::string> TVMFFI::merge_tuning_databases(
+    const std::vector<std::string>& input_dirs,
+    const std::string& output_dir,
+    int top_k
+) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::object result = PythonHook::call_function(
+        MODULE_PATH,
+        "merge_tuning_databases",
+        input_dirs,
+        output_dir,
+        top_k
+    );
+
+    return dict_to_string_map(py::cast<py::dict>(result));
+}
+
+std::map<std::string, std::string> TVMFFI::compact_tuning_database(
+    const std::string& work_dir,
+    int top_k,
+    const std::string& output_dir
+) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::object result = PythonHook::call_function(
+        MODULE_PATH,
+        "compact_tuning_database",
+        work_dir,
+        top_k,
+        output_dir
+    );
+
+    return dict_to_string_map(py::cast<py::dict>(result));
+}
+
+std::map<std::string, std::string> TVMFFI::create_model_relax_ir(
+    const ModelSpec& model,
+    bool keep_params
+) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::dict spec = model_spec_arg(model);
+    py::object result = PythonHook::call_function(
+        MODULE_PATH,
+        "create_model_relax_ir",
+        model.name,
+        spec["input_specs"],
+        model.pretrained,
+        keep_params
+    );
+
+    return dict_to_string_map(py::cast<py::dict>(result));
+}
+
+SharedTuningReport TVMFFI::tune_models(
+    const std::vector<ModelSpec>& models,
+    const std::string& target_name,
+    int num_trials_per_model,
+    int target_trials_per_task,
+    int max_workers,
+    const std::string& work_dir,
+    const RelaxPipelineConfig& pipeline,
+    bool build
+) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::list model_list;
+    for (const auto& model : models) {
+        model_list.append(model_spec_arg(model));
+    }
+    py::object max_workers_obj = max_workers > 0 ? py::cast(max_workers) : py::cast<py::none>(Py_None);
+
+    py::object result = PythonHook::call_function(
+        MODULE_PATH,
+        "tune_models",
+        model_list,
+        target_name,
+        num_trials_per_model,
+        target_trials_per_task,
+        max_workers_obj,
+        work_dir,
+        pipeline_arg(pipeline),
+        build
+    );
+
+    py::dict dict_result = py::cast<py::dict>(result);
+
+    SharedTuningReport report;
+    report.status = py::cast<std::string>(dict_result["status"]);
+    if (report.status != "success") {
+        report.error = py::cast<std::string>(dict_result["error"]);
+        return report;
+    }
+
+    report.work_dir = py::cast<std::string>(dict_result["work_dir"]);
+    report.target = py::cast<std::string>(dict_result["target"]);
+    report.total_tasks = py::cast<int>(dict_result["total_tasks"]);
+    report.unique_workloads = py::cast<int>(dict_result["unique_workloads"]);
+    report.shared_workloads = py::cast<int>(dict_result["shared_workloads"]);
+    for (auto item : py::cast<py::list>(dict_result["models"])) {
+        py::dict entry = py::cast<py::dict>(item);
+        ModelTuningResult model;
+        model.name = py::cast<std::string>(entry["name"]);
+        model.status = py::cast<std::string>(entry["status"]);
+        model.error = py::cast<std::string>(entry["error"]);
+        if (model.status == "success") {
+            model.num_tasks = py::cast<int>(entry["num_tasks"]);
+            model.tuned_tasks = py::cast<int>(entry["tuned_tasks"]);
+            model.reused_tasks = py::cast<int>(entry["reused_tasks"]);
+            model.reused_from_models = py::cast<int>(entry["reused_from_models"]);
+            model.reused_from = py::cast<std::vector<std::string>>(entry["reused_from"]);
+            model.new_records = py::cast<int64_t>(entry["new_records"]);
+            model.lib_path = py::cast<std::string>(entry["lib_path"]);
+        }
+        report.models.push_back(model);
+    }
+    return report;
+}
+
+DynamicCompileResult TVMFFI::compile_dynamic(
+    const std::string& relax_mod_ir,
+    const std::string& target_name,
+    const DynamicShapeConfig& shapes,
+    bool use_auto_tuning,
+    int num_trials,
+    int target_trials_per_task,
+    int max_workers,
+    const std::string& work_dir,
+    const RelaxPipelineConfig& pipeline,
+    int num_runs
+) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::object check_shapes = py::none();
+    if (shapes.skip_check) {
+        check_shapes = py::list();
+    } else if (!shapes.check_shapes.empty()) {
+        check_shapes = py::cast(shapes.check_shapes);
+    }
+    py::object max_workers_obj = max_workers > 0 ? py::cast(max_workers) : py::cast<py::none>(Py_None);
+
+    py::object result = PythonHook::call_function(
+        MODULE_PATH,
+        "compile_dynamic",
+        relax_mod_ir,
+        target_name,
+        py::cast(shapes.representative_shapes),
+        use_auto_tuning,
+        num_trials,
+        target_trials_per_task,
+        max_workers_obj,
+        work_dir,
+        pipeline_arg(pipeline),
+        check_shapes,
+        num_runs
+    );
+
+    py::dict dict_result = py::cast<py::dict>(result);
+
+    DynamicCompileResult compiled;
+    compiled.status = py::cast<std::string>(dict_result["status"]);
+    if (compiled.status != "success") {
+        compiled.error = py::cast<std::string>(dict_result["error"]);
+        return compiled;
+    }
+
+    compiled.target = py::cast<std::string>(dict_result["target"]);
+    compiled.lib_path = py::cast<std::string>(dict_result["lib_path"]);
+    compiled.manifest_path = py::cast<std::string>(dict_result["manifest_path"]);
+    compiled.symbolic_vars = py::cast<std::vector<std::string>>(dict_result["symbolic_vars"]);
+    compiled.num_kernels = py::cast<int>(dict_result["num_kernels"]);
+    compiled.num_dynamic_kernels = py::cast<int>(dict_result["num_dynamic_kernels"]);
+    compiled.num_tuned_kernels = py::cast<int>(dict_result["num_tuned_kernels"]);
+    for (auto item : py::cast<py::list>(dict_result["specialized"])) {
+        py::dict entry = py::cast<py::dict>(item);
+        SpecializedFunction function;
+        function.function = py::cast<std::string>(entry["function"]);
+        function.bindings = py::cast<ShapeBindings>(entry["bindings"]);
+        function.num_tasks = py::cast<int>(entry["num_tasks"]);
+        function.tuned_tasks = py::cast<int>(entry["tuned_tasks"]);
+        function.reused_tasks = py::cast<int>(entry["reused_tasks"]);
+        function.new_records = py::cast<int64_t>(entry["new_records"]);
+        compiled.specialized.push_back(function);
+    }
+    for (auto item : py::cast<py::list>(dict_result["checks"])) {
+        py::dict entry = py::cast<py::dict>(item);
+        ShapeCheck check;
+        check.bindings = py::cast<ShapeBindings>(entry["bindings"]);
+        check.function = py::cast<std::string>(entry["function"]);
+        check.mean_ms = py::cast<double>(entry["mean_ms"]);
+        check.dynamic_mean_ms = py::cast<double>(entry["dynamic_mean_ms"]);
+        check.max_rel_error = py::cast<double>(entry["max_rel_error"]);
+        compiled.checks.push_back(check);
+    }
+    return compiled;
+}
+
+std::string TVMFFI::select_shape_function(
+    const std::string& manifest_path,
+    const std::vector<std::vector<int64_t>>& input_shapes
+) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::object result = PythonHook::call_function(
+        MODULE_PATH,
+        "select_shape_function",
+        manifest_path,
+        py::cast(input_shapes)
+    );
+    return py::cast<std::string>(result);
+}
+
 std::map<std::string, std::string> TVMFFI::compile_with_metaschedule(
     const std::string& relax_mod_ir,
     const std::string& target_name,
@@ -120,8 +494,12 @@ std::map<std::string, std::string> TVMFFI::compile_with_metaschedule(
     int num_trials,
     int max_workers,
     const std::string& work_dir,
-    int opt_level
+    int opt_level,
+    const CompileOptions& options
 ) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
     py::object max_workers_obj = max_workers > 0 ? py::cast(max_workers) : py::cast<py::none>(Py_None);
 
     py::object result = PythonHook::call_function(
@@ -133,27 +511,322 @@ std::map<std::string, std::string> TVMFFI::compile_with_metaschedule(
         num_trials,
         max_workers_obj,
         work_dir,
+        opt_level,
+        options.trace_path,
+        std::string(to_string(options.mixed_precision.precision)),
+        options.mixed_precision.allow_ops,
+        options.mixed_precision.deny_ops,
+        options.layout.pack_conv,
+        options.layout.block_size,
+        std::string(to_string(options.backend.backend)),
+        options.backend.offload_ops,
+        pipeline_arg(options.pipeline),
+        options.destination_passing
+    );
+
+    py::dict dict_result = py::cast<py::dict>(result);
+    fill_pipeline_timings(dict_result, options.timings);
+
+    std::map<std::string, std::string> compile_info = dict_to_string_map(dict_result);
+    compile_info.erase("phases");
+    compile_info.erase("passes");
+    return compile_info;
+}
+
+BackendBenchmark TVMFFI::benchmark_backends(
+    const std::string& relax_mod_ir,
+    const std::string& target_name,
+    int num_trials,
+    int max_workers,
+    const std::string& work_dir,
+    int num_runs,
+    const std::vector<std::string>& offload_ops
+) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::object max_workers_obj = max_workers > 0 ? py::cast(max_workers) : py::cast<py::none>(Py_None);
+
+    py::object result = PythonHook::call_function(
+        MODULE_PATH,
+        "benchmark_backends",
+        relax_mod_ir,
+        target_name,
+        num_trials,
+        max_workers_obj,
+        work_dir,
+        num_runs,
+        offload_ops
+    );
+
+    py::dict dict_result = py::cast<py::dict>(result);
+
+    BackendBenchmark benchmark;
+    benchmark.status = py::cast<std::string>(dict_result["status"]);
+    if (benchmark.status != "success") {
+        benchmark.error = py::cast<std::string>(dict_result["error"]);
+        return benchmark;
+    }
+
+    benchmark.target = py::cast<std::string>(dict_result["target"]);
+    for (auto item : py::cast<py::list>(dict_result["results"])) {
+        py::dict entry = py::cast<py::dict>(item);
+        BackendResult variant;
+        variant.name = py::cast<std::string>(entry["name"]);
+        variant.status = py::cast<std::string>(entry["status"]);
+        variant.error = py::cast<std::string>(entry["error"]);
+        variant.num_offloaded = py::cast<int>(entry["num_offloaded"]);
+        if (variant.status == "success") {
+            variant.compile_ms = py::cast<double>(entry["compile_ms"]);
+            variant.mean_ms = py::cast<double>(entry["mean_ms"]);
+            variant.p50_ms = py::cast<double>(entry["p50_ms"]);
+            variant.min_ms = py::cast<double>(entry["min_ms"]);
+            variant.library_bytes = py::cast<int64_t>(entry["library_bytes"]);
+            variant.runtime_rss_kb = py::cast<int64_t>(entry["runtime_rss_kb"]);
+            variant.peak_rss_kb = py::cast<int64_t>(entry["peak_rss_kb"]);
+            variant.max_rel_error = py::cast<double>(entry["max_rel_error"]);
+        }
+        benchmark.results.push_back(variant);
+    }
+    return benchmark;
+}
+
+PipelineComparison TVMFFI::compare_relax_pipelines(
+    const std::string& relax_mod_ir,
+    const std::string& target_name,
+    const std::vector<RelaxPipelineConfig>& pipelines,
+    int num_runs,
+    int opt_level
+) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::list pipeline_list;
+    for (const auto& pipeline : pipelines) {
+        pipeline_list.append(pipeline_arg(pipeline));
+    }
+
+    py::object result = PythonHook::call_function(
+        MODULE_PATH,
+        "compare_relax_pipelines",
+        relax_mod_ir,
+        target_name,
+        pipeline_list,
+        num_runs,
         opt_level
     );
 
     py::dict dict_result = py::cast<py::dict>(result);
 
-    std::map<std::string, std::string> compile_info;
-    for (auto item : dict_result) {
-        std::string key = py::cast<std::string>(item.first);
+    PipelineComparison comparison;
+    comparison.status = py::cast<std::string>(dict_result["status"]);
+    if (comparison.status != "success") {
+        comparison.error = py::cast<std::string>(dict_result["error"]);
+        return comparison;
+    }
 
-        if (py::isinstance<py::str>(item.second)) {
-            compile_info[key] = py::cast<std::string>(item.second);
-        } else if (py::isinstance<py::int_>(item.second)) {
-            compile_info[key] = std::to_string(py::cast<int>(item.second));
-        } else if (py::isinstance<py::bool_>(item.second)) {
-            compile_info[key] = py::cast<bool>(item.second) ? "true" : "false";
-        } else {
-            compile_info[key] = py::cast<std::string>(py::str(item.second));
+    comparison.target = py::cast<std::string>(dict_result["target"]);
+    for (auto item : py::cast<py::list>(dict_result["results"])) {
+        py::dict entry = py::cast<py::dict>(item);
+        RelaxPipelineReport report;
+        report.pipeline = py::cast<std::string>(entry["pipeline"]);
+        report.passes = py::cast<std::vector<std::string>>(entry["passes"]);
+        report.status = py::cast<std::string>(entry["status"]);
+        report.error = py::cast<std::string>(entry["error"]);
+        if (report.status == "success") {
+            report.pass_reports = to_pass_reports(entry["pass_reports"]);
+            report.pipeline_ms = py::cast<double>(entry["pipeline_ms"]);
+            report.build_ms = py::cast<double>(entry["build_ms"]);
+            report.mean_ms = py::cast<double>(entry["mean_ms"]);
+            report.p50_ms = py::cast<double>(entry["p50_ms"]);
+            report.num_primfuncs = py::cast<int>(entry["num_primfuncs"]);
+            report.max_rel_error = py::cast<double>(entry["max_rel_error"]);
         }
+        comparison.results.push_back(report);
     }
+    return comparison;
+}
 
-    return compile_info;
+std::map<std::string, std::vector<std::string>> TVMFFI::get_relax_pipeline_presets() {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::object result = PythonHook::call_function(MODULE_PATH, "get_relax_pipeline_presets");
+    return PythonHook::to_cpp<std::map<std::string, std::vector<std::string>>>(result);
+}
+
+MemoryPlanReport TVMFFI::memory_plan_report(
+    const std::string& relax_mod_ir,
+    const std::string& target_name,
+    const RelaxPipelineConfig& pipeline,
+    bool check_runtime,
+    int top_k,
+    int num_runs
+) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::object result = PythonHook::call_function(
+        MODULE_PATH,
+        "memory_plan_report",
+        relax_mod_ir,
+        target_name,
+        pipeline_arg(pipeline),
+        top_k,
+        check_runtime,
+        num_runs
+    );
+
+    py::dict dict_result = py::cast<py::dict>(result);
+
+    MemoryPlanReport report;
+    report.status = py::cast<std::string>(dict_result["status"]);
+    if (report.status != "success") {
+        report.error = py::cast<std::string>(dict_result["error"]);
+        return report;
+    }
+
+    report.target = py::cast<std::string>(dict_result["target"]);
+    report.function = py::cast<std::string>(dict_result["function"]);
+    report.planned_bytes = py::cast<int64_t>(dict_result["planned_bytes"]);
+    report.requested_bytes = py::cast<int64_t>(dict_result["requested_bytes"]);
+    report.unplanned_bytes = py::cast<int64_t>(dict_result["unplanned_bytes"]);
+    report.peak_live_bytes = py::cast<int64_t>(dict_result["peak_live_bytes"]);
+    report.num_storage_tokens = py::cast<int>(dict_result["num_storage_tokens"]);
+    report.num_planned_tensors = py::cast<int>(dict_result["num_planned_tensors"]);
+    report.num_unplanned_tensors = py::cast<int>(dict_result["num_unplanned_tensors"]);
+    report.num_dynamic_allocations = py::cast<int>(dict_result["num_dynamic_allocations"]);
+    report.reuse_ratio = py::cast<double>(dict_result["reuse_ratio"]);
+    report.plan_efficiency = py::cast<double>(dict_result["plan_efficiency"]);
+    for (auto item : py::cast<py::list>(dict_result["largest_allocations"])) {
+        py::dict entry = py::cast<py::dict>(item);
+        PlannedAllocation allocation;
+        allocation.storage = py::cast<std::string>(entry["storage"]);
+        allocation.bytes = py::cast<int64_t>(entry["bytes"]);
+        allocation.tensors = py::cast<std::vector<std::string>>(entry["tensors"]);
+        report.largest_allocations.push_back(allocation);
+    }
+
+    report.runtime_checked = py::cast<bool>(dict_result["runtime_checked"]);
+    if (report.runtime_checked) {
+        report.runtime_storage_bytes = py::cast<int64_t>(dict_result["runtime_storage_bytes"]);
+        report.runtime_num_allocations = py::cast<int64_t>(dict_result["runtime_num_allocations"]);
+        report.runtime_rss_delta_kb = py::cast<int64_t>(dict_result["runtime_rss_delta_kb"]);
+        report.runtime_ms = py::cast<double>(dict_result["runtime_ms"]);
+        report.within_plan = py::cast<bool>(dict_result["within_plan"]);
+    }
+    return report;
+}
+
+std::map<std::string, std::string> TVMFFI::compare_layout_packing(
+    const std::string& relax_mod_ir,
+    const std::string& target_name,
+    int block_size,
+    int num_runs
+) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::object result = PythonHook::call_function(
+        MODULE_PATH,
+        "compare_layout_packing",
+        relax_mod_ir,
+        target_name,
+        block_size,
+        num_runs
+    );
+
+    return dict_to_string_map(py::cast<py::dict>(result));
+}
+
+PrecisionComparison TVMFFI::compare_mixed_precision(
+    const std::string& relax_mod_ir,
+    const std::string& target_name,
+    const MixedPrecisionConfig& config,
+    int num_runs
+) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    Precision precision = config.precision == Precision::Float32 ? Precision::BFloat16 : config.precision;
+
+    py::object result = PythonHook::call_function(
+        MODULE_PATH,
+        "compare_mixed_precision",
+        relax_mod_ir,
+        target_name,
+        std::string(to_string(precision)),
+        config.allow_ops,
+        config.deny_ops,
+        num_runs
+    );
+
+    py::dict dict_result = py::cast<py::dict>(result);
+
+    PrecisionComparison comparison;
+    comparison.status = py::cast<std::string>(dict_result["status"]);
+    if (comparison.status != "success") {
+        comparison.error = py::cast<std::string>(dict_result["error"]);
+        return comparison;
+    }
+
+    comparison.target = py::cast<std::string>(dict_result["target"]);
+    comparison.precision = py::cast<std::string>(dict_result["precision"]);
+    comparison.num_converted_layers = py::cast<int>(dict_result["num_converted_layers"]);
+    comparison.converted_layers = py::cast<std::vector<std::string>>(dict_result["converted_layers"]);
+    comparison.float_latency_ms = py::cast<double>(dict_result["float_latency_ms"]);
+    comparison.mixed_latency_ms = py::cast<double>(dict_result["mixed_latency_ms"]);
+    comparison.speedup = py::cast<double>(dict_result["speedup"]);
+    comparison.float_weight_bytes = py::cast<int64_t>(dict_result["float_weight_bytes"]);
+    comparison.mixed_weight_bytes = py::cast<int64_t>(dict_result["mixed_weight_bytes"]);
+    comparison.max_abs_error = py::cast<double>(dict_result["max_abs_error"]);
+    comparison.mean_abs_error = py::cast<double>(dict_result["mean_abs_error"]);
+    comparison.max_rel_error = py::cast<double>(dict_result["max_rel_error"]);
+    comparison.top1_agreement = py::cast<double>(dict_result["top1_agreement"]);
+    return comparison;
+}
+
+std::map<std::string, std::string> TVMFFI::quantize_with_metaschedule(
+    const std::string& relax_mod_ir,
+    const std::string& calibration_dir,
+    const std::string& target_name,
+    bool use_auto_tuning,
+    int num_trials,
+    int max_workers,
+    const std::string& work_dir,
+    int num_calibration,
+    const std::string& calibration_method,
+    const std::string& eval_dir,
+    PipelineTimings* timings,
+    const std::string& trace_path
+) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::object max_workers_obj = max_workers > 0 ? py::cast(max_workers) : py::cast<py::none>(Py_None);
+
+    py::object result = PythonHook::call_function(
+        MODULE_PATH,
+        "quantize_with_metaschedule",
+        relax_mod_ir,
+        calibration_dir,
+        target_name,
+        use_auto_tuning,
+        num_trials,
+        max_workers_obj,
+        work_dir,
+        num_calibration,
+        calibration_method,
+        eval_dir,
+        trace_path
+    );
+
+    py::dict dict_result = py::cast<py::dict>(result);
+    fill_pipeline_timings(dict_result, timings);
+
+    std::map<std::string, std::string> info = dict_to_string_map(dict_result);
+    info.erase("phases");
+    return info;
 }
 
 std::map<std::string, std::string> TVMFFI::tune_with_metaschedule(
@@ -161,8 +834,16 @@ std::map<std::string, std::string> TVMFFI::tune_with_metaschedule(
     const std::string& target_name,
     int num_trials,
     int max_workers,
-    const std::string& work_dir
+    const std::string& work_dir,
+    int rpc_servers,
+    int cores_per_server,
+    PipelineTimings* timings,
+    const std::string& trace_path,
+    const RelaxPipelineConfig& pipeline
 ) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
     py::object max_workers_obj = max_workers > 0 ? py::cast(max_workers) : py::cast<py::none>(Py_None);
 
     py::object result = PythonHook::call_function(
@@ -172,34 +853,221 @@ std::map<std::string, std::string> TVMFFI::tune_with_metaschedule(
         target_name,
         num_trials,
         max_workers_obj,
+        work_dir,
+        rpc_servers,
+        cores_per_server,
+        trace_path,
+        pipeline_arg(pipeline)
+    );
+
+    py::dict dict_result = py::cast<py::dict>(result);
+    fill_pipeline_timings(dict_result, timings);
+
+    std::map<std::string, std::string> tune_info = dict_to_string_map(dict_result);
+    tune_info.erase("phases");
+    tune_info.erase("passes");
+    return tune_info;
+}
+
+std::map<std::string, std::string> TVMFFI::tune_with_metaschedule(
+    const std::string& relax_mod_ir,
+    const std::string& target_name,
+    const TuningConfig& config,
+    const std::string& work_dir
+) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::dict evolutionary;
+    evolutionary["population_size"] = config.evolutionary.population_size;
+    evolutionary["init_measured_ratio"] = config.evolutionary.init_measured_ratio;
+    evolutionary["init_min_unmeasured"] = config.evolutionary.init_min_unmeasured;
+    evolutionary["max_fail_count"] = config.evolutionary.max_fail_count;
+    evolutionary["genetic_num_iters"] = config.evolutionary.genetic_num_iters;
+    evolutionary["genetic_mutate_prob"] = config.evolutionary.genetic_mutate_prob;
+    evolutionary["genetic_max_fail_count"] = config.evolutionary.genetic_max_fail_count;
+    evolutionary["eps_greedy"] = config.evolutionary.eps_greedy;
+
+    py::dict config_dict;
+    config_dict["num_trials"] = config.num_trials;
+    config_dict["max_trials_per_task"] = config.max_trials_per_task;
+    config_dict["num_trials_per_iter"] = config.num_trials_per_iter;
+    config_dict["max_workers"] = config.max_workers;
+    config_dict["seed"] = config.seed;
+    config_dict["post_optimization"] = config.post_optimization;
+    config_dict["cost_model"] = to_string(config.cost_model);
+    config_dict["search_strategy"] = to_string(config.search_strategy);
+    config_dict["evolutionary"] = evolutionary;
+    config_dict["space_generator"] = config.space_generator;
+    config_dict["mutator_probs"] = py::cast(config.mutator_probs);
+    config_dict["postprocs"] = py::cast(config.postprocs);
+    config_dict["early_stopping_patience"] = config.early_stopping.patience;
+    config_dict["early_stopping_min_improvement"] = config.early_stopping.min_improvement;
+
+    py::dict measurement;
+    measurement["mode"] = to_string(config.measurement.mode);
+    if (config.measurement.mode == MeasurementMode::Adaptive) {
+        measurement["min_repeats"] = config.measurement.min_repeats;
+        measurement["max_repeats"] = config.measurement.max_repeats;
+        measurement["repeat_step"] = config.measurement.repeat_step;
+        measurement["target_rel_ci"] = config.measurement.target_rel_ci;
+        measurement["confidence"] = config.measurement.confidence;
+        measurement["min_repeat_ms"] = config.measurement.min_repeat_ms;
+        measurement["timeout_sec"] = config.measurement.timeout_sec;
+        measurement["enable_cpu_cache_flush"] = config.measurement.enable_cpu_cache_flush;
+    }
+    config_dict["measurement"] = measurement;
+    config_dict["pipeline"] = pipeline_arg(config.pipeline);
+
+    py::object result = PythonHook::call_function(
+        MODULE_PATH,
+        "tune_with_config",
+        relax_mod_ir,
+        target_name,
+        config_dict,
         work_dir
     );
 
+    return dict_to_string_map(py::cast<py::dict>(result));
+}
+
+std::map<std::string, std::string> TVMFFI::tune_incremental(
+    const std::string& relax_mod_ir,
+    const std::string& target_name,
+    int num_trials,
+    int target_trials_per_task,
+    int max_workers,
+    const std::string& work_dir,
+    int convergence_window,
+    double convergence_tol,
+    const RelaxPipelineConfig& pipeline
+) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::object result = PythonHook::call_function(
+        MODULE_PATH,
+        "tune_incremental",
+        relax_mod_ir,
+        target_name,
+        num_trials,
+        target_trials_per_task,
+        max_workers,
+        work_dir,
+        convergence_window,
+        convergence_tol,
+        pipeline_arg(pipeline)
+    );
+
+    return dict_to_string_map(py::cast<py::dict>(result));
+}
+
+WarmStartReport TVMFFI::tune_with_warm_start(
+    const std::string& relax_mod_ir,
+    const std::string& target_name,
+    const WarmStartConfig& config,
+    int num_trials,
+    int max_workers,
+    const std::string& work_dir,
+    const RelaxPipelineConfig& pipeline
+) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::object max_workers_obj = max_workers > 0 ? py::cast(max_workers) : py::cast<py::none>(Py_None);
+
+    py::object result = PythonHook::call_function(
+        MODULE_PATH,
+        "tune_with_warm_start",
+        relax_mod_ir,
+        target_name,
+        py::cast(config.source_work_dirs),
+        num_trials,
+        max_workers_obj,
+        work_dir,
+        pipeline_arg(pipeline),
+        config.seeds_per_task,
+        config.pretrain_cost_model,
+        config.compare,
+        config.tolerance
+    );
+
     py::dict dict_result = py::cast<py::dict>(result);
 
-    std::map<std::string, std::string> tune_info;
-    for (auto item : dict_result) {
-        std::string key = py::cast<std::string>(item.first);
+    WarmStartReport report;
+    report.status = py::cast<std::string>(dict_result["status"]);
+    if (report.status != "success") {
+        report.error = py::cast<std::string>(dict_result["error"]);
+        return report;
+    }
 
-        if (py::isinstance<py::str>(item.second)) {
-            tune_info[key] = py::cast<std::string>(item.second);
-        } else if (py::isinstance<py::int_>(item.second)) {
-            tune_info[key] = std::to_string(py::cast<int>(item.second));
-        } else if (py::isinstance<py::bool_>(item.second)) {
-            tune_info[key] = py::cast<bool>(item.second) ? "true" : "false";
-        } else {
-            tune_info[key] = py::cast<std::string>(py::str(item.second));
-        }
+    report.target = py::cast<std::string>(dict_result["target"]);
+    report.work_dir = py::cast<std::string>(dict_result["work_dir"]);
+    report.num_tasks = py::cast<int>(dict_result["num_tasks"]);
+    report.num_source_records = py::cast<int64_t>(dict_result["num_source_records"]);
+    report.num_seed_trials = py::cast<int>(dict_result["num_seed_trials"]);
+    report.num_valid_seeds = py::cast<int>(dict_result["num_valid_seeds"]);
+    report.pretrain_samples = py::cast<int>(dict_result["pretrain_samples"]);
+    for (auto item : py::cast<py::list>(dict_result["tasks"])) {
+        py::dict entry = py::cast<py::dict>(item);
+        TaskSeedReport task;
+        task.task_name = py::cast<std::string>(entry["task_name"]);
+        task.weight = py::cast<int>(entry["weight"]);
+        task.match = py::cast<std::string>(entry["match"]);
+        task.shape_distance = py::cast<double>(entry["shape_distance"]);
+        task.source_target = py::cast<std::string>(entry["source_target"]);
+        task.num_seeds = py::cast<int>(entry["num_seeds"]);
+        task.num_valid_seeds = py::cast<int>(entry["num_valid_seeds"]);
+        task.best_seed_us = py::cast<double>(entry["best_seed_us"]);
+        report.tasks.push_back(task);
     }
 
-    return tune_info;
+    report.warm = to_convergence_report(py::cast<py::dict>(dict_result["warm"]));
+    report.compared = dict_result.contains("cold");
+    if (report.compared) {
+        report.cold = to_convergence_report(py::cast<py::dict>(dict_result["cold"]));
+        report.trials_saved = py::cast<int>(dict_result["trials_saved"]);
+    }
+    return report;
+}
+
+std::map<std::string, std::string> TVMFFI::tune_with_budget_allocation(
+    const std::string& relax_mod_ir,
+    const std::string& target_name,
+    int num_trials,
+    int num_rounds,
+    int min_trials_per_task,
+    int max_workers,
+    const std::string& work_dir,
+    const RelaxPipelineConfig& pipeline
+) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::object result = PythonHook::call_function(
+        MODULE_PATH,
+        "tune_with_budget_allocation",
+        relax_mod_ir,
+        target_name,
+        num_trials,
+        num_rounds,
+        min_trials_per_task,
+        max_workers,
+        work_dir,
+        pipeline_arg(pipeline)
+    );
+
+    return dict_to_string_map(py::cast<py::dict>(result));
 }
 
 std::map<std::string, std::string> TVMFFI::apply_tuning_database(
     const std::string& relax_mod_ir,
     const std::string& target_name,
     const std::string& work_dir,
-    int opt_level
+    int opt_level,
+    PipelineTimings* timings,
+    const std::string& trace_path,
+    const std::string& rank_by
 ) {
     py::object result = PythonHook::call_function(
         MODULE_PATH,
@@ -207,27 +1075,236 @@ std::map<std::string, std::string> TVMFFI::apply_tuning_database(
         relax_mod_ir,
         target_name,
         work_dir,
-        opt_level
+        opt_level,
+        trace_path,
+        rank_by
     );
 
     py::dict dict_result = py::cast<py::dict>(result);
+    fill_pipeline_timings(dict_result, timings);
 
-    std::map<std::string, std::string> build_info;
-    for (auto item : dict_result) {
-        std::string key = py::cast<std::string>(item.first);
+    std::map<std::string, std::string> build_info = dict_to_string_map(dict_result);
+    build_info.erase("phases");
+    build_info.erase("passes");
+    return build_info;
+}
 
-        if (py::isinstance<py::str>(item.second)) {
-            build_info[key] = py::cast<std::string>(item.second);
-        } else if (py::isinstance<py::int_>(item.second)) {
-            build_info[key] = std::to_string(py::cast<int>(item.second));
-        } else if (py::isinstance<py::bool_>(item.second)) {
-            build_info[key] = py::cast<bool>(item.second) ? "true" : "false";
-        } else {
-            build_info[key] = py::cast<std::string>(py::str(item.second));
-        }
+std::map<std::string, std::string> TVMFFI::detect_host_cpu() {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::object result = PythonHook::call_function(MODULE_PATH, "detect_host_cpu");
+    std::map<std::string, std::string> cpu_info = dict_to_string_map(py::cast<py::dict>(result));
+
+    py::object target = PythonHook::call_function(MODULE_PATH, "build_llvm_target_string");
+    cpu_info["target"] = py::cast<std::string>(target);
+
+    return cpu_info;
+}
+
+std::map<std::string, std::string> TVMFFI::build_cpu_variants(
+    const std::string& relax_mod_ir,
+    const std::vector<std::string>& variants,
+    const std::string& work_dir,
+    int opt_level,
+    const RelaxPipelineConfig& pipeline
+) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::object result = PythonHook::call_function(
+        MODULE_PATH,
+        "build_cpu_variants",
+        relax_mod_ir,
+        variants,
+        work_dir,
+        opt_level,
+        pipeline_arg(pipeline)
+    );
+
+    return dict_to_string_map(py::cast<py::dict>(result));
+}
+
+std::map<std::string, std::string> TVMFFI::select_cpu_variant(const std::string& work_dir) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::object result = PythonHook::call_function(MODULE_PATH, "select_cpu_variant", work_dir);
+    return dict_to_string_map(py::cast<py::dict>(result));
+}
+
+std::map<std::string, std::string> TVMFFI::get_cpu_topology() {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::object result = PythonHook::call_function(MODULE_PATH, "cpu_topology");
+    py::dict topology = py::cast<py::dict>(result);
+    py::dict numa_nodes = py::cast<py::dict>(topology["numa_nodes"]);
+
+    py::dict flat;
+    flat["cpus"] = topology["cpus"];
+    flat["big_cores"] = topology["big_cores"];
+    flat["little_cores"] = topology["little_cores"];
+    flat["num_numa_nodes"] = py::len(numa_nodes);
+    for (auto item : numa_nodes) {
+        flat[py::str("numa_node_" + py::cast<std::string>(py::str(item.first)))] = item.second;
     }
+    return dict_to_string_map(flat);
+}
 
-    return build_info;
+std::map<std::string, std::string> TVMFFI::configure_runtime(const RuntimeConfig& config) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::object result = PythonHook::call_function(
+        MODULE_PATH,
+        "configure_runtime",
+        config.num_threads,
+        to_string(config.core_mode),
+        config.cpus,
+        config.numa_node,
+        config.pin_threads,
+        to_string(config.wait_policy),
+        config.spin_count
+    );
+
+    return dict_to_string_map(py::cast<py::dict>(result));
+}
+
+void TVMFFI::reset_runtime() {
+    PythonHook::call_function(MODULE_PATH, "reset_runtime");
+}
+
+ThreadScalingReport TVMFFI::benchmark_thread_scaling(
+    const std::string& relax_mod_ir,
+    const std::string& target_name,
+    const std::vector<int>& thread_counts,
+    int num_runs,
+    const RelaxPipelineConfig& pipeline
+) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::object result = PythonHook::call_function(
+        MODULE_PATH,
+        "benchmark_thread_scaling",
+        relax_mod_ir,
+        target_name,
+        thread_counts,
+        num_runs,
+        py::arg("pipeline") = pipeline_arg(pipeline)
+    );
+
+    py::dict dict_result = py::cast<py::dict>(result);
+
+    ThreadScalingReport report;
+    report.status = py::cast<std::string>(dict_result["status"]);
+    if (report.status != "success") {
+        report.error = py::cast<std::string>(dict_result["error"]);
+        return report;
+    }
+
+    report.target = py::cast<std::string>(dict_result["target"]);
+    report.num_numa_nodes = py::cast<int>(dict_result["num_numa_nodes"]);
+    report.num_runs = py::cast<int>(dict_result["num_runs"]);
+
+    for (auto item : py::cast<py::list>(dict_result["results"])) {
+        py::dict row = py::cast<py::dict>(item);
+
+        ThreadScalingResult entry;
+        entry.placement = py::cast<std::string>(row["placement"]);
+        entry.num_threads = py::cast<int>(row["num_threads"]);
+        entry.numa_nodes_used = py::cast<int>(row["numa_nodes_used"]);
+        entry.mean_ms = py::cast<double>(row["mean_ms"]);
+        entry.p50_ms = py::cast<double>(row["p50_ms"]);
+        entry.std_ms = py::cast<double>(row["std_ms"]);
+        entry.speedup = py::cast<double>(row["speedup"]);
+        entry.efficiency = py::cast<double>(row["efficiency"]);
+        report.results.push_back(entry);
+    }
+
+    return report;
+}
+
+ProfileReport TVMFFI::profile_relax_module(
+    const std::string& relax_mod_ir,
+    const std::string& target_name,
+    const std::string& work_dir,
+    bool use_database,
+    int num_runs,
+    int opt_level,
+    const RelaxPipelineConfig& pipeline
+) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::object result = PythonHook::call_function(
+        MODULE_PATH,
+        "profile_relax_module",
+        relax_mod_ir,
+        target_name,
+        work_dir,
+        use_database,
+        num_runs,
+        opt_level,
+        pipeline_arg(pipeline)
+    );
+
+    py::dict dict_result = py::cast<py::dict>(result);
+
+    ProfileReport report;
+    report.status = py::cast<std::string>(dict_result["status"]);
+    if (report.status != "success") {
+        report.error = py::cast<std::string>(dict_result["error"]);
+        return report;
+    }
+
+    report.target = py::cast<std::string>(dict_result["target"]);
+    report.work_dir = py::cast<std::string>(dict_result["work_dir"]);
+    report.num_runs = py::cast<int>(dict_result["num_runs"]);
+    report.e2e_time_us = py::cast<double>(dict_result["e2e_time_us"]);
+
+    for (auto item : py::cast<py::list>(dict_result["operators"])) {
+        py::dict row = py::cast<py::dict>(item);
+
+        OperatorProfile op;
+        op.name = py::cast<std::string>(row["name"]);
+        op.call_count = py::cast<int64_t>(row["call_count"]);
+        op.total_us = py::cast<double>(row["total_us"]);
+        op.mean_us = py::cast<double>(row["mean_us"]);
+        op.share = py::cast<double>(row["share"]);
+        op.flops = py::cast<double>(row["flops"]);
+        op.gflops_per_sec = py::cast<double>(row["gflops_per_sec"]);
+        op.workload_hash = py::cast<std::string>(row["workload_hash"]);
+        op.tuning_records = py::cast<int64_t>(row["tuning_records"]);
+        op.best_tuned_us = py::cast<double>(row["best_tuned_us"]);
+        report.operators.push_back(op);
+    }
+
+    return report;
+}
+
+std::map<std::string, std::string> TVMFFI::export_with_params_as_input(
+    const std::string& relax_mod_ir,
+    const std::string& target_name,
+    const std::string& work_dir,
+    int opt_level,
+    const RelaxPipelineConfig& pipeline
+) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    py::object result = PythonHook::call_function(
+        MODULE_PATH,
+        "export_with_params_as_input",
+        relax_mod_ir,
+        target_name,
+        work_dir,
+        opt_level,
+        pipeline_arg(pipeline)
+    );
+
+    return dict_to_string_map(py::cast<py::dict>(result));
 }
 
 } // namespace ffi
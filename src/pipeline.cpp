@@ -0,0 +1,348 @@
+#include "pipeline.h"
+#include <pybind11/stl.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace tvm_sdk {
+
+namespace {
+
+uint64_t elapsed_ns(std::chrono::steady_clock::time_point since) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - since).count());
+}
+
+/**
+ * @brief Spin briefly, then yield, then sleep while a queue stays full or empty
+ */
+class Backoff {
+public:
+    void wait() {
+        if (count_ < 64) {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#elif defined(__aarch64__)
+            asm volatile("yield");
+#endif
+        } else if (count_ < 128) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        count_++;
+    }
+
+private:
+    int count_ = 0;
+};
+
+py::object to_python(const std::any& item) {
+    if (const PyItem* object = std::any_cast<PyItem>(&item)) {
+        return **object;
+    }
+    if (const std::string* text = std::any_cast<std::string>(&item)) {
+        return py::str(*text);
+    }
+    if (const int64_t* value = std::any_cast<int64_t>(&item)) {
+        return py::int_(*value);
+    }
+    if (const double* value = std::any_cast<double>(&item)) {
+        return py::float_(*value);
+    }
+    if (const std::vector<float>* values = std::any_cast<std::vector<float>>(&item)) {
+        return py::cast(*values);
+    }
+    throw std::invalid_argument(std::string("Unsupported item type for a Python stage: ") + item.type().name());
+}
+
+StageFn make_python_fn(py::object callable) {
+    PyItem holder = make_py_item(std::move(callable));
+    return [holder](std::any item) -> std::any {
+        py::gil_scoped_acquire gil;
+        try {
+            py::object result = (*holder)(to_python(item));
+            if (result.is_none()) {
+                return std::any();
+            }
+            return make_py_item(std::move(result));
+        } catch (const py::error_already_set& e) {
+            throw std::runtime_error(e.what());
+        }
+    };
+}
+
+} // namespace
+
+PyItem make_py_item(py::object object) {
+    return PyItem(new py::object(std::move(object)), [](py::object* ptr) {
+        if (PythonHook::is_initialized()) {
+            py::gil_scoped_acquire gil;
+            delete ptr;
+        }
+    });
+}
+
+struct Pipeline::Stage {
+    std::string name;
+    std::vector<StageFn> fns;           ///< One per worker
+    std::atomic<int> active_workers{0};
+
+    std::atomic<uint64_t> items{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> errors{0};
+    std::atomic<uint64_t> busy_ns{0};
+    std::atomic<uint64_t> starved_ns{0};
+    std::atomic<uint64_t> blocked_ns{0};
+};
+
+Pipeline::Pipeline(size_t queue_capacity) : queue_capacity_(queue_capacity) {
+    if (queue_capacity_ == 0) {
+        throw std::invalid_argument("Pipeline queue capacity must be positive");
+    }
+    queues_.push_back(std::make_unique<Queue>(queue_capacity_));
+}
+
+Pipeline::~Pipeline() {
+    stop();
+}
+
+Pipeline& Pipeline::append(std::unique_ptr<Stage> stage) {
+    if (started_) {
+        throw std::logic_error("Cannot add stages to a started pipeline");
+    }
+    if (stage->fns.empty()) {
+        throw std::invalid_argument("Pipeline stage '" + stage->name + "' needs at least one worker");
+    }
+    stages_.push_back(std::move(stage));
+    queues_.push_back(std::make_unique<Queue>(queue_capacity_));
+    return *this;
+}
+
+Pipeline& Pipeline::add_stage(const std::string& name, StageFn fn, int num_workers) {
+    auto stage = std::make_unique<Stage>();
+    stage->name = name;
+    stage->fns.assign(static_cast<size_t>(std::max(num_workers, 0)), fn);
+    return append(std::move(stage));
+}
+
+Pipeline& Pipeline::add_python_stage(
+    const std::string& name,
+    const std::string& module_path,
+    const std::string& factory,
+    int num_workers,
+    const std::vector<std::string>& args
+) {
+    auto stage = std::make_unique<Stage>();
+    stage->name = name;
+
+    PythonHook::initialize();
+    {
+        py::gil_scoped_acquire gil;
+        try {
+            py::object create = PythonHook::import_module(module_path).attr(factory.c_str());
+            py::tuple call_args = py::tuple(py::cast(args));
+            for (int i = 0; i < num_workers; i++) {
+                stage->fns.push_back(make_python_fn(create(*call_args)));
+            }
+        } catch (const py::error_already_set& e) {
+            throw std::runtime_error(
+                "Failed to create pipeline stage '" + name + "' from " + module_path + "." + factory + ": " + e.what()
+            );
+        }
+    }
+    return append(std::move(stage));
+}
+
+Pipeline& Pipeline::add_python_stage(const std::string& name, py::object callable, int num_workers) {
+    auto stage = std::make_unique<Stage>();
+    stage->name = name;
+    StageFn fn = make_python_fn(std::move(callable));
+    stage->fns.assign(static_cast<size_t>(std::max(num_workers, 0)), fn);
+    return append(std::move(stage));
+}
+
+void Pipeline::start() {
+    if (started_) {
+        return;
+    }
+    if (stages_.empty()) {
+        throw std::logic_error("Pipeline has no stages");
+    }
+    started_ = true;
+    start_time_ = std::chrono::steady_clock::now();
+
+    for (auto& stage : stages_) {
+        stage->active_workers.store(static_cast<int>(stage->fns.size()));
+    }
+    for (size_t index = 0; index < stages_.size(); index++) {
+        for (size_t worker = 0; worker < stages_[index]->fns.size(); worker++) {
+            threads_.emplace_back(&Pipeline::run_worker, this, index, worker);
+        }
+    }
+}
+
+bool Pipeline::push(Queue& queue, Item& item, std::atomic<uint64_t>* wait_ns) {
+    if (queue.try_push(item)) {
+        return true;
+    }
+    auto begin = std::chrono::steady_clock::now();
+    Backoff backoff;
+    bool pushed = false;
+    while (!cancelled_.load(std::memory_order_relaxed)) {
+        if (queue.try_push(item)) {
+            pushed = true;
+            break;
+        }
+        backoff.wait();
+    }
+    if (wait_ns != nullptr) {
+        wait_ns->fetch_add(elapsed_ns(begin), std::memory_order_relaxed);
+    }
+    return pushed;
+}
+
+bool Pipeline::pop(Queue& queue, Item& item, std::atomic<uint64_t>* wait_ns) {
+    if (queue.try_pop(item)) {
+        return true;
+    }
+    auto begin = std::chrono::steady_clock::now();
+    Backoff backoff;
+    bool popped = false;
+    while (!cancelled_.load(std::memory_order_relaxed)) {
+        if (queue.try_pop(item)) {
+            popped = true;
+            break;
+        }
+        // Re-check after seeing the close flag: the last push may have raced with it
+        if (queue.closed()) {
+            popped = queue.try_pop(item);
+            break;
+        }
+        backoff.wait();
+    }
+    if (wait_ns != nullptr) {
+        wait_ns->fetch_add(elapsed_ns(begin), std::memory_order_relaxed);
+    }
+    return popped;
+}
+
+void Pipeline::run_worker(size_t stage_index, size_t worker) {
+    Stage& stage = *stages_[stage_index];
+    Queue& input = *queues_[stage_index];
+    Queue& output = *queues_[stage_index + 1];
+    StageFn& fn = stage.fns[worker];
+
+    Item item;
+    while (pop(input, item, &stage.starved_ns)) {
+        auto begin = std::chrono::steady_clock::now();
+        std::any result;
+        try {
+            TraceScope scope("pipeline", stage.name.c_str());
+            result = fn(std::move(item.value));
+        } catch (const std::exception& e) {
+            stage.errors.fetch_add(1, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(error_mutex_);
+            if (first_error_.empty()) {
+                first_error_ = stage.name + ": " + e.what();
+            }
+        }
+        stage.busy_ns.fetch_add(elapsed_ns(begin), std::memory_order_relaxed);
+        stage.items.fetch_add(1, std::memory_order_relaxed);
+
+        if (!result.has_value()) {
+            stage.dropped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        item.value = std::move(result);
+        if (!push(output, item, &stage.blocked_ns)) {
+            break;
+        }
+    }
+
+    // The last worker out closes the next stage's input
+    if (stage.active_workers.fetch_sub(1) == 1) {
+        output.close();
+    }
+}
+
+int64_t Pipeline::submit(std::any item) {
+    Queue& input = *queues_.front();
+    if (input.closed()) {
+        return -1;
+    }
+    Item entry{next_sequence_.fetch_add(1), std::move(item)};
+    int64_t sequence = entry.sequence;
+    return push(input, entry, nullptr) ? sequence : -1;
+}
+
+int64_t Pipeline::try_submit(std::any item) {
+    Queue& input = *queues_.front();
+    if (input.closed()) {
+        return -1;
+    }
+    Item entry{next_sequence_.fetch_add(1), std::move(item)};
+    int64_t sequence = entry.sequence;
+    return input.try_push(entry) ? sequence : -1;
+}
+
+bool Pipeline::next(std::any* item, int64_t* sequence) {
+    Item entry;
+    if (!pop(*queues_.back(), entry, nullptr)) {
+        return false;
+    }
+    if (sequence != nullptr) {
+        *sequence = entry.sequence;
+    }
+    *item = std::move(entry.value);
+    return true;
+}
+
+void Pipeline::close() {
+    queues_.front()->close();
+}
+
+void Pipeline::stop() {
+    close();
+    cancelled_.store(true);
+    for (std::thread& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    threads_.clear();
+}
+
+std::vector<StageStats> Pipeline::stats() const {
+    double elapsed_ms = started_ ? elapsed_ns(start_time_) / 1e6 : 0.0;
+
+    std::vector<StageStats> result;
+    for (size_t i = 0; i < stages_.size(); i++) {
+        const Stage& stage = *stages_[i];
+        StageStats entry;
+        entry.name = stage.name;
+        entry.num_workers = static_cast<int>(stage.fns.size());
+        entry.items = stage.items.load(std::memory_order_relaxed);
+        entry.dropped = stage.dropped.load(std::memory_order_relaxed);
+        entry.errors = stage.errors.load(std::memory_order_relaxed);
+        entry.busy_ms = stage.busy_ns.load(std::memory_order_relaxed) / 1e6;
+        entry.starved_ms = stage.starved_ns.load(std::memory_order_relaxed) / 1e6;
+        entry.blocked_ms = stage.blocked_ns.load(std::memory_order_relaxed) / 1e6;
+        entry.mean_ms = entry.items > 0 ? entry.busy_ms / entry.items : 0.0;
+        entry.utilization = elapsed_ms > 0.0 ? entry.busy_ms / (elapsed_ms * entry.num_workers) : 0.0;
+        entry.queue_depth = queues_[i]->size();
+        entry.queue_capacity = queues_[i]->capacity();
+        result.push_back(entry);
+    }
+    return result;
+}
+
+std::string Pipeline::first_error() const {
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    return first_error_;
+}
+
+size_t Pipeline::num_stages() const {
+    return stages_.size();
+}
+
+} // namespace tvm_sdk
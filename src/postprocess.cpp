@@ -0,0 +1,357 @@
+#include "postprocess.h"
+#include "ffi/inference_session.h"
+#include "python_hook.h"
+#include <pybind11/embed.h>
+#include <pybind11/stl.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+namespace tvm_sdk {
+
+namespace {
+
+// Independent accumulators per reduction, so the loops vectorize without -ffast-math
+constexpr size_t kLanes = 8;
+
+/**
+ * @brief exp(x) for x in float range: 2^n * p(r), branch-free (Cephes expf coefficients)
+ */
+inline float exp_approx(float input) {
+    float x = std::min(std::max(input, -87.3f), 88.3f);
+    float fx = x * 1.44269504088896341f;
+    int32_t n = static_cast<int32_t>(fx + (fx >= 0.0f ? 0.5f : -0.5f));
+    float fn = static_cast<float>(n);
+    float r = x - fn * 0.693359375f + fn * 2.12194440e-4f;
+
+    float y = 1.9875691500e-4f;
+    y = y * r + 1.3981999507e-3f;
+    y = y * r + 8.3334519073e-3f;
+    y = y * r + 4.1665795894e-2f;
+    y = y * r + 1.6666665459e-1f;
+    y = y * r + 5.0000001201e-1f;
+    y = y * r * r + r + 1.0f;
+
+    int32_t bits = (n + 127) << 23;
+    float scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    // Underflow flushes to zero (a select, not a branch)
+    return input < -87.3f ? 0.0f : y * scale;
+}
+
+float row_max(const float* x, size_t n) {
+    float lanes[kLanes];
+    for (size_t l = 0; l < kLanes; l++) {
+        lanes[l] = x[0];
+    }
+    size_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        for (size_t l = 0; l < kLanes; l++) {
+            lanes[l] = x[i + l] > lanes[l] ? x[i + l] : lanes[l];
+        }
+    }
+    float result = lanes[0];
+    for (size_t l = 1; l < kLanes; l++) {
+        result = lanes[l] > result ? lanes[l] : result;
+    }
+    for (; i < n; i++) {
+        result = x[i] > result ? x[i] : result;
+    }
+    return result;
+}
+
+/**
+ * @brief sum(exp(x - max)), optionally storing the terms
+ */
+float exp_sum(const float* x, float max, float* terms, size_t n) {
+    float lanes[kLanes] = {};
+    size_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        for (size_t l = 0; l < kLanes; l++) {
+            float e = exp_approx(x[i + l] - max);
+            if (terms != nullptr) {
+                terms[i + l] = e;
+            }
+            lanes[l] += e;
+        }
+    }
+    float sum = 0.0f;
+    for (size_t l = 0; l < kLanes; l++) {
+        sum += lanes[l];
+    }
+    for (; i < n; i++) {
+        float e = exp_approx(x[i] - max);
+        if (terms != nullptr) {
+            terms[i] = e;
+        }
+        sum += e;
+    }
+    return sum;
+}
+
+// Min-heap order on (score, class id): the root is the weakest selected entry
+inline bool weaker(const Prediction& a, const Prediction& b) {
+    return a.score < b.score || (a.score == b.score && a.class_id > b.class_id);
+}
+
+void sift_down(Prediction* heap, size_t size, size_t pos) {
+    for (;;) {
+        size_t child = 2 * pos + 1;
+        if (child >= size) {
+            return;
+        }
+        if (child + 1 < size && weaker(heap[child + 1], heap[child])) {
+            child++;
+        }
+        if (!weaker(heap[child], heap[pos])) {
+            return;
+        }
+        std::swap(heap[child], heap[pos]);
+        pos = child;
+    }
+}
+
+void row_top_k(const float* x, size_t n, size_t k, Prediction* out) {
+    // Seed with the first k entries, then only scores beating the root enter
+    for (size_t i = 0; i < k; i++) {
+        out[i].class_id = static_cast<int64_t>(i);
+        out[i].score = x[i];
+    }
+    for (size_t i = k / 2; i-- > 0;) {
+        sift_down(out, k, i);
+    }
+    for (size_t i = k; i < n; i++) {
+        if (x[i] > out[0].score) {
+            out[0].class_id = static_cast<int64_t>(i);
+            out[0].score = x[i];
+            sift_down(out, k, 0);
+        }
+    }
+    std::sort(out, out + k, [](const Prediction& a, const Prediction& b) { return weaker(b, a); });
+}
+
+void check_k(size_t k, size_t num_classes) {
+    if (k == 0 || k > num_classes) {
+        throw std::invalid_argument(
+            "top-k needs 0 < k <= num_classes (k=" + std::to_string(k) +
+            ", num_classes=" + std::to_string(num_classes) + ")");
+    }
+}
+
+void check_num_classes(size_t num_classes) {
+    if (num_classes == 0) {
+        throw std::invalid_argument("softmax needs num_classes > 0");
+    }
+}
+
+} // namespace
+
+void Postprocess::softmax(const float* logits, float* probs, size_t batch, size_t num_classes) {
+    check_num_classes(num_classes);
+    for (size_t b = 0; b < batch; b++) {
+        const float* x = logits + b * num_classes;
+        float* y = probs + b * num_classes;
+        float max = row_max(x, num_classes);
+        float inv_sum = 1.0f / exp_sum(x, max, y, num_classes);
+        for (size_t i = 0; i < num_classes; i++) {
+            y[i] *= inv_sum;
+        }
+    }
+}
+
+void Postprocess::log_softmax(const float* logits, float* out, size_t batch, size_t num_classes) {
+    check_num_classes(num_classes);
+    for (size_t b = 0; b < batch; b++) {
+        const float* x = logits + b * num_classes;
+        float* y = out + b * num_classes;
+        float max = row_max(x, num_classes);
+        float shift = max + std::log(exp_sum(x, max, nullptr, num_classes));
+        for (size_t i = 0; i < num_classes; i++) {
+            y[i] = x[i] - shift;
+        }
+    }
+}
+
+void Postprocess::top_k(const float* scores, size_t batch, size_t num_classes, size_t k, Prediction* out) {
+    check_k(k, num_classes);
+    for (size_t b = 0; b < batch; b++) {
+        row_top_k(scores + b * num_classes, num_classes, k, out + b * k);
+    }
+}
+
+void Postprocess::classify(const float* logits, size_t batch, size_t num_classes, size_t k, Prediction* out) {
+    check_k(k, num_classes);
+    for (size_t b = 0; b < batch; b++) {
+        const float* x = logits + b * num_classes;
+        Prediction* row = out + b * k;
+
+        // Softmax is monotonic: select on logits, then normalize only the winners
+        row_top_k(x, num_classes, k, row);
+        float max = row[0].score;
+        float inv_sum = 1.0f / exp_sum(x, max, nullptr, num_classes);
+        for (size_t i = 0; i < k; i++) {
+            row[i].score = exp_approx(row[i].score - max) * inv_sum;
+        }
+    }
+}
+
+std::vector<std::vector<Prediction>> Postprocess::classify(
+    const float* logits, size_t batch, size_t num_classes, size_t k) {
+    std::vector<Prediction> flat(batch * k);
+    classify(logits, batch, num_classes, k, flat.data());
+
+    std::vector<std::vector<Prediction>> rows(batch);
+    for (size_t b = 0; b < batch; b++) {
+        rows[b].assign(flat.begin() + b * k, flat.begin() + (b + 1) * k);
+    }
+    return rows;
+}
+
+std::vector<std::vector<Prediction>> Postprocess::classify(const ffi::TensorBuffer& logits, size_t k) {
+    const auto& shape = logits.shape();
+    if (logits.dtype() != "float32" || shape.empty() || shape.size() > 2) {
+        throw std::invalid_argument("classify expects float32 [batch, num_classes] logits");
+    }
+    size_t num_classes = static_cast<size_t>(shape.back());
+    size_t batch = shape.size() == 2 ? static_cast<size_t>(shape[0]) : 1;
+    return classify(logits.data_as<float>(), batch, num_classes, k);
+}
+
+LabelMap::LabelMap(std::vector<std::string> labels) : labels_(std::move(labels)) {}
+
+LabelMap LabelMap::from_file(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Failed to open label file: " + path);
+    }
+    std::vector<std::string> labels;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        labels.push_back(line);
+    }
+    return LabelMap(std::move(labels));
+}
+
+const LabelMap& LabelMap::imagenet() {
+    static const LabelMap labels = [] {
+        py::object result = PythonHook::call_function("tvm_ext.postprocess", "imagenet_labels");
+        py::gil_scoped_acquire gil;
+        return LabelMap(py::cast<std::vector<std::string>>(result));
+    }();
+    return labels;
+}
+
+const std::string& LabelMap::operator[](int64_t class_id) const {
+    static const std::string empty;
+    if (class_id < 0 || static_cast<size_t>(class_id) >= labels_.size()) {
+        return empty;
+    }
+    return labels_[static_cast<size_t>(class_id)];
+}
+
+namespace {
+
+/**
+ * @brief Contiguous float32 rows viewed through the Python buffer protocol
+ */
+struct BufferRows {
+    float* data;
+    size_t batch;
+    size_t num_classes;
+};
+
+BufferRows buffer_rows(const py::buffer_info& info) {
+    if (info.format != py::format_descriptor<float>::format() || info.itemsize != sizeof(float)) {
+        throw std::invalid_argument("Expected float32 logits");
+    }
+    if (info.ndim != 1 && info.ndim != 2) {
+        throw std::invalid_argument("Expected logits of shape [num_classes] or [batch, num_classes]");
+    }
+    size_t num_classes = static_cast<size_t>(info.shape.back());
+    size_t batch = info.ndim == 2 ? static_cast<size_t>(info.shape[0]) : 1;
+    bool contiguous = info.strides.back() == static_cast<py::ssize_t>(sizeof(float)) &&
+        (info.ndim == 1 || info.strides[0] == static_cast<py::ssize_t>(num_classes * sizeof(float)));
+    if (!contiguous || num_classes == 0) {
+        throw std::invalid_argument("Expected non-empty, C-contiguous logits");
+    }
+    return {static_cast<float*>(info.ptr), batch, num_classes};
+}
+
+py::list predictions_to_list(const std::vector<Prediction>& flat, size_t batch, size_t k) {
+    py::list rows;
+    for (size_t b = 0; b < batch; b++) {
+        py::list row;
+        for (size_t i = 0; i < k; i++) {
+            const Prediction& p = flat[b * k + i];
+            row.append(py::make_tuple(p.class_id, p.score));
+        }
+        rows.append(row);
+    }
+    return rows;
+}
+
+template<typename Fn>
+void apply_rowwise(py::buffer logits, py::buffer out, Fn fn) {
+    py::buffer_info in_info = logits.request();
+    py::buffer_info out_info = out.request(true);
+    BufferRows in_rows = buffer_rows(in_info);
+    BufferRows out_rows = buffer_rows(out_info);
+    if (in_rows.batch != out_rows.batch || in_rows.num_classes != out_rows.num_classes) {
+        throw std::invalid_argument("Output shape must match logits");
+    }
+    py::gil_scoped_release release;
+    fn(in_rows.data, out_rows.data, in_rows.batch, in_rows.num_classes);
+}
+
+template<typename Fn>
+py::list select_rowwise(py::buffer scores, size_t k, Fn fn) {
+    py::buffer_info info = scores.request();
+    BufferRows rows = buffer_rows(info);
+    std::vector<Prediction> flat(rows.batch * k);
+    {
+        py::gil_scoped_release release;
+        fn(rows.data, rows.batch, rows.num_classes, k, flat.data());
+    }
+    return predictions_to_list(flat, rows.batch, k);
+}
+
+} // namespace
+
+} // namespace tvm_sdk
+
+// Native postprocessing for tvm_ext.postprocess (buffer protocol, no numpy headers)
+PYBIND11_EMBEDDED_MODULE(_tvm_sdk_postprocess, m) {
+    using tvm_sdk::Postprocess;
+
+    m.def("softmax", [](py::buffer logits, py::buffer out) {
+        tvm_sdk::apply_rowwise(logits, out, [](const float* x, float* y, size_t batch, size_t n) {
+            Postprocess::softmax(x, y, batch, n);
+        });
+    }, py::arg("logits"), py::arg("out"));
+
+    m.def("log_softmax", [](py::buffer logits, py::buffer out) {
+        tvm_sdk::apply_rowwise(logits, out, [](const float* x, float* y, size_t batch, size_t n) {
+            Postprocess::log_softmax(x, y, batch, n);
+        });
+    }, py::arg("logits"), py::arg("out"));
+
+    m.def("top_k", [](py::buffer scores, size_t k) {
+        return tvm_sdk::select_rowwise(scores, k,
+            [](const float* x, size_t batch, size_t n, size_t kk, tvm_sdk::Prediction* out) {
+                Postprocess::top_k(x, batch, n, kk, out);
+            });
+    }, py::arg("scores"), py::arg("k"));
+
+    m.def("classify", [](py::buffer logits, size_t k) {
+        return tvm_sdk::select_rowwise(logits, k,
+            [](const float* x, size_t batch, size_t n, size_t kk, tvm_sdk::Prediction* out) {
+                Postprocess::classify(x, batch, n, kk, out);
+            });
+    }, py::arg("logits"), py::arg("k"));
+}
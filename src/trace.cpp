@@ -0,0 +1,290 @@
+#include "trace.h"
+#include "python_hook.h"
+#include <pybind11/embed.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <unistd.h>
+
+namespace tvm_sdk {
+
+namespace {
+
+constexpr size_t kNameSize = 96;
+constexpr size_t kCategorySize = 16;
+
+struct TraceEvent {
+    char name[kNameSize];
+    char category[kCategorySize];
+    double start_us;
+    double dur_us;
+};
+
+/**
+ * Event slot guarded by a sequence number: odd while the owning thread
+ * writes it, 2 * index + 2 once event number `index` is complete. Readers
+ * copy the event and keep it only if the sequence did not change.
+ */
+struct TraceSlot {
+    std::atomic<uint64_t> seq{0};
+    TraceEvent event;
+};
+
+/**
+ * Single-producer event buffer owned by one thread.
+ */
+struct ThreadBuffer {
+    ThreadBuffer(size_t capacity, bool ring, uint64_t tid)
+        : slots(new TraceSlot[capacity]), capacity(capacity), ring(ring), tid(tid) {}
+
+    std::unique_ptr<TraceSlot[]> slots;
+    size_t capacity;
+    bool ring;
+    uint64_t tid;
+    std::atomic<uint64_t> head{0};
+    std::atomic<uint64_t> dropped{0};
+};
+
+struct TraceRegistry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    TraceConfig config;
+    bool python_hook_installed = false;
+};
+
+TraceRegistry& registry() {
+    static TraceRegistry instance;
+    return instance;
+}
+
+const std::chrono::steady_clock::time_point g_origin = std::chrono::steady_clock::now();
+std::atomic<uint64_t> g_generation{1};
+std::atomic<uint32_t> g_sample_every{1};
+std::atomic<uint64_t> g_next_tid{1};
+
+struct ThreadState {
+    std::shared_ptr<ThreadBuffer> buffer;
+    uint64_t generation = 0;
+    uint64_t tid = 0;
+    uint32_t sample_counter = 0;
+};
+
+thread_local ThreadState t_state;
+
+ThreadBuffer* local_buffer() {
+    uint64_t generation = g_generation.load(std::memory_order_acquire);
+    if (t_state.generation != generation) {
+        if (t_state.tid == 0) {
+            t_state.tid = g_next_tid.fetch_add(1, std::memory_order_relaxed);
+        }
+        TraceRegistry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        t_state.buffer = std::make_shared<ThreadBuffer>(
+            std::max<size_t>(1, reg.config.buffer_capacity), reg.config.ring_buffer, t_state.tid);
+        reg.buffers.push_back(t_state.buffer);
+        t_state.generation = generation;
+    }
+    return t_state.buffer.get();
+}
+
+void copy_truncated(char* dst, size_t size, size_t offset, const char* src) {
+    if (src == nullptr || offset + 1 >= size) {
+        return;
+    }
+    size_t n = std::min(std::strlen(src), size - 1 - offset);
+    std::memcpy(dst + offset, src, n);
+    dst[offset + n] = '\0';
+}
+
+void write_json_string(std::ostringstream& out, const char* value) {
+    out << '"';
+    for (const char* c = value; *c != '\0'; ++c) {
+        switch (*c) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20) {
+                    out << ' ';
+                } else {
+                    out << *c;
+                }
+        }
+    }
+    out << '"';
+}
+
+size_t write_events(std::ostringstream& out) {
+    TraceRegistry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    long pid = static_cast<long>(getpid());
+    uint64_t dropped = 0;
+    size_t count = 0;
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\"traceEvents\": [";
+    for (const auto& buffer : reg.buffers) {
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t begin = head > buffer->capacity ? head - buffer->capacity : 0;
+        for (uint64_t index = begin; index < head; ++index) {
+            const TraceSlot& slot = buffer->slots[index % buffer->capacity];
+            uint64_t seq = slot.seq.load(std::memory_order_acquire);
+            if (seq != 2 * index + 2) {
+                continue;
+            }
+            TraceEvent event = slot.event;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) != seq) {
+                continue;
+            }
+
+            out << (count == 0 ? "\n" : ",\n") << "  {\"name\": ";
+            write_json_string(out, event.name);
+            out << ", \"cat\": ";
+            write_json_string(out, event.category);
+            out << ", \"ph\": \"X\", \"ts\": " << event.start_us
+                << ", \"dur\": " << event.dur_us
+                << ", \"pid\": " << pid
+                << ", \"tid\": " << buffer->tid << "}";
+            ++count;
+        }
+    }
+    out << "\n], \"displayTimeUnit\": \"ms\", \"otherData\": {\"dropped_events\": " << dropped << "}}\n";
+    return count;
+}
+
+} // namespace
+
+std::atomic<bool> Tracer::enabled_{false};
+
+void Tracer::start(const TraceConfig& config) {
+    bool install_python = false;
+    {
+        TraceRegistry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.config = config;
+        reg.buffers.clear();
+        g_sample_every.store(std::max<uint32_t>(1, config.sample_every), std::memory_order_relaxed);
+        // Threads allocate a fresh buffer on their next event
+        g_generation.fetch_add(1, std::memory_order_acq_rel);
+        install_python = config.trace_python && !reg.python_hook_installed;
+        reg.python_hook_installed = reg.python_hook_installed || install_python;
+    }
+    enabled_.store(true, std::memory_order_release);
+
+    if (install_python) {
+        PythonHook::call_function("tvm_ext.tracing", "install_profile_hook");
+    }
+}
+
+void Tracer::stop() {
+    enabled_.store(false, std::memory_order_release);
+
+    bool uninstall_python = false;
+    {
+        TraceRegistry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        uninstall_python = reg.python_hook_installed;
+        reg.python_hook_installed = false;
+    }
+    if (uninstall_python && PythonHook::is_initialized()) {
+        PythonHook::call_function("tvm_ext.tracing", "uninstall_profile_hook");
+    }
+}
+
+double Tracer::now_us() {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - g_origin).count();
+}
+
+bool Tracer::sample() {
+    uint32_t every = g_sample_every.load(std::memory_order_relaxed);
+    if (every <= 1) {
+        return true;
+    }
+    return t_state.sample_counter++ % every == 0;
+}
+
+void Tracer::record(const char* category, const char* name, const char* detail,
+                    double start_us, double dur_us) {
+    if (!is_enabled()) {
+        return;
+    }
+
+    ThreadBuffer* buffer = local_buffer();
+    uint64_t index = buffer->head.load(std::memory_order_relaxed);
+    if (!buffer->ring && index >= buffer->capacity) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    TraceSlot& slot = buffer->slots[index % buffer->capacity];
+    slot.seq.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    TraceEvent& event = slot.event;
+    event.name[0] = '\0';
+    copy_truncated(event.name, kNameSize, 0, name);
+    if (detail != nullptr) {
+        size_t length = std::strlen(event.name);
+        copy_truncated(event.name, kNameSize, length, ".");
+        copy_truncated(event.name, kNameSize, length + 1, detail);
+    }
+    event.category[0] = '\0';
+    copy_truncated(event.category, kCategorySize, 0, category);
+    event.start_us = start_us;
+    event.dur_us = dur_us;
+
+    slot.seq.store(2 * index + 2, std::memory_order_release);
+    buffer->head.store(index + 1, std::memory_order_release);
+}
+
+std::string Tracer::to_json() {
+    std::ostringstream out;
+    write_events(out);
+    return out.str();
+}
+
+size_t Tracer::flush(const std::string& path) {
+    std::ostringstream out;
+    size_t count = write_events(out);
+
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Failed to open trace file: " + path);
+    }
+    file << out.str();
+    return count;
+}
+
+uint64_t Tracer::dropped_events() {
+    TraceRegistry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    uint64_t dropped = 0;
+    for (const auto& buffer : reg.buffers) {
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+} // namespace tvm_sdk
+
+// Python-side hook: tvm_ext.tracing records into the same per-thread buffers
+PYBIND11_EMBEDDED_MODULE(_tvm_sdk_trace, m) {
+    m.def("enabled", &tvm_sdk::Tracer::is_enabled);
+    m.def("sample", &tvm_sdk::Tracer::sample);
+    m.def("now_us", &tvm_sdk::Tracer::now_us);
+    m.def("record", [](const std::string& category, const std::string& name, double start_us, double dur_us) {
+        tvm_sdk::Tracer::record(category.c_str(), name.c_str(), start_us, dur_us);
+    });
+}
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "ffi/inference_session.h"
+#include "ffi/tvm_ffi.h"
+#include "python_hook.h"
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tvm_sdk::ffi;
+using namespace tvm_sdk;
+
+// Count heap allocations of the whole process while counting is enabled.
+// The executable's malloc family interposes the one of glibc for every
+// shared library, including libpython and the libtvm loaded by Python;
+// operator new allocates through malloc.
+namespace {
+
+std::atomic<bool> g_count_allocations{false};
+std::atomic<uint64_t> g_num_allocations{0};
+
+void count_allocation() {
+    if (g_count_allocations.load(std::memory_order_relaxed)) {
+        g_num_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace
+
+extern "C" {
+
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+
+void* malloc(size_t size) noexcept {
+    count_allocation();
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept {
+    count_allocation();
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) noexcept {
+    count_allocation();
+    return __libc_realloc(ptr, size);
+}
+
+void* memalign(size_t alignment, size_t size) noexcept {
+    count_allocation();
+    return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept {
+    count_allocation();
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size) noexcept {
+    count_allocation();
+    *ptr = __libc_memalign(alignment, size);
+    return *ptr == nullptr ? ENOMEM : 0;
+}
+
+} // extern "C"
+
+// Test fixture for InferenceSession tests
+class InferenceSessionTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        g_count_allocations = false;
+    }
+};
+
+// Test: TensorBuffer memory is aligned for zero-copy use by the TVM runtime
+TEST_F(InferenceSessionTest, TensorBufferAlignment) {
+    TensorBuffer buffer({1, 3, 224, 224}, "float32");
+    EXPECT_EQ(buffer.num_elements(), 1 * 3 * 224 * 224);
+    EXPECT_EQ(buffer.nbytes(), buffer.num_elements() * sizeof(float));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer.data()) % TensorBuffer::kAlignment, 0u);
+
+    TensorBuffer int8_buffer({7}, "int8");
+    EXPECT_EQ(int8_buffer.nbytes(), 7u);
+
+    EXPECT_THROW(TensorBuffer({2}, "float"), std::invalid_argument);
+}
+
+// Test: released buffers are reused without new allocations
+TEST_F(InferenceSessionTest, TensorBufferPoolReuse) {
+    TensorBufferPool pool;
+    auto first = pool.acquire({128, 128});
+    void* first_data = first->data();
+    pool.release(std::move(first));
+
+    auto second = pool.acquire({128, 128});
+    EXPECT_EQ(second->data(), first_data);
+    EXPECT_EQ(pool.num_allocated(), 1u);
+
+    auto other = pool.acquire({64}, "int32");
+    EXPECT_NE(other->data(), first_data);
+    EXPECT_EQ(pool.num_allocated(), 2u);
+}
+
+// Test: steady-state inference writes results in place without heap allocations
+TEST_F(InferenceSessionTest, ZeroAllocationSteadyState) {
+    py::object result = PythonHook::call_function("tvm_ext", "create_simple_relax_ir");
+    std::string relax_ir = PythonHook::to_cpp<std::string>(result);
+
+    CompileOptions options;
+    options.destination_passing = true;
+    auto compile_result = TVMFFI::compile_with_metaschedule(
+        relax_ir, "llvm", false, 0, 0, "test_inference_db", 0, options);
+    ASSERT_EQ(compile_result["status"], "success") << compile_result["error"];
+
+    TensorBuffer a({128, 128});
+    TensorBuffer b({128, 128});
+    TensorBuffer out({128, 128});
+    for (int i = 0; i < 128; i++) {
+        a.data_as<float>()[i * 128 + i] = 1.0f;
+    }
+    for (int64_t i = 0; i < b.num_elements(); i++) {
+        b.data_as<float>()[i] = static_cast<float>(i % 17);
+    }
+
+    InferenceSession session(compile_result["lib_path"]);
+    session.bind({&a, &b}, {&out});
+    session.warmup(5);
+
+    g_num_allocations = 0;
+    g_count_allocations = true;
+    for (int i = 0; i < 100; i++) {
+        session.run();
+    }
+    g_count_allocations = false;
+    EXPECT_EQ(g_num_allocations.load(), 0u);
+
+    // identity(A) x B == B, written into the bound output buffer
+    for (int64_t i = 0; i < out.num_elements(); i++) {
+        ASSERT_FLOAT_EQ(out.data_as<float>()[i], b.data_as<float>()[i]);
+    }
+}
+
+// Test: pool instances share one copy of the weights and run concurrently
+TEST_F(InferenceSessionTest, ExecutorPoolSharesWeights) {
+    py::object result = PythonHook::call_function("tvm_ext", "create_simple_relax_ir", true);
+    std::string relax_ir = PythonHook::to_cpp<std::string>(result);
+
+    auto export_result = TVMFFI::export_with_params_as_input(relax_ir, "llvm", "test_shared_weights");
+    ASSERT_EQ(export_result["status"], "success") << export_result["error"];
+    EXPECT_EQ(export_result["num_params"], "1");
+    EXPECT_EQ(export_result["param_bytes"], std::to_string(128 * 128 * 4));
+
+    ExecutorPool pool("test_shared_weights", 2);
+
+    TensorBuffer x({128, 128});
+    for (int64_t i = 0; i < x.num_elements(); i++) {
+        x.data_as<float>()[i] = static_cast<float>(i % 5) * 0.25f;
+    }
+    TensorBuffer reference({128, 128});
+    pool.run({&x}, {&reference});
+
+    constexpr int kNumThreads = 4;
+    std::vector<std::unique_ptr<TensorBuffer>> outputs;
+    for (int t = 0; t < kNumThreads; t++) {
+        outputs.push_back(std::make_unique<TensorBuffer>(std::vector<int64_t>{128, 128}));
+    }
+    {
+        py::gil_scoped_release release;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kNumThreads; t++) {
+            threads.emplace_back([&pool, &x, &outputs, t]() {
+                for (int i = 0; i < 5; i++) {
+                    pool.run({&x}, {outputs[t].get()});
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    for (const auto& output : outputs) {
+        for (int64_t i = 0; i < output->num_elements(); i++) {
+            ASSERT_FLOAT_EQ(output->data_as<float>()[i], reference.data_as<float>()[i]);
+        }
+    }
+
+    auto stats = pool.stats();
+    EXPECT_EQ(stats["num_instances"], "2");
+    EXPECT_EQ(stats["param_bytes"], std::to_string(128 * 128 * 4));
+    EXPECT_EQ(stats["num_runs"], std::to_string(1 + kNumThreads * 5));
+}
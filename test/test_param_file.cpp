@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "ffi/param_file.h"
+#include "ffi/inference_session.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace tvm_sdk::ffi;
+using ::testing::ElementsAre;
+
+// Test fixture for ParamFile tests
+class ParamFileTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        std::remove(path_.c_str());
+    }
+
+    std::string path_ = "test_param_file.tsdk";
+};
+
+// Test: CRC32 matches zlib.crc32
+TEST_F(ParamFileTest, Crc32MatchesZlib) {
+    const char* text = "123456789";
+    EXPECT_EQ(crc32(text, std::strlen(text)), 0xCBF43926u);
+    EXPECT_EQ(crc32(text, 0), 0u);
+}
+
+// Test: saved tensors map back with their names, dtypes, shapes and data
+TEST_F(ParamFileTest, SaveAndMapRoundTrip) {
+    TensorBuffer weight({4, 3}, "float32");
+    TensorBuffer bias({4}, "float32");
+    TensorBuffer index({5}, "int8");
+    for (int i = 0; i < 12; i++) {
+        weight.data_as<float>()[i] = 0.5f * i;
+    }
+    for (int i = 0; i < 4; i++) {
+        bias.data_as<float>()[i] = -1.0f * i;
+    }
+    for (int i = 0; i < 5; i++) {
+        index.data_as<int8_t>()[i] = static_cast<int8_t>(i - 2);
+    }
+
+    ParamFile::save(path_, {{"fc.weight", &weight}, {"fc.bias", &bias}, {"index", &index}});
+
+    ParamFile file(path_, true);
+    ASSERT_EQ(file.entries().size(), 3u);
+    EXPECT_TRUE(file.has_checksums());
+    EXPECT_EQ(file.entries()[0].name, "fc.weight");
+    EXPECT_EQ(file.entries()[2].name, "index");
+
+    const ParamEntry* w = file.find("fc.weight");
+    ASSERT_NE(w, nullptr);
+    EXPECT_EQ(w->dtype, "float32");
+    EXPECT_THAT(w->shape, ElementsAre(4, 3));
+    EXPECT_EQ(w->nbytes, weight.nbytes());
+    EXPECT_EQ(std::memcmp(w->data, weight.data(), weight.nbytes()), 0);
+
+    const ParamEntry* i8 = file.find("index");
+    ASSERT_NE(i8, nullptr);
+    EXPECT_EQ(i8->dtype, "int8");
+    EXPECT_EQ(static_cast<const int8_t*>(i8->data)[0], -2);
+
+    EXPECT_EQ(file.find("missing"), nullptr);
+    EXPECT_TRUE(file.verify().empty());
+}
+
+// Test: the data section is page-aligned and every tensor is 64-byte aligned
+TEST_F(ParamFileTest, TensorsAreAligned) {
+    TensorBuffer a({3}, "int8");
+    TensorBuffer b({17}, "float32");
+    TensorBuffer c({2, 2}, "float64");
+    ParamFile::save(path_, {{"a", &a}, {"b", &b}, {"c", &c}});
+
+    ParamFile file(path_);
+    EXPECT_EQ(file.entries().front().offset % ParamFile::kDataAlignment, 0u);
+    for (const ParamEntry& entry : file.entries()) {
+        EXPECT_EQ(entry.offset % ParamFile::kTensorAlignment, 0u) << entry.name;
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(entry.data) % ParamFile::kTensorAlignment, 0u) << entry.name;
+    }
+}
+
+// Test: corrupted tensor data is reported by its checksum
+TEST_F(ParamFileTest, DetectsCorruption) {
+    TensorBuffer weight({16}, "float32");
+    weight.data_as<float>()[3] = 1.0f;
+    ParamFile::save(path_, {{"weight", &weight}});
+
+    uint64_t offset = 0;
+    {
+        ParamFile file(path_);
+        offset = file.find("weight")->offset;
+    }
+    {
+        std::fstream stream(path_, std::ios::in | std::ios::out | std::ios::binary);
+        stream.seekp(static_cast<std::streamoff>(offset + 12));
+        stream.put('\x7f');
+    }
+
+    ParamFile unchecked(path_);
+    EXPECT_THAT(unchecked.verify(), ElementsAre("weight"));
+    EXPECT_THROW(ParamFile(path_, true), std::runtime_error);
+}
+
+// Test: files without checksums skip verification
+TEST_F(ParamFileTest, ChecksumsOptional) {
+    TensorBuffer weight({8}, "float32");
+    ParamFile::save(path_, {{"weight", &weight}}, false);
+
+    ParamFile file(path_, true);
+    EXPECT_FALSE(file.has_checksums());
+    EXPECT_EQ(file.entries()[0].crc32, 0u);
+    EXPECT_TRUE(file.verify().empty());
+}
+
+// Test: invalid files are rejected
+TEST_F(ParamFileTest, RejectsInvalidFiles) {
+    EXPECT_THROW(ParamFile("does_not_exist.tsdk"), std::runtime_error);
+
+    {
+        std::ofstream out(path_, std::ios::binary);
+        out << std::string(128, 'x');
+    }
+    EXPECT_THROW(ParamFile file(path_), std::runtime_error);
+}
+
+// Test: header and index values that do not fit the file are rejected before use
+TEST_F(ParamFileTest, RejectsCorruptIndex) {
+    TensorBuffer weight({16}, "float32");
+    auto corrupt = [&](std::streamoff pos, uint64_t value) {
+        ParamFile::save(path_, {{"weight", &weight}});
+        std::fstream stream(path_, std::ios::in | std::ios::out | std::ios::binary);
+        stream.seekp(pos);
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    // Index entry: name "weight", dtype "float32", ndim 1, one dim, then the offset
+    const std::streamoff offset_pos = 64 + (4 + 6) + (4 + 7) + 4 + 8;
+
+    corrupt(16, uint64_t{1} << 60);     // num_tensors
+    EXPECT_THROW(ParamFile file(path_), std::runtime_error);
+
+    corrupt(40, 100);                   // data_offset not page aligned
+    EXPECT_THROW(ParamFile file(path_), std::runtime_error);
+
+    corrupt(offset_pos, 64);            // tensor inside the header
+    EXPECT_THROW(ParamFile file(path_), std::runtime_error);
+
+    corrupt(offset_pos, ParamFile::kDataAlignment + 4);     // misaligned tensor
+    EXPECT_THROW(ParamFile file(path_), std::runtime_error);
+
+    corrupt(offset_pos, ParamFile::kDataAlignment);         // intact layout
+    EXPECT_NO_THROW(ParamFile file(path_));
+}
@@ -0,0 +1,310 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "pipeline.h"
+#include "python_hook.h"
+#include <pybind11/eval.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tvm_sdk;
+
+namespace {
+
+void sleep_ms(int ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+std::vector<int64_t> drain(Pipeline& pipeline) {
+    std::vector<int64_t> values;
+    std::any item;
+    while (pipeline.next(&item)) {
+        values.push_back(std::any_cast<int64_t>(item));
+    }
+    return values;
+}
+
+} // namespace
+
+// Test: the queue holds at most its capacity and hands items out in FIFO order
+TEST(BoundedQueueTest, CapacityAndOrder) {
+    BoundedQueue<int> queue(3);
+    EXPECT_EQ(queue.capacity(), 4u);
+
+    for (int i = 0; i < 4; i++) {
+        int value = i;
+        EXPECT_TRUE(queue.try_push(value));
+    }
+    int overflow = 99;
+    EXPECT_FALSE(queue.try_push(overflow));
+    EXPECT_EQ(overflow, 99);
+    EXPECT_EQ(queue.size(), 4u);
+
+    for (int i = 0; i < 4; i++) {
+        int value = -1;
+        ASSERT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    int value = -1;
+    EXPECT_FALSE(queue.try_pop(value));
+}
+
+// Test: concurrent producers and consumers see every item exactly once
+TEST(BoundedQueueTest, MultiProducerMultiConsumer) {
+    BoundedQueue<int> queue(64);
+    constexpr int kProducers = 4;
+    constexpr int kItemsPerProducer = 20000;
+
+    std::atomic<int64_t> sum{0};
+    std::atomic<int> consumed{0};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kProducers; p++) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < kItemsPerProducer; i++) {
+                int value = p * kItemsPerProducer + i;
+                while (!queue.try_push(value)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < 4; c++) {
+        threads.emplace_back([&] {
+            int value = 0;
+            while (consumed.load() < kProducers * kItemsPerProducer) {
+                if (queue.try_pop(value)) {
+                    sum += value;
+                    consumed++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const int64_t n = kProducers * kItemsPerProducer;
+    EXPECT_EQ(consumed.load(), n);
+    EXPECT_EQ(sum.load(), n * (n - 1) / 2);
+}
+
+// Test: items flow through all stages in order with single-worker stages
+TEST(PipelineTest, ProcessesAllItemsInOrder) {
+    Pipeline pipeline(4);
+    pipeline.add_stage("double", [](std::any item) -> std::any {
+        return std::any_cast<int64_t>(item) * 2;
+    });
+    pipeline.add_stage("increment", [](std::any item) -> std::any {
+        return std::any_cast<int64_t>(item) + 1;
+    });
+    pipeline.start();
+
+    std::thread feeder([&] {
+        for (int64_t i = 0; i < 100; i++) {
+            EXPECT_EQ(pipeline.submit(i), i);
+        }
+        pipeline.close();
+    });
+    std::vector<int64_t> values = drain(pipeline);
+    feeder.join();
+
+    ASSERT_EQ(values.size(), 100u);
+    for (int64_t i = 0; i < 100; i++) {
+        EXPECT_EQ(values[i], 2 * i + 1);
+    }
+
+    auto stats = pipeline.stats();
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_EQ(stats[0].name, "double");
+    EXPECT_EQ(stats[0].items, 100u);
+    EXPECT_EQ(stats[1].items, 100u);
+    EXPECT_EQ(stats[1].dropped, 0u);
+}
+
+// Test: empty results drop items and exceptions are counted, not fatal
+TEST(PipelineTest, FiltersAndErrors) {
+    Pipeline pipeline(4);
+    pipeline.add_stage("filter", [](std::any item) -> std::any {
+        int64_t value = std::any_cast<int64_t>(item);
+        if (value % 5 == 4) {
+            throw std::runtime_error("bad item");
+        }
+        return value % 2 == 0 ? std::any(value) : std::any();
+    });
+    pipeline.start();
+
+    std::thread feeder([&] {
+        for (int64_t i = 0; i < 20; i++) {
+            pipeline.submit(i);
+        }
+        pipeline.close();
+    });
+    std::vector<int64_t> values = drain(pipeline);
+    feeder.join();
+
+    EXPECT_THAT(values, ::testing::ElementsAre(0, 2, 6, 8, 10, 12, 16, 18));
+    auto stats = pipeline.stats();
+    EXPECT_EQ(stats[0].items, 20u);
+    EXPECT_EQ(stats[0].errors, 4u);
+    EXPECT_EQ(stats[0].dropped, 12u);
+    EXPECT_THAT(pipeline.first_error(), ::testing::HasSubstr("bad item"));
+}
+
+// Test: a slow stage blocks upstream stages instead of letting queues grow
+TEST(PipelineTest, BackPressure) {
+    constexpr size_t kCapacity = 2;
+    Pipeline pipeline(kCapacity);
+    pipeline.add_stage("fast", [](std::any item) -> std::any { return item; });
+    pipeline.add_stage("slow", [](std::any item) -> std::any {
+        sleep_ms(5);
+        return item;
+    });
+    pipeline.start();
+
+    std::atomic<int> submitted{0};
+    std::thread feeder([&] {
+        for (int64_t i = 0; i < 40; i++) {
+            pipeline.submit(i);
+            submitted++;
+        }
+        pipeline.close();
+    });
+
+    // Nothing is consumed yet: at most the queues and one item per worker are in flight
+    sleep_ms(100);
+    const int in_flight_limit = 3 * static_cast<int>(kCapacity) + 2;
+    EXPECT_LE(submitted.load(), in_flight_limit);
+    for (const auto& stage : pipeline.stats()) {
+        EXPECT_LE(stage.queue_depth, stage.queue_capacity);
+    }
+
+    std::vector<int64_t> values = drain(pipeline);
+    feeder.join();
+    EXPECT_EQ(values.size(), 40u);
+
+    auto stats = pipeline.stats();
+    EXPECT_GT(stats[0].blocked_ms, 0.0);
+    EXPECT_GT(stats[1].utilization, stats[0].utilization);
+}
+
+// Test: throughput approaches the slowest stage, not the sum of all stages
+TEST(PipelineTest, OverlapsStages) {
+    constexpr int kItems = 40;
+    constexpr int kStageMs = 5;
+    Pipeline pipeline(4);
+    for (const char* name : {"decode", "infer", "postprocess"}) {
+        pipeline.add_stage(name, [](std::any item) -> std::any {
+            sleep_ms(kStageMs);
+            return item;
+        });
+    }
+    pipeline.start();
+
+    auto begin = std::chrono::steady_clock::now();
+    std::thread feeder([&] {
+        for (int64_t i = 0; i < kItems; i++) {
+            pipeline.submit(i);
+        }
+        pipeline.close();
+    });
+    std::vector<int64_t> values = drain(pipeline);
+    feeder.join();
+    double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    EXPECT_EQ(values.size(), static_cast<size_t>(kItems));
+    // Sequential execution would take 3 * kItems * kStageMs
+    EXPECT_LT(elapsed_ms, 2.0 * kItems * kStageMs);
+    for (const auto& stage : pipeline.stats()) {
+        EXPECT_GT(stage.utilization, 0.5) << stage.name;
+    }
+}
+
+// Test: a stage with several workers scales and keeps every item
+TEST(PipelineTest, WorkerPoolStage) {
+    Pipeline pipeline(8);
+    pipeline.add_stage("slow", [](std::any item) -> std::any {
+        sleep_ms(2);
+        return item;
+    }, 4);
+    pipeline.start();
+
+    std::thread feeder([&] {
+        for (int64_t i = 0; i < 64; i++) {
+            pipeline.submit(i);
+        }
+        pipeline.close();
+    });
+    std::vector<int64_t> values;
+    std::vector<int64_t> sequences;
+    std::any item;
+    int64_t sequence = -1;
+    while (pipeline.next(&item, &sequence)) {
+        values.push_back(std::any_cast<int64_t>(item));
+        sequences.push_back(sequence);
+    }
+    feeder.join();
+
+    EXPECT_EQ(values, sequences);
+    std::sort(values.begin(), values.end());
+    ASSERT_EQ(values.size(), 64u);
+    for (int64_t i = 0; i < 64; i++) {
+        EXPECT_EQ(values[i], i);
+    }
+    EXPECT_EQ(pipeline.stats()[0].num_workers, 4);
+}
+
+// Test: stopping a pipeline whose output is never read does not hang
+TEST(PipelineTest, StopWithUnreadOutput) {
+    Pipeline pipeline(2);
+    pipeline.add_stage("identity", [](std::any item) -> std::any { return item; });
+    pipeline.start();
+    for (int64_t i = 0; i < 4; i++) {
+        pipeline.try_submit(i);
+    }
+    sleep_ms(20);
+    pipeline.stop();
+    EXPECT_EQ(pipeline.submit(int64_t{1}), -1);
+}
+
+// Test: Python stages compose with native ones
+TEST(PipelineTest, PythonStage) {
+    PythonHook::initialize();
+    py::object square;
+    {
+        py::gil_scoped_acquire gil;
+        square = py::eval("lambda x: x * x");
+    }
+
+    Pipeline pipeline(4);
+    pipeline.add_python_stage("square", square, 2);
+    pipeline.add_stage("to_native", [](std::any item) -> std::any {
+        py::gil_scoped_acquire gil;
+        return py::cast<int64_t>(*std::any_cast<PyItem>(item));
+    });
+
+    std::vector<int64_t> values;
+    {
+        py::gil_scoped_release release;
+        pipeline.start();
+        std::thread feeder([&] {
+            for (int64_t i = 0; i < 10; i++) {
+                pipeline.submit(i);
+            }
+            pipeline.close();
+        });
+        values = drain(pipeline);
+        feeder.join();
+        pipeline.stop();
+    }
+
+    std::sort(values.begin(), values.end());
+    EXPECT_THAT(values, ::testing::ElementsAre(0, 1, 4, 9, 16, 25, 36, 49, 64, 81));
+
+    py::gil_scoped_acquire gil;
+    square = py::object();
+}
@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "postprocess.h"
+#include "ffi/inference_session.h"
+#include "python_hook.h"
+#include <pybind11/eval.h>
+#include <pybind11/stl.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace tvm_sdk;
+
+namespace {
+
+std::vector<float> random_logits(size_t batch, size_t num_classes, float scale, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> dist(0.0f, scale);
+    std::vector<float> logits(batch * num_classes);
+    for (float& x : logits) {
+        x = dist(rng);
+    }
+    return logits;
+}
+
+std::vector<double> reference_softmax(const float* x, size_t n) {
+    double max = *std::max_element(x, x + n);
+    std::vector<double> y(n);
+    double sum = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        y[i] = std::exp(static_cast<double>(x[i]) - max);
+        sum += y[i];
+    }
+    for (double& v : y) {
+        v /= sum;
+    }
+    return y;
+}
+
+std::vector<int64_t> reference_top_k(const float* x, size_t n, size_t k) {
+    std::vector<int64_t> ids(n);
+    std::iota(ids.begin(), ids.end(), 0);
+    std::stable_sort(ids.begin(), ids.end(), [x](int64_t a, int64_t b) { return x[a] > x[b]; });
+    ids.resize(k);
+    return ids;
+}
+
+} // namespace
+
+// Test: softmax matches a double-precision reference and rows sum to one
+TEST(PostprocessTest, SoftmaxMatchesReference) {
+    constexpr size_t kBatch = 4;
+    constexpr size_t kClasses = 1000;
+    std::vector<float> logits = random_logits(kBatch, kClasses, 4.0f, 1);
+    std::vector<float> probs(logits.size());
+    Postprocess::softmax(logits.data(), probs.data(), kBatch, kClasses);
+
+    for (size_t b = 0; b < kBatch; b++) {
+        std::vector<double> expected = reference_softmax(&logits[b * kClasses], kClasses);
+        double sum = 0.0;
+        for (size_t i = 0; i < kClasses; i++) {
+            float p = probs[b * kClasses + i];
+            EXPECT_NEAR(p, expected[i], 2e-6 * expected[i] + 1e-12) << "row " << b << " class " << i;
+            sum += p;
+        }
+        EXPECT_NEAR(sum, 1.0, 1e-5);
+    }
+}
+
+// Test: large logits do not overflow and odd row lengths are handled
+TEST(PostprocessTest, SoftmaxIsStable) {
+    std::vector<float> logits = {1000.0f, 999.0f, -1000.0f, 0.0f, 1000.0f};
+    std::vector<float> probs(logits.size());
+    Postprocess::softmax(logits.data(), probs.data(), 1, logits.size());
+
+    std::vector<double> expected = reference_softmax(logits.data(), logits.size());
+    for (size_t i = 0; i < logits.size(); i++) {
+        EXPECT_TRUE(std::isfinite(probs[i]));
+        EXPECT_NEAR(probs[i], expected[i], 1e-6);
+    }
+    EXPECT_EQ(probs[2], 0.0f);
+
+    // In place
+    Postprocess::softmax(logits.data(), logits.data(), 1, logits.size());
+    EXPECT_EQ(logits, probs);
+}
+
+// Test: log-softmax equals log of the reference softmax
+TEST(PostprocessTest, LogSoftmax) {
+    constexpr size_t kClasses = 37;
+    std::vector<float> logits = random_logits(2, kClasses, 10.0f, 2);
+    std::vector<float> out(logits.size());
+    Postprocess::log_softmax(logits.data(), out.data(), 2, kClasses);
+
+    for (size_t b = 0; b < 2; b++) {
+        std::vector<double> expected = reference_softmax(&logits[b * kClasses], kClasses);
+        for (size_t i = 0; i < kClasses; i++) {
+            EXPECT_NEAR(out[b * kClasses + i], std::log(expected[i]), 1e-4);
+        }
+    }
+}
+
+// Test: top-k agrees with a full stable sort, including ties
+TEST(PostprocessTest, TopKMatchesSort) {
+    constexpr size_t kBatch = 3;
+    constexpr size_t kClasses = 1000;
+    std::vector<float> scores = random_logits(kBatch, kClasses, 1.0f, 3);
+    // Quantize to force ties
+    for (float& x : scores) {
+        x = std::round(x * 4.0f) / 4.0f;
+    }
+
+    for (size_t k : {size_t{1}, size_t{5}, size_t{64}, kClasses}) {
+        std::vector<Prediction> out(kBatch * k);
+        Postprocess::top_k(scores.data(), kBatch, kClasses, k, out.data());
+        for (size_t b = 0; b < kBatch; b++) {
+            std::vector<int64_t> expected = reference_top_k(&scores[b * kClasses], kClasses, k);
+            for (size_t i = 0; i < k; i++) {
+                EXPECT_EQ(out[b * k + i].class_id, expected[i]) << "k=" << k << " row " << b << " rank " << i;
+                EXPECT_EQ(out[b * k + i].score, scores[b * kClasses + expected[i]]);
+            }
+        }
+    }
+}
+
+// Test: invalid k is rejected
+TEST(PostprocessTest, TopKRejectsInvalidK) {
+    std::vector<float> scores(10, 0.0f);
+    std::vector<Prediction> out(11);
+    EXPECT_THROW(Postprocess::top_k(scores.data(), 1, 10, 0, out.data()), std::invalid_argument);
+    EXPECT_THROW(Postprocess::top_k(scores.data(), 1, 10, 11, out.data()), std::invalid_argument);
+}
+
+// Test: softmax of rows without classes is rejected instead of reading past the input
+TEST(PostprocessTest, SoftmaxRejectsEmptyRows) {
+    std::vector<float> logits(1, 0.0f);
+    std::vector<float> out(1, 0.0f);
+    EXPECT_THROW(Postprocess::softmax(logits.data(), out.data(), 1, 0), std::invalid_argument);
+    EXPECT_THROW(Postprocess::log_softmax(logits.data(), out.data(), 1, 0), std::invalid_argument);
+}
+
+// Test: classify returns the top softmax probabilities
+TEST(PostprocessTest, ClassifyMatchesSoftmax) {
+    constexpr size_t kBatch = 2;
+    constexpr size_t kClasses = 1000;
+    std::vector<float> logits = random_logits(kBatch, kClasses, 3.0f, 4);
+    std::vector<float> probs(logits.size());
+    Postprocess::softmax(logits.data(), probs.data(), kBatch, kClasses);
+
+    auto rows = Postprocess::classify(logits.data(), kBatch, kClasses, 5);
+    ASSERT_EQ(rows.size(), kBatch);
+    for (size_t b = 0; b < kBatch; b++) {
+        std::vector<int64_t> expected = reference_top_k(&probs[b * kClasses], kClasses, 5);
+        ASSERT_EQ(rows[b].size(), 5u);
+        for (size_t i = 0; i < 5; i++) {
+            EXPECT_EQ(rows[b][i].class_id, expected[i]);
+            EXPECT_NEAR(rows[b][i].score, probs[b * kClasses + expected[i]], 1e-6);
+        }
+    }
+}
+
+// Test: classify reads a TensorBuffer and checks its dtype
+TEST(PostprocessTest, ClassifyTensorBuffer) {
+    ffi::TensorBuffer logits({1, 10});
+    float* data = logits.data_as<float>();
+    for (int i = 0; i < 10; i++) {
+        data[i] = static_cast<float>(i % 7);
+    }
+    auto rows = Postprocess::classify(logits, 2);
+    ASSERT_EQ(rows.size(), 1u);
+    EXPECT_EQ(rows[0][0].class_id, 6);
+    EXPECT_EQ(rows[0][1].class_id, 5);
+
+    ffi::TensorBuffer ints({10}, "int32");
+    EXPECT_THROW(Postprocess::classify(ints, 1), std::invalid_argument);
+}
+
+// Test: labels load from a file and out-of-range ids map to ""
+TEST(PostprocessTest, LabelMapFromFile) {
+    std::string path = ::testing::TempDir() + "labels.txt";
+    {
+        std::ofstream out(path);
+        out << "tench\r\ngoldfish\ngreat white shark\n";
+    }
+    LabelMap labels = LabelMap::from_file(path);
+    std::remove(path.c_str());
+
+    ASSERT_EQ(labels.size(), 3u);
+    EXPECT_EQ(labels[0], "tench");
+    EXPECT_EQ(labels[2], "great white shark");
+    EXPECT_EQ(labels[3], "");
+    EXPECT_EQ(labels[-1], "");
+    EXPECT_THROW(LabelMap::from_file(path), std::runtime_error);
+}
+
+// Test: the embedded module works on Python buffers
+TEST(PostprocessTest, EmbeddedModule) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+    py::dict scope;
+    py::exec(R"(
+import array
+import _tvm_sdk_postprocess as native
+logits = memoryview(array.array('f', [1.0, 3.0, 2.0, 0.5])).cast('B').cast('f', (2, 2))
+out = array.array('f', [0.0] * 4)
+native.softmax(logits, memoryview(out).cast('B').cast('f', (2, 2)))
+top = native.classify(logits, 1)
+)", scope);
+
+    auto out = py::cast<std::vector<float>>(py::list(scope["out"]));
+    EXPECT_NEAR(out[0] + out[1], 1.0f, 1e-6f);
+    EXPECT_GT(out[1], out[0]);
+    EXPECT_GT(out[2], out[3]);
+
+    auto top = py::cast<std::vector<std::vector<std::pair<int64_t, float>>>>(scope["top"]);
+    ASSERT_EQ(top.size(), 2u);
+    EXPECT_EQ(top[0][0].first, 1);
+    EXPECT_EQ(top[1][0].first, 0);
+    EXPECT_NEAR(top[0][0].second, out[1], 1e-6f);
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "trace.h"
+#include "python_hook.h"
+#include <pybind11/eval.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tvm_sdk;
+using ::testing::ContainsRegex;
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+namespace {
+
+size_t count_occurrences(const std::string& text, const std::string& pattern) {
+    size_t count = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+        count++;
+    }
+    return count;
+}
+
+} // namespace
+
+// Test fixture for Tracer tests
+class TracerTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        Tracer::stop();
+    }
+};
+
+// Test: scopes are not recorded while tracing is stopped
+TEST_F(TracerTest, IdleRecordsNothing) {
+    Tracer::start();
+    Tracer::stop();
+    {
+        TVM_SDK_TRACE_SCOPE("idle_scope");
+    }
+    EXPECT_THAT(Tracer::to_json(), Not(HasSubstr("idle_scope")));
+}
+
+// Test: every thread records into its own buffer
+TEST_F(TracerTest, MultiThreadedScopes) {
+    Tracer::start();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([]() {
+            for (int i = 0; i < 100; i++) {
+                TraceScope scope("sdk", "worker", "step");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::string json = Tracer::to_json();
+    EXPECT_EQ(count_occurrences(json, "\"name\": \"worker.step\""), 400u);
+    EXPECT_EQ(Tracer::dropped_events(), 0u);
+}
+
+// Test: ring buffer keeps the most recent events, bounded mode drops new ones
+TEST_F(TracerTest, RingBufferKeepsLatestEvents) {
+    TraceConfig config;
+    config.buffer_capacity = 8;
+    config.ring_buffer = true;
+    Tracer::start(config);
+    for (int i = 0; i < 20; i++) {
+        Tracer::record("sdk", ("event_" + std::to_string(i)).c_str(), Tracer::now_us(), 1.0);
+    }
+    std::string json = Tracer::to_json();
+    EXPECT_EQ(count_occurrences(json, "\"ph\": \"X\""), 8u);
+    EXPECT_THAT(json, HasSubstr("\"event_19\""));
+    EXPECT_THAT(json, Not(HasSubstr("\"event_11\"")));
+
+    config.ring_buffer = false;
+    Tracer::start(config);
+    for (int i = 0; i < 20; i++) {
+        Tracer::record("sdk", ("event_" + std::to_string(i)).c_str(), Tracer::now_us(), 1.0);
+    }
+    json = Tracer::to_json();
+    EXPECT_EQ(count_occurrences(json, "\"ph\": \"X\""), 8u);
+    EXPECT_THAT(json, HasSubstr("\"event_0\""));
+    EXPECT_EQ(Tracer::dropped_events(), 12u);
+}
+
+// Test: sampling records one of every N scopes
+TEST_F(TracerTest, SamplingReducesEvents) {
+    TraceConfig config;
+    config.sample_every = 10;
+    Tracer::start(config);
+    for (int i = 0; i < 100; i++) {
+        TVM_SDK_TRACE_SCOPE("sampled");
+    }
+    EXPECT_EQ(count_occurrences(Tracer::to_json(), "\"name\": \"sampled\""), 10u);
+}
+
+// Test: PythonHook calls, GIL waits and Python-side events share one timeline
+TEST_F(TracerTest, PythonEventsShareTimeline) {
+    Tracer::start();
+
+    py::object result = PythonHook::call_function("math", "sqrt", 16.0);
+    EXPECT_DOUBLE_EQ(PythonHook::to_cpp<double>(result), 4.0);
+
+    {
+        py::gil_scoped_acquire gil;
+        py::exec(R"(
+import _tvm_sdk_trace
+start = _tvm_sdk_trace.now_us()
+_tvm_sdk_trace.record("python", "python_side", start, 5.0)
+)");
+    }
+
+    const std::string trace_path = (std::filesystem::temp_directory_path() / "test_trace.json").string();
+    EXPECT_GE(Tracer::flush(trace_path), 3u);
+
+    std::ifstream trace(trace_path);
+    std::string content((std::istreambuf_iterator<char>(trace)), std::istreambuf_iterator<char>());
+    trace.close();
+    std::remove(trace_path.c_str());
+    EXPECT_THAT(content, ContainsRegex("^\\{\"traceEvents\": \\["));
+    EXPECT_THAT(content, HasSubstr("\"name\": \"math.sqrt\", \"cat\": \"python\""));
+    EXPECT_THAT(content, HasSubstr("\"name\": \"gil_wait\", \"cat\": \"python_hook\""));
+    EXPECT_THAT(content, HasSubstr("\"name\": \"python_side\""));
+}
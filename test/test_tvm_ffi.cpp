@@ -2,8 +2,11 @@
 #include <gmock/gmock.h>
 #include "ffi/tvm_ffi.h"
 #include "python_hook.h"
+#include <pybind11/stl.h>
 #include <string>
 #include <map>
+#include <fstream>
+#include <filesystem>
 
 using namespace tvm_sdk::ffi;
 using namespace tvm_sdk;
@@ -61,4 +64,354 @@ TEST_F(TVMFFITest, CreateSimpleRelaxIR) {
     py::object result = PythonHook::call_function("tvm_ext", "create_simple_relax_ir");
     std::string relax_ir = PythonHook::to_cpp<std::string>(result);
     EXPECT_THAT(relax_ir, Not(IsEmpty()));
-}
\ No newline at end of file
+}
+
+// Test: profile_relax_module should return a per-operator table
+TEST_F(TVMFFITest, ProfileRelaxModule) {
+    py::object result = PythonHook::call_function("tvm_ext", "create_simple_relax_ir");
+    std::string relax_ir = PythonHook::to_cpp<std::string>(result);
+
+    ProfileReport report = TVMFFI::profile_relax_module(relax_ir, "llvm", "test_profile_db", false, 2);
+    ASSERT_EQ(report.status, "success") << report.error;
+    EXPECT_GT(report.e2e_time_us, 0.0);
+    ASSERT_THAT(report.operators, Not(IsEmpty()));
+
+    bool found_matmul = false;
+    for (const auto& op : report.operators) {
+        EXPECT_GE(op.call_count, 1);
+        if (op.name == "matmul") {
+            found_matmul = true;
+            EXPECT_GT(op.flops, 0.0);
+        }
+    }
+    EXPECT_TRUE(found_matmul);
+
+    std::cout << report.to_csv();
+}
+
+// Test: ProfileReport CSV/JSON export
+TEST_F(TVMFFITest, ProfileReportExport) {
+    ProfileReport report;
+    report.status = "success";
+    report.target = "llvm";
+    report.e2e_time_us = 100.0;
+
+    OperatorProfile op;
+    op.name = "fused_conv2d_add_relu";
+    op.call_count = 2;
+    op.total_us = 50.0;
+    op.mean_us = 25.0;
+    op.share = 0.5;
+    report.operators.push_back(op);
+
+    std::string csv = report.to_csv();
+    EXPECT_THAT(csv, ContainsRegex("^name,call_count,total_us"));
+    EXPECT_THAT(csv, ContainsRegex("fused_conv2d_add_relu,2,50,25,0.5"));
+
+    std::string json = report.to_json();
+    EXPECT_THAT(json, ContainsRegex("\"e2e_time_us\": 100"));
+    EXPECT_THAT(json, ContainsRegex("\"name\": \"fused_conv2d_add_relu\""));
+}
+
+// Test: detect_host_cpu should return a fully specified LLVM target
+TEST_F(TVMFFITest, DetectHostCPU) {
+    auto cpu_info = TVMFFI::detect_host_cpu();
+
+    EXPECT_THAT(cpu_info["arch"], Not(IsEmpty()));
+    EXPECT_THAT(cpu_info["target"], ContainsRegex("^llvm "));
+    EXPECT_THAT(cpu_info["target"], ContainsRegex("-num-cores [0-9]+"));
+    if (!cpu_info["mcpu"].empty()) {
+        EXPECT_THAT(cpu_info["target"], ContainsRegex("-mcpu=" + cpu_info["mcpu"]));
+    }
+
+    for (const auto& [key, value] : cpu_info) {
+        std::cout << "  " << key << ": " << value << std::endl;
+    }
+}
+
+// Test: tune_incremental should skip tasks that already met their trial target
+TEST_F(TVMFFITest, TuneIncrementalSkipsTunedTasks) {
+    py::object result = PythonHook::call_function("tvm_ext", "create_simple_relax_ir");
+    std::string relax_ir = PythonHook::to_cpp<std::string>(result);
+    std::string work_dir = "test_incremental_db";
+
+    auto first = TVMFFI::tune_incremental(relax_ir, "llvm", 2, 2, 2, work_dir);
+    ASSERT_EQ(first["status"], "success") << first["error"];
+
+    auto second = TVMFFI::tune_incremental(relax_ir, "llvm", 2, 2, 2, work_dir);
+    ASSERT_EQ(second["status"], "success") << second["error"];
+    EXPECT_EQ(second["skipped_tasks"], "1");
+    EXPECT_EQ(second["new_records"], "0");
+}
+
+// Test: merge and compact tuning databases by workload hash
+TEST_F(TVMFFITest, MergeAndCompactTuningDatabases) {
+    namespace fs = std::filesystem;
+    fs::remove_all("test_merge_db");
+
+    auto write_db = [](const std::string& dir, const std::string& workloads, const std::string& records) {
+        fs::create_directories(dir);
+        std::ofstream(dir + "/database_workload.json") << workloads;
+        std::ofstream(dir + "/database_tuning_record.json") << records;
+    };
+
+    write_db("test_merge_db/a",
+             "[\"111\",\"m1\"]\n[\"222\",\"m2\"]\n",
+             "[0,[[\"t1\"],[0.001],{},[]]]\n[1,[[\"t2\"],[10000000000.0],{},[]]]\n");
+    write_db("test_merge_db/b",
+             "[\"111\",\"m1\"]\n",
+             "[0,[[\"t1\"],[0.001],{},[]]]\n[0,[[\"t3\"],[0.0005],{},[]]]\n");
+
+    auto merged = TVMFFI::merge_tuning_databases(
+        {"test_merge_db/a", "test_merge_db/b"}, "test_merge_db/merged");
+    ASSERT_EQ(merged["status"], "success") << merged["error"];
+    EXPECT_EQ(merged["num_workloads"], "2");
+    EXPECT_EQ(merged["output_records"], "3");
+
+    auto compacted = TVMFFI::compact_tuning_database("test_merge_db/merged", 1);
+    ASSERT_EQ(compacted["status"], "success") << compacted["error"];
+    EXPECT_EQ(compacted["output_records"], "1");
+
+    auto stats = TVMFFI::get_workload_stats("test_merge_db/merged");
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_EQ(stats[0].shash, "111");
+    EXPECT_EQ(stats[0].num_records, 1);
+    EXPECT_DOUBLE_EQ(stats[0].best_latency_us, 500.0);
+    EXPECT_EQ(stats[1].num_valid, 0);
+
+    auto db_info = TVMFFI::check_tuning_database("test_merge_db/merged");
+    EXPECT_EQ(db_info["num_workloads"], "2");
+    EXPECT_EQ(db_info["num_records"], "1");
+}
+
+// Test: allocate_trials should split the budget by latency share
+TEST_F(TVMFFITest, AllocateTrialsByLatencyShare) {
+    PythonHook::initialize();
+    py::dict weights;
+    weights["fused_conv2d_add_relu"] = 70.0;
+    weights["fused_matmul_add"] = 29.0;
+    weights["add"] = 1.0;
+
+    py::object result = PythonHook::call_function("tvm_ext", "allocate_trials", weights, 64, 2);
+    auto allocation = PythonHook::to_cpp<std::map<std::string, int>>(result);
+
+    EXPECT_EQ(allocation["fused_conv2d_add_relu"] + allocation["fused_matmul_add"] + allocation["add"], 64);
+    EXPECT_GT(allocation["fused_conv2d_add_relu"], allocation["fused_matmul_add"]);
+    EXPECT_EQ(allocation["add"], 2);
+}
+
+// Test: tune_with_metaschedule with a TuningConfig (random model baseline, early stopping)
+TEST_F(TVMFFITest, TuneWithTuningConfig) {
+    py::object result = PythonHook::call_function("tvm_ext", "create_simple_relax_ir");
+    std::string relax_ir = PythonHook::to_cpp<std::string>(result);
+
+    TuningConfig config;
+    config.num_trials = 4;
+    config.num_trials_per_iter = 2;
+    config.max_workers = 2;
+    config.seed = 0;
+    config.cost_model = CostModelKind::Random;
+    config.evolutionary.population_size = 16;
+    config.mutator_probs = {{"tile_size", 0.9}, {"unroll", 0.1}};
+    config.early_stopping.patience = 2;
+
+    auto tune_result = TVMFFI::tune_with_metaschedule(relax_ir, "llvm", config, "test_config_db");
+    ASSERT_EQ(tune_result["status"], "success") << tune_result["error"];
+    EXPECT_EQ(tune_result["cost_model"], "random");
+    EXPECT_EQ(tune_result["search_strategy"], "evolutionary");
+}
+
+// Test: adaptive measurement stores repeats with confidence intervals that apply can rank by
+TEST_F(TVMFFITest, TuneWithAdaptiveMeasurement) {
+    py::object result = PythonHook::call_function("tvm_ext", "create_simple_relax_ir");
+    std::string relax_ir = PythonHook::to_cpp<std::string>(result);
+
+    TuningConfig config;
+    config.num_trials = 6;
+    config.num_trials_per_iter = 3;
+    config.max_workers = 2;
+    config.seed = 0;
+    config.cost_model = CostModelKind::Random;
+    config.evolutionary.population_size = 16;
+    config.measurement.mode = MeasurementMode::Adaptive;
+    config.measurement.min_repeats = 3;
+    config.measurement.max_repeats = 9;
+    config.measurement.min_repeat_ms = 5;
+
+    auto tune_result = TVMFFI::tune_with_metaschedule(relax_ir, "llvm", config, "test_adaptive_db");
+    ASSERT_EQ(tune_result["status"], "success") << tune_result["error"];
+    EXPECT_EQ(tune_result["measurement"], "adaptive");
+    EXPECT_GT(std::stoi(tune_result["measurement_measured"]), 0);
+    EXPECT_GE(std::stod(tune_result["measurement_mean_repeats"]), 3.0);
+    EXPECT_LE(std::stod(tune_result["measurement_mean_repeats"]), 9.0);
+
+    bool has_interval = false;
+    for (const auto& workload : TVMFFI::get_workload_stats("test_adaptive_db")) {
+        has_interval = has_interval || workload.best_ci_us >= 0.0;
+    }
+    EXPECT_TRUE(has_interval);
+
+    auto build_result = TVMFFI::apply_tuning_database(
+        relax_ir, "llvm", "test_adaptive_db", 0, nullptr, "", "upper_ci");
+    ASSERT_EQ(build_result["status"], "success") << build_result["error"];
+    EXPECT_EQ(build_result["rank_by"], "upper_ci");
+    EXPECT_GT(std::stoi(build_result["num_with_interval"]), 0);
+}
+
+// Test: compile_with_metaschedule should report per-phase timings and a Chrome trace
+TEST_F(TVMFFITest, CompilePhaseTimings) {
+    py::object result = PythonHook::call_function("tvm_ext", "create_simple_relax_ir");
+    std::string relax_ir = PythonHook::to_cpp<std::string>(result);
+
+    std::string trace_path = "test_timing_db/compile_trace.json";
+    PipelineTimings timings;
+    CompileOptions options;
+    options.timings = &timings;
+    options.trace_path = trace_path;
+    auto compile_result = TVMFFI::compile_with_metaschedule(
+        relax_ir, "llvm", false, 0, 0, "test_timing_db", 0, options);
+    ASSERT_EQ(compile_result["status"], "success") << compile_result["error"];
+    EXPECT_EQ(compile_result.count("phases"), 0u);
+
+    std::vector<std::string> names;
+    for (const auto& phase : timings.phases) {
+        names.push_back(phase.name);
+        EXPECT_GE(phase.wall_ms, 0.0);
+        EXPECT_GE(phase.cpu_ms, 0.0);
+    }
+    EXPECT_THAT(names, ::testing::ElementsAre("parse_ir", "zero_pipeline", "relax_build", "export_library"));
+    ASSERT_EQ(timings.passes.size(), 5u);
+    EXPECT_EQ(timings.passes.front().name, "legalize");
+    EXPECT_EQ(timings.passes.front().primfuncs_before, 0);
+    EXPECT_GT(timings.passes.front().primfuncs_after, 0);
+    EXPECT_GT(timings.num_tasks, 0);
+    EXPECT_GT(timings.peak_rss_kb, 0);
+    EXPECT_GT(timings.total_wall_ms, 0.0);
+
+    ASSERT_EQ(timings.trace_path, trace_path);
+    std::ifstream trace(trace_path);
+    std::string content((std::istreambuf_iterator<char>(trace)), std::istreambuf_iterator<char>());
+    EXPECT_THAT(content, ContainsRegex("\"traceEvents\""));
+    EXPECT_THAT(content, ContainsRegex("\"name\": \"relax_build\""));
+}
+
+// Test: configure_runtime should size -num-cores and TVM_NUM_THREADS to the configured pool
+TEST_F(TVMFFITest, ConfigureRuntimeThreadPool) {
+    auto topology = TVMFFI::get_cpu_topology();
+    EXPECT_GE(std::stoi(topology["num_numa_nodes"]), 1);
+    EXPECT_THAT(topology["numa_node_0"], Not(IsEmpty()));
+
+    RuntimeConfig config;
+    config.num_threads = 1;
+    config.cpus = {0};
+    config.wait_policy = WaitPolicy::Sleep;
+    auto applied = TVMFFI::configure_runtime(config);
+    ASSERT_EQ(applied["status"], "success") << applied["error"];
+    EXPECT_EQ(applied["num_threads"], "1");
+    EXPECT_EQ(applied["spin_count"], "0");
+    EXPECT_THAT(TVMFFI::detect_host_cpu()["target"], ContainsRegex("-num-cores 1$"));
+
+    config.core_mode = CoreMode::Little;
+    config.cpus.clear();
+    config.numa_node = 1 << 20;
+    EXPECT_EQ(TVMFFI::configure_runtime(config)["status"], "error");
+
+    TVMFFI::reset_runtime();
+}
+
+// Test: benchmark_thread_scaling should report one result per thread count and placement
+TEST_F(TVMFFITest, BenchmarkThreadScaling) {
+    py::object result = PythonHook::call_function("tvm_ext", "create_simple_relax_ir");
+    std::string relax_ir = PythonHook::to_cpp<std::string>(result);
+
+    auto report = TVMFFI::benchmark_thread_scaling(relax_ir, "llvm", {1, 2}, 3);
+    ASSERT_EQ(report.status, "success") << report.error;
+    ASSERT_FALSE(report.results.empty());
+    EXPECT_EQ(report.results.front().num_threads, 1);
+    EXPECT_DOUBLE_EQ(report.results.front().speedup, 1.0);
+    for (const auto& entry : report.results) {
+        EXPECT_GT(entry.mean_ms, 0.0);
+        EXPECT_GE(entry.numa_nodes_used, 1);
+        std::cout << "  " << entry.placement << " x" << entry.num_threads
+                  << ": " << entry.mean_ms << " ms (speedup " << entry.speedup << ")" << std::endl;
+    }
+}
+
+// Test: compare_relax_pipelines should time each pass and give equal outputs for presets and custom lists
+TEST_F(TVMFFITest, CompareRelaxPipelines) {
+    py::object result = PythonHook::call_function("tvm_ext", "create_simple_relax_ir");
+    std::string relax_ir = PythonHook::to_cpp<std::string>(result);
+
+    auto presets = TVMFFI::get_relax_pipeline_presets();
+    ASSERT_EQ(presets.count("zero"), 1u);
+    EXPECT_THAT(presets["zero"], ::testing::ElementsAre("legalize", "annotate_op_pattern", "fold_constant", "fuse_ops", "fuse_tir"));
+
+    RelaxPipelineConfig minimal;
+    minimal.preset = "minimal";
+    RelaxPipelineConfig full;
+    full.preset = "full";
+    RelaxPipelineConfig custom;
+    custom.passes = {"cse", "legalize", "dead_code_elimination"};
+    RelaxPipelineConfig unknown;
+    unknown.passes = {"no_such_pass"};
+
+    auto comparison = TVMFFI::compare_relax_pipelines(relax_ir, "llvm", {minimal, full, custom}, 3);
+    ASSERT_EQ(comparison.status, "success") << comparison.error;
+    ASSERT_EQ(comparison.results.size(), 3u);
+    for (const auto& report : comparison.results) {
+        ASSERT_EQ(report.status, "success") << report.pipeline << ": " << report.error;
+        EXPECT_EQ(report.pass_reports.size(), report.passes.size());
+        EXPECT_GT(report.mean_ms, 0.0);
+        EXPECT_LT(report.max_rel_error, 1e-5) << report.pipeline;
+        std::cout << "  " << report.pipeline << ": " << report.pipeline_ms << " ms passes, "
+                  << report.build_ms << " ms build, " << report.mean_ms << " ms run, "
+                  << report.num_primfuncs << " PrimFuncs" << std::endl;
+    }
+    EXPECT_EQ(comparison.results[2].pipeline, "custom");
+    EXPECT_EQ(comparison.results[2].pass_reports[1].name, "legalize");
+    EXPECT_GT(comparison.results[2].pass_reports[1].tir_nodes_after, 0);
+
+    EXPECT_EQ(TVMFFI::compare_relax_pipelines(relax_ir, "llvm", {unknown}, 1).status, "error");
+}
+
+// Test: memory_plan_report should account for the output and match the VM's allocations
+TEST_F(TVMFFITest, MemoryPlanReport) {
+    py::object result = PythonHook::call_function("tvm_ext", "create_simple_relax_ir");
+    std::string relax_ir = PythonHook::to_cpp<std::string>(result);
+
+    auto report = TVMFFI::memory_plan_report(relax_ir, "llvm", {}, true);
+    ASSERT_EQ(report.status, "success") << report.error;
+    EXPECT_EQ(report.function, "main");
+
+    // The only tensor is the 128x128 float32 output, which the runtime allocates
+    EXPECT_EQ(report.num_unplanned_tensors, 1);
+    EXPECT_EQ(report.unplanned_bytes, 128 * 128 * 4);
+    EXPECT_EQ(report.peak_live_bytes, 128 * 128 * 4);
+    EXPECT_EQ(report.num_dynamic_allocations, 0);
+    EXPECT_LE(report.peak_live_bytes, report.planned_bytes + report.unplanned_bytes);
+
+    ASSERT_TRUE(report.runtime_checked);
+    EXPECT_TRUE(report.within_plan) << report.runtime_storage_bytes << " bytes allocated";
+    EXPECT_GT(report.runtime_ms, 0.0);
+}
+
+// Test: partition_cores should give each RPC server its own cores and leave the rest to builders
+TEST_F(TVMFFITest, PartitionCores) {
+    PythonHook::initialize();
+    py::gil_scoped_acquire gil;
+
+    const std::vector<int> cores = {0, 1, 2, 3, 4, 5, 6};
+    auto parts = py::cast<py::tuple>(PythonHook::call_function("tvm_ext", "partition_cores", 3, 2, cores));
+    auto server_cores = py::cast<std::vector<std::vector<int>>>(parts[0]);
+    auto builder_cores = py::cast<std::vector<int>>(parts[1]);
+    EXPECT_EQ(server_cores, (std::vector<std::vector<int>>{{0, 1}, {2, 3}, {4, 5}}));
+    EXPECT_EQ(builder_cores, std::vector<int>{6});
+
+    parts = py::cast<py::tuple>(PythonHook::call_function("tvm_ext", "partition_cores", 1, 1, cores));
+    EXPECT_EQ(py::cast<std::vector<std::vector<int>>>(parts[0]), (std::vector<std::vector<int>>{{0}}));
+    EXPECT_EQ(py::cast<std::vector<int>>(parts[1]).size(), 6u);
+
+    // Servers must leave at least one core for builders
+    const std::vector<int> six = {0, 1, 2, 3, 4, 5};
+    EXPECT_THROW(PythonHook::call_function("tvm_ext", "partition_cores", 3, 2, six), std::runtime_error);
+}
@@ -1,10 +1,13 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include "python_hook.h"
+#include "ffi/tvm_ffi.h"
+#include <filesystem>
 #include <string>
 #include <map>
 #include <iostream>
 #include <iomanip>
+#include <vector>
 
 using namespace tvm_sdk;
 using ::testing::Not;
@@ -167,6 +170,299 @@ TEST_F(TVMScheduleTest, TuneResNet18WithMetaSchedule) {
     }
 }
 
+// Test: INT8 post-training quantization of ResNet18 (untuned, calibrated on one image)
+TEST_F(TVMScheduleTest, QuantizeResNet18Int8) {
+    print_separator("Test: INT8 Quantization of ResNet18");
+
+    std::string project_root = PROJECT_SOURCE_DIR;
+    std::string image_path = project_root + "/test/dog.jpeg";
+
+    ffi::PipelineTimings timings;
+    auto result = ffi::TVMFFI::quantize_with_metaschedule(
+        "",                         // pretrained ResNet18
+        image_path,                 // calibration images
+        "llvm",
+        false,                      // use_auto_tuning
+        0,                          // num_trials
+        0,                          // max_workers
+        "quantize_int8_test",
+        1,                          // num_calibration
+        "minmax",
+        "",                         // evaluate on the calibration image
+        &timings
+    );
+    ASSERT_EQ(result["status"], "success") << result["error"];
+    print_map(result);
+
+    // 20 conv2d layers and the final dense layer
+    EXPECT_EQ(result["num_quantized_layers"], "21");
+    EXPECT_EQ(result["num_eval_images"], "1");
+    EXPECT_GT(std::stod(result["int8_latency_ms"]), 0.0);
+    EXPECT_GT(std::stod(result["float_latency_ms"]), 0.0);
+    EXPECT_DOUBLE_EQ(std::stod(result["top5_agreement"]), 1.0);
+    EXPECT_THAT(result["lib_path"], HasSubstr("int8"));
+
+    std::vector<std::string> names;
+    for (const auto& phase : timings.phases) {
+        names.push_back(phase.name);
+    }
+    EXPECT_THAT(names, ::testing::Contains("calibrate"));
+    EXPECT_THAT(names, ::testing::Contains("relax_build_int8"));
+}
+
+// Test: bf16 mixed precision halves conv weight bytes and stays close to float32
+TEST_F(TVMScheduleTest, CompareMixedPrecisionResNet18) {
+    print_separator("Test: BF16 Mixed Precision of ResNet18");
+
+    ffi::MixedPrecisionConfig config;
+    config.precision = ffi::Precision::BFloat16;
+    config.deny_ops = {"matmul"};   // keep the classifier in float32
+
+    auto comparison = ffi::TVMFFI::compare_mixed_precision("", "llvm", config, 5);
+    ASSERT_EQ(comparison.status, "success") << comparison.error;
+
+    std::cout << "  precision: " << comparison.precision << "\n"
+              << "  converted layers: " << comparison.num_converted_layers << "\n"
+              << "  latency: " << comparison.float_latency_ms << " ms -> "
+              << comparison.mixed_latency_ms << " ms\n"
+              << "  weights: " << comparison.float_weight_bytes << " -> "
+              << comparison.mixed_weight_bytes << " bytes\n"
+              << "  max rel error: " << comparison.max_rel_error << "\n";
+
+    EXPECT_EQ(comparison.precision, "bfloat16");
+    EXPECT_EQ(comparison.num_converted_layers, 20);
+    EXPECT_LT(comparison.mixed_weight_bytes, comparison.float_weight_bytes * 6 / 10);
+    EXPECT_LT(comparison.max_rel_error, 0.1);
+    EXPECT_GT(comparison.mixed_latency_ms, 0.0);
+}
+
+// Test: NCHW[x]c packing of ResNet18 keeps results and packs the conv layers
+TEST_F(TVMScheduleTest, CompareLayoutPackingResNet18) {
+    print_separator("Test: NCHW[x]c Layout Packing of ResNet18");
+
+    auto comparison = ffi::TVMFFI::compare_layout_packing("", "llvm", 0, 5);
+    ASSERT_EQ(comparison["status"], "success") << comparison["error"];
+    print_map(comparison);
+
+    int block_size = std::stoi(comparison["block_size"]);
+    EXPECT_TRUE(block_size == 4 || block_size == 8 || block_size == 16);
+    EXPECT_EQ(comparison["data_layout"], "NCHW" + comparison["block_size"] + "c");
+    // All convolutions except the 3-channel stem
+    EXPECT_GE(std::stoi(comparison["num_packed_conv2d"]), 19);
+    EXPECT_LT(std::stod(comparison["max_rel_error"]), 1e-3);
+    EXPECT_GT(std::stod(comparison["packed_mean_ms"]), 0.0);
+}
+
+// Test: untuned vs. tuned vs. DNNL offload of ResNet18 (DNNL skipped without USE_DNNL)
+TEST_F(TVMScheduleTest, BenchmarkBackendsResNet18) {
+    print_separator("Test: Backend Benchmark of ResNet18");
+
+    auto benchmark = ffi::TVMFFI::benchmark_backends("", "llvm", 16, 0, "backend_benchmark_test", 5);
+    ASSERT_EQ(benchmark.status, "success") << benchmark.error;
+    ASSERT_EQ(benchmark.results.size(), 3u);
+
+    for (const auto& variant : benchmark.results) {
+        std::cout << "  " << variant.name << ": " << variant.status;
+        if (variant.status == "success") {
+            std::cout << ", compile " << variant.compile_ms << " ms"
+                      << ", latency " << variant.mean_ms << " ms"
+                      << ", library " << variant.library_bytes << " bytes"
+                      << ", runtime RSS " << variant.runtime_rss_kb << " KB"
+                      << ", offloaded " << variant.num_offloaded;
+        } else {
+            std::cout << " (" << variant.error << ")";
+        }
+        std::cout << "\n";
+    }
+
+    EXPECT_EQ(benchmark.results[0].name, "untuned");
+    EXPECT_EQ(benchmark.results[1].name, "tuned");
+    EXPECT_EQ(benchmark.results[2].name, "dnnl");
+    for (const auto& variant : benchmark.results) {
+        if (variant.name != "dnnl") {
+            ASSERT_EQ(variant.status, "success") << variant.name << ": " << variant.error;
+        }
+        if (variant.status == "success") {
+            EXPECT_GT(variant.mean_ms, 0.0);
+            EXPECT_GT(variant.compile_ms, 0.0);
+            EXPECT_GT(variant.library_bytes, 0);
+            EXPECT_LT(variant.max_rel_error, 1e-3) << variant.name;
+        }
+    }
+    const auto& dnnl = benchmark.results[2];
+    if (dnnl.status == "success") {
+        EXPECT_GT(dnnl.num_offloaded, 0);
+    } else {
+        EXPECT_EQ(dnnl.status, "skipped") << dnnl.error;
+    }
+}
+
+// Test: ResNet18 activations share planned storage and the VM stays within the plan
+TEST_F(TVMScheduleTest, MemoryPlanReportResNet18) {
+    print_separator("Test: Memory Plan of ResNet18");
+
+    auto report = ffi::TVMFFI::memory_plan_report("", "llvm", {}, true, 3);
+    ASSERT_EQ(report.status, "success") << report.error;
+
+    std::cout << "  planned: " << report.planned_bytes << " bytes in " << report.num_storage_tokens
+              << " tokens for " << report.num_planned_tensors << " tensors (reuse "
+              << report.reuse_ratio << "x)\n"
+              << "  peak live: " << report.peak_live_bytes << " bytes, unplanned: "
+              << report.unplanned_bytes << " bytes\n"
+              << "  runtime: " << report.runtime_storage_bytes << " bytes in "
+              << report.runtime_num_allocations << " allocations, RSS +"
+              << report.runtime_rss_delta_kb << " KB\n";
+    for (const auto& allocation : report.largest_allocations) {
+        std::cout << "    " << allocation.storage << ": " << allocation.bytes << " bytes, "
+                  << allocation.tensors.size() << " tensors\n";
+    }
+
+    EXPECT_GT(report.num_storage_tokens, 0);
+    EXPECT_GT(report.num_planned_tensors, report.num_storage_tokens);
+    EXPECT_GT(report.reuse_ratio, 1.0);
+    EXPECT_LE(report.peak_live_bytes, report.planned_bytes + report.unplanned_bytes);
+    ASSERT_EQ(report.largest_allocations.size(), 3u);
+    EXPECT_GE(report.largest_allocations[0].bytes, report.largest_allocations[1].bytes);
+    EXPECT_TRUE(report.within_plan) << report.runtime_storage_bytes << " bytes allocated";
+}
+
+// Test: ResNet34 reuses the conv workloads ResNet18 tuned in a shared database
+TEST_F(TVMScheduleTest, TuneModelsSharedDatabase) {
+    print_separator("Test: Shared Tuning Database for ResNet18 and ResNet34");
+
+    std::filesystem::remove_all("tuning_database_shared_test");
+
+    ffi::ModelSpec resnet18;
+    resnet18.name = "resnet18";
+    resnet18.pretrained = false;
+    resnet18.inputs = {{{1, 3, 224, 224}, "float32"}};
+    ffi::ModelSpec resnet34 = resnet18;
+    resnet34.name = "resnet34";
+
+    // One trial per workload is enough to mark it tuned
+    auto report = ffi::TVMFFI::tune_models(
+        {resnet18, resnet34}, "llvm", 64, 1, 0, "tuning_database_shared_test", {}, false);
+    ASSERT_EQ(report.status, "success") << report.error;
+    ASSERT_EQ(report.models.size(), 2u);
+
+    std::cout << "  tasks: " << report.total_tasks << ", unique workloads: " << report.unique_workloads
+              << ", shared: " << report.shared_workloads << "\n";
+    for (const auto& model : report.models) {
+        ASSERT_EQ(model.status, "success") << model.name << ": " << model.error;
+        std::cout << "  " << model.name << ": " << model.num_tasks << " tasks, "
+                  << model.tuned_tasks << " tuned, " << model.reused_tasks << " reused ("
+                  << model.reused_from_models << " from other models)\n";
+    }
+
+    EXPECT_GT(report.shared_workloads, 0);
+    EXPECT_LT(report.unique_workloads, report.total_tasks);
+    EXPECT_EQ(report.models[0].reused_from_models, 0);
+    EXPECT_GT(report.models[1].reused_from_models, 0);
+    EXPECT_THAT(report.models[1].reused_from, ::testing::ElementsAre("resnet18"));
+    EXPECT_TRUE(std::filesystem::exists("tuning_database_shared_test/workload_models.json"));
+}
+
+// Test: One dynamic-shape ResNet18 library serves tuned and untuned resolutions
+TEST_F(TVMScheduleTest, CompileDynamicResNet18) {
+    print_separator("Test: Dynamic-Shape ResNet18 (symbolic batch, height, width)");
+
+    ffi::ModelSpec model;
+    model.name = "resnet18";
+    model.pretrained = false;
+    model.inputs = {{{-1, 3, -1, -1}, "float32", {"batch", "", "height", "width"}}};
+    auto imported = ffi::TVMFFI::create_model_relax_ir(model);
+    ASSERT_EQ(imported["status"], "success") << imported["error"];
+
+    ffi::DynamicShapeConfig shapes;
+    shapes.representative_shapes = {{{"batch", 1}, {"height", 224}, {"width", 224}}};
+    shapes.check_shapes = {
+        {{"batch", 1}, {"height", 224}, {"width", 224}},
+        {{"batch", 2}, {"height", 160}, {"width", 160}},
+    };
+
+    auto result = ffi::TVMFFI::compile_dynamic(
+        imported["relax_mod_json"], "llvm", shapes, true, 16, 16, 0, "tuning_database_dynamic_test");
+    ASSERT_EQ(result.status, "success") << result.error;
+
+    std::cout << "  kernels: " << result.num_kernels << " (" << result.num_dynamic_kernels
+              << " dynamic, " << result.num_tuned_kernels << " tuned)\n";
+    for (const auto& check : result.checks) {
+        std::cout << "  " << check.function << ": " << check.mean_ms << " ms (symbolic "
+                  << check.dynamic_mean_ms << " ms, rel error " << check.max_rel_error << ")\n";
+    }
+
+    EXPECT_THAT(result.symbolic_vars, ::testing::UnorderedElementsAre("batch", "height", "width"));
+    ASSERT_EQ(result.specialized.size(), 1u);
+    EXPECT_EQ(result.specialized[0].function, "main_batch1_height224_width224");
+    EXPECT_GT(result.num_dynamic_kernels, 0);
+    EXPECT_GT(result.num_tuned_kernels, 0);
+
+    ASSERT_EQ(result.checks.size(), 2u);
+    EXPECT_EQ(result.checks[0].function, "main_batch1_height224_width224");
+    EXPECT_LT(result.checks[0].max_rel_error, 1e-3);
+    EXPECT_EQ(result.checks[1].function, "main");
+
+    EXPECT_EQ(ffi::TVMFFI::select_shape_function(result.manifest_path, {{1, 3, 224, 224}}),
+              "main_batch1_height224_width224");
+    EXPECT_EQ(ffi::TVMFFI::select_shape_function(result.manifest_path, {{4, 3, 224, 224}}), "main");
+}
+
+// Test: Records tuned at 224x224 seed tuning at a new resolution
+TEST_F(TVMScheduleTest, TuneWithWarmStartNewResolution) {
+    print_separator("Test: Warm-Start Tuning Transfer (224x224 -> 160x160)");
+
+    std::filesystem::remove_all("tuning_database_warm_source");
+    std::filesystem::remove_all("tuning_database_warm_test");
+    std::filesystem::remove_all("tuning_database_warm_test_cold");
+
+    ffi::ModelSpec model;
+    model.name = "resnet18";
+    model.pretrained = false;
+    model.inputs = {{{1, 3, 224, 224}, "float32", {}}};
+    auto source_ir = ffi::TVMFFI::create_model_relax_ir(model);
+    ASSERT_EQ(source_ir["status"], "success") << source_ir["error"];
+    model.inputs = {{{1, 3, 160, 160}, "float32", {}}};
+    auto new_ir = ffi::TVMFFI::create_model_relax_ir(model);
+    ASSERT_EQ(new_ir["status"], "success") << new_ir["error"];
+
+    auto source = ffi::TVMFFI::tune_incremental(
+        source_ir["relax_mod_json"], "llvm", 64, 4, 0, "tuning_database_warm_source");
+    ASSERT_EQ(source["status"], "success") << source["error"];
+
+    ffi::WarmStartConfig config;
+    config.source_work_dirs = {"tuning_database_warm_source"};
+    config.seeds_per_task = 2;
+    config.compare = true;
+
+    auto report = ffi::TVMFFI::tune_with_warm_start(
+        new_ir["relax_mod_json"], "llvm", config, 96, 0, "tuning_database_warm_test");
+    ASSERT_EQ(report.status, "success") << report.error;
+
+    int transferred = 0;
+    for (const auto& task : report.tasks) {
+        if (task.match != "none") {
+            ++transferred;
+        }
+    }
+    std::cout << "  " << transferred << "/" << report.num_tasks << " tasks seeded, "
+              << report.num_valid_seeds << " valid seeds, " << report.pretrain_samples << " pre-training samples\n";
+    std::cout << "  warm: " << report.warm.final_ms << " ms, " << report.warm.trials_to_target
+              << " trials to target, " << report.warm.seed_secs << " s seeding + " << report.warm.tune_secs << " s search\n";
+    std::cout << "  cold: " << report.cold.final_ms << " ms, " << report.cold.trials_to_target
+              << " trials to target, " << report.cold.tune_secs << " s\n";
+
+    EXPECT_GT(report.num_source_records, 0);
+    EXPECT_GT(transferred, 0);
+    EXPECT_GT(report.num_valid_seeds, 0);
+    EXPECT_LE(report.num_seed_trials, report.num_tasks * config.seeds_per_task);
+    EXPECT_GT(report.pretrain_samples, 0);
+    ASSERT_TRUE(report.compared);
+    EXPECT_FALSE(report.warm.trials.empty());
+    EXPECT_FALSE(report.cold.trials.empty());
+    EXPECT_EQ(report.warm.trials.size(), report.warm.total_ms.size());
+    EXPECT_GT(report.cold.trials_to_target, 0);
+}
+
 // Test: Tune ResNet18 without MetaSchedule (baseline)
 // TEST_F(TVMScheduleTest, TuneResNet18WithoutMetaSchedule) {
 //     print_separator("Test: Tune ResNet18 WITHOUT MetaSchedule (Baseline)");